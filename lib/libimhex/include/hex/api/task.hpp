@@ -24,8 +24,14 @@ namespace hex {
         [[nodiscard]]
         bool isPending() const;
 
+        // Additional progress information shown next to the name. Only read it while holding SharedData::tasksMutex
+        void setStatus(const std::string &status);
+
+        [[nodiscard]]
+        const std::string& getStatus() const;
+
     private:
-        std::string m_name;
+        std::string m_name, m_status;
         u64 m_maxValue, m_currValue;
     };
 
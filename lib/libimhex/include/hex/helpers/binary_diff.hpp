@@ -0,0 +1,79 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <functional>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <vector>
+
+namespace hex::prv { class Provider; }
+
+namespace hex {
+
+    /*
+     * Aligns two binaries with each other and describes their differences as an edit script. Both inputs are
+     * split into content defined chunks first, so an insertion only changes the chunks around it instead of
+     * shifting all following ones, and the two chunk sequences get aligned. Only the regions between matching
+     * chunks are read a second time and aligned byte by byte. Alignments are bounded in cost, regions that are
+     * too large or too different to align get reported as replaced as a whole.
+     *
+     * compare() is a much cheaper alternative that only compares bytes at the same offsets, reading both
+     * inputs once with constant memory.
+     */
+    class BinaryDiff {
+    public:
+        enum class EditType : u8 {
+            Equal,
+            Insert,
+            Delete,
+            Replace
+        };
+
+        // Insertions only cover bytes of B, deletions only bytes of A
+        struct Edit {
+            EditType type;
+            u64 offsetA;
+            u64 sizeA;
+            u64 offsetB;
+            u64 sizeB;
+
+            auto operator<=>(const Edit&) const = default;
+        };
+
+        using ProgressCallback = std::function<void(u64 processedSize)>;
+
+        constexpr static size_t ReadBlockSize = 0x10'0000;
+
+        // Chunks get larger for large inputs so there are never many more than MaxChunkCount of them
+        constexpr static size_t MinAverageChunkSizeBits = 12;
+        constexpr static size_t MaxAverageChunkSizeBits = 24;
+        constexpr static size_t MaxChunkCount = 0x10'0000;
+
+        constexpr static size_t MaxByteAlignmentSize = 0x10'0000;
+        constexpr static size_t MaxEditDistance = 0x400;
+        constexpr static size_t AlignmentBudget = 0x400'0000;
+        constexpr static u32 MaxAnchorDepth = 0x10;
+
+        // Differences closer together than the merge distance are reported as one replacement. The distance
+        // grows with the input so there are never many more than MaxDifferenceCount replacements
+        constexpr static size_t MinMergeDistance = 0x10;
+        constexpr static size_t MaxDifferenceCount = 0x10'0000;
+
+        // Edits cover both inputs from start to end. Progress counts the bytes read of both providers. Returns nullopt if it got stopped
+        [[nodiscard]] static std::optional<std::vector<Edit>> diff(prv::Provider *providerA, prv::Provider *providerB, const ProgressCallback &progress = { }, const std::stop_token &stopToken = { });
+        [[nodiscard]] static std::vector<Edit> diff(std::span<const u8> a, std::span<const u8> b);
+
+        // Only produces equal and replaced ranges, followed by an insertion or deletion if the sizes differ
+        [[nodiscard]] static std::optional<std::vector<Edit>> compare(prv::Provider *providerA, prv::Provider *providerB, const ProgressCallback &progress = { }, const std::stop_token &stopToken = { });
+        [[nodiscard]] static std::vector<Edit> compare(std::span<const u8> a, std::span<const u8> b);
+
+    private:
+        using ReadFunction = std::function<void(u64 offset, u8 *buffer, size_t size)>;
+
+        [[nodiscard]] static std::optional<std::vector<Edit>> diff(const ReadFunction &readA, u64 sizeA, const ReadFunction &readB, u64 sizeB, bool parallel, const ProgressCallback &progress, const std::stop_token &stopToken);
+        [[nodiscard]] static std::optional<std::vector<Edit>> compare(const ReadFunction &readA, u64 sizeA, const ReadFunction &readB, u64 sizeB, const ProgressCallback &progress, const std::stop_token &stopToken);
+    };
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace hex::prv { class Provider; }
+
+namespace hex {
+
+    using ByteHistogram = std::array<u64, 256>;
+
+    struct ByteStatistics {
+        u64 size = 0;
+        double entropy = 0;
+        double chiSquare = 0;
+        double mean = 0;
+        double printableRatio = 0;
+        double zeroRatio = 0;
+        double highBitRatio = 0;
+
+        [[nodiscard]] static ByteStatistics fromHistogram(const ByteHistogram &histogram);
+    };
+
+    /*
+     * Computes byte histograms and statistics of a region, split up into blocks. Batches of blocks are
+     * processed in parallel if the provider can hand out its data directly. The last result per provider is
+     * cached and reused as long as the provider's revision doesn't change. After patches or overlays changed,
+     * update() only recalculates the blocks containing patches and overlays that were added, removed or changed.
+     */
+    class ByteAnalyzer {
+    public:
+        constexpr static size_t BatchSize = 0x40'0000;
+
+        using ProgressCallback = std::function<void(u64 processedSize)>;
+
+        struct ModifiedRegion {
+            u64 address;
+            size_t size;
+            u64 hash;
+
+            auto operator<=>(const ModifiedRegion&) const = default;
+        };
+
+        struct Result {
+            u64 address = 0;
+            size_t size = 0;
+            size_t blockSize = 0;
+            u64 revision = 0;
+            u64 dataRevision = 0;
+
+            // Patches and overlays at the time of the analysis
+            std::vector<ModifiedRegion> modifiedRegions;
+
+            ByteHistogram histogram = { 0 };
+            ByteStatistics statistics;
+
+            std::vector<ByteHistogram> blockHistograms;
+            std::vector<ByteStatistics> blockStatistics;
+        };
+
+        [[nodiscard]] static std::shared_ptr<const Result> analyze(prv::Provider *provider, u64 address, size_t size, size_t blockSize, const ProgressCallback &progress = { }, u32 threadCount = 0);
+        [[nodiscard]] static std::shared_ptr<const Result> update(prv::Provider *provider, const std::shared_ptr<const Result> &previous);
+        [[nodiscard]] static std::shared_ptr<const Result> getCachedResult(prv::Provider *provider, u64 address, size_t size, size_t blockSize);
+
+        static void countBytes(std::span<const u8> data, ByteHistogram &histogram);
+    };
+
+}
@@ -3,7 +3,9 @@
 #include <hex.hpp>
 
 #include <array>
+#include <functional>
 #include <optional>
+#include <stop_token>
 #include <string>
 #include <vector>
 
@@ -25,6 +27,42 @@ namespace hex::crypt {
     std::array<u8, 48> sha384(prv::Provider* &data, u64 offset, size_t size);
     std::array<u8, 64> sha512(prv::Provider* &data, u64 offset, size_t size);
 
+    enum class HashFunction : u8 {
+        CRC8,
+        CRC16,
+        CRC32,
+        MD5,
+        SHA1,
+        SHA224,
+        SHA256,
+        SHA384,
+        SHA512
+    };
+
+    struct CrcParameters {
+        u32 polynomial = 0;
+        u32 init = 0;
+        u32 xorout = 0;
+        bool reflectIn = false;
+        bool reflectOut = false;
+    };
+
+    struct HashRequest {
+        HashFunction function;
+        CrcParameters crc = { };
+    };
+
+    constexpr static size_t HashBlockSize = 0x40'0000;
+
+    using HashProgressCallback = std::function<void(u64 processedSize)>;
+
+    /*
+     * Reads the region only once and hands every block to all requested hash functions. Each hash function
+     * runs on its own thread while the next blocks are being read. Digests are returned in the order of the
+     * requests, CRCs as big endian bytes. Returns nullopt if it got stopped.
+     */
+    std::optional<std::vector<std::vector<u8>>> hash(prv::Provider *provider, u64 offset, size_t size, const std::vector<HashRequest> &requests, const HashProgressCallback &progress = { }, const std::stop_token &stopToken = { });
+
     std::array<u8, 16> md5(const std::vector<u8> &data);
     std::array<u8, 20> sha1(const std::vector<u8> &data);
     std::array<u8, 28> sha224(const std::vector<u8> &data);
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <functional>
+#include <span>
+#include <stop_token>
+#include <vector>
+
+namespace hex::prv { class Provider; }
+
+namespace hex {
+
+    /*
+     * Instruction boundaries of a region of code. Only the size of every instruction is stored, together with
+     * the offset of every CheckpointInterval'th instruction, so the index costs a little more than a byte per
+     * instruction. Building it decodes chunks in parallel, each one starting at its chunk border, and afterwards
+     * resynchronises every chunk with the instruction stream running into it from the previous chunk.
+     */
+    class DisassemblyIndex {
+    public:
+        struct Instruction {
+            u64 offset;
+            size_t size;
+        };
+
+        // Returns the size of the instruction at the start of the code or 0 if there's no valid instruction
+        using DecodeFunction = std::function<size_t(u64 address, std::span<const u8> code)>;
+
+        // Creates a decoder for a single worker thread, so decoders don't need to be thread safe
+        using DecoderFactory = std::function<DecodeFunction()>;
+        using ProgressCallback = std::function<void(u64 processedSize)>;
+
+        constexpr static size_t ChunkSize = 0x10'0000;
+        constexpr static size_t MaxInstructionSize = 0x20;
+        constexpr static size_t CheckpointInterval = 0x40;
+
+        DisassemblyIndex() = default;
+
+        // Instruction addresses passed to the decoders start at baseAddress for the first byte of the region. The index is incomplete if a stop was requested
+        [[nodiscard]] static DisassemblyIndex build(prv::Provider *provider, u64 address, size_t size, u64 baseAddress, const DecoderFactory &decoderFactory, const ProgressCallback &progress = { }, u32 threadCount = 0, const std::stop_token &stopToken = { });
+        [[nodiscard]] static DisassemblyIndex build(std::span<const u8> code, u64 baseAddress, const DecoderFactory &decoderFactory, u32 threadCount = 1);
+
+        [[nodiscard]] size_t size() const { return this->m_sizes.size(); }
+        [[nodiscard]] bool empty() const { return this->m_sizes.empty(); }
+
+        // Offsets are relative to the start of the indexed region
+        [[nodiscard]] Instruction getInstruction(size_t index) const;
+
+    private:
+        using ReadFunction = std::function<void(u64 offset, u8 *buffer, size_t size)>;
+
+        struct ChunkResult {
+            std::vector<u8> sizes;
+        };
+
+        [[nodiscard]] static DisassemblyIndex build(const ReadFunction &read, size_t size, u64 baseAddress, const DecoderFactory &decoderFactory, const ProgressCallback &progress, u32 threadCount, const std::stop_token &stopToken);
+        [[nodiscard]] static ChunkResult decodeChunk(const ReadFunction &read, size_t size, u64 baseAddress, u64 chunkOffset, const DecodeFunction &decode);
+
+        void append(u8 instructionSize);
+
+        std::vector<u8> m_sizes;
+        std::vector<u64> m_checkpoints;
+        u64 m_endOffset = 0;
+    };
+
+}
@@ -2,7 +2,12 @@
 
 #include <hex.hpp>
 
+#include <array>
+#include <limits>
 #include <map>
+#include <optional>
+#include <span>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -10,27 +15,57 @@
 
 namespace hex {
 
+    /*
+     * Custom character table. The byte sequences are compiled into a trie, so finding the longest sequence
+     * matching some data walks the data only once and never allocates. Decoded text points into the table.
+     */
     class EncodingFile {
     public:
         enum class Type {
             Thingy
         };
 
+        // Entries with longer byte sequences are ignored so callers can decode from fixed size buffers
+        constexpr static size_t MaxSequenceLength = 0x100;
+
         EncodingFile() = default;
         EncodingFile(Type type, const fs::path &path);
 
-        [[nodiscard]] std::pair<std::string_view, size_t> getEncodingFor(const std::vector<u8> &buffer) const;
+        [[nodiscard]] std::pair<std::string_view, size_t> getEncodingFor(std::span<const u8> buffer) const;
+        [[nodiscard]] std::optional<std::pair<std::string_view, size_t>> findEncodingFor(std::span<const u8> buffer) const;
         [[nodiscard]] size_t getLongestSequence() const { return this->m_longestSequence; }
 
+        // Appends the text of all of the data, bytes without a mapping decode to a '.'
+        void decode(std::span<const u8> data, std::string &result) const;
+        [[nodiscard]] std::string decode(std::span<const u8> data) const;
+
+        // Always uses the longest text that has a mapping. Returns nullopt if some part of the text has none
+        [[nodiscard]] std::optional<std::vector<u8>> encode(std::string_view text) const;
+
         [[nodiscard]] bool valid() const { return this->m_valid; }
 
     private:
         void parseThingyFile(std::ifstream &content);
+        void addMapping(std::span<const u8> bytes, std::string_view text);
+
+        constexpr static u32 None = std::numeric_limits<u32>::max();
+
+        struct Node {
+            u32 children = None;
+            u32 textOffset = None;
+            u32 textSize = 0;
+        };
 
         bool m_valid = false;
 
-        std::map<u32, std::map<std::vector<u8>, std::string>> m_mapping;
+        // The first node is the root, child tables map every byte to the index of the following node or 0 if there's none
+        std::vector<Node> m_nodes;
+        std::vector<std::array<u32, 256>> m_children;
+        std::string m_texts;
+
+        std::map<std::string, std::vector<u8>, std::less<>> m_reverseMapping;
         size_t m_longestSequence = 0;
+        size_t m_longestText = 0;
     };
 
-}
\ No newline at end of file
+}
@@ -3,15 +3,57 @@
 #include <hex.hpp>
 
 #include <map>
+#include <optional>
 #include <vector>
 
+#include <nlohmann/json_fwd.hpp>
+
 namespace hex {
 
-    using Patches = std::map<u64, u8>;
+    /*
+     * Stores patched bytes as sorted, non-overlapping extents of contiguous data.
+     * Neighbouring or overlapping writes get merged into a single extent so large pastes or
+     * patch imports only take up a handful of nodes and can be applied onto a buffer using memcpy.
+     */
+    class Patches {
+    public:
+        using Extents = std::map<u64, std::vector<u8>>;
+
+        Patches() = default;
+
+        void add(u64 address, const void *buffer, size_t size);
+        void add(u64 address, u8 value) { this->add(address, &value, sizeof(u8)); }
+        void remove(u64 address, size_t size = 1);
+        void shift(u64 address, size_t offset);
+        void clear();
+
+        void apply(u64 address, void *buffer, size_t size) const;
+
+        [[nodiscard]] bool contains(u64 address) const;
+        [[nodiscard]] bool overlaps(u64 address, size_t size) const;
+        [[nodiscard]] std::optional<u8> get(u64 address) const;
+        [[nodiscard]] Patches getRange(u64 address, size_t size) const;
+
+        [[nodiscard]] size_t size() const { return this->m_size; }
+        [[nodiscard]] bool empty() const { return this->m_size == 0; }
+        [[nodiscard]] size_t getExtentCount() const { return this->m_extents.size(); }
+
+        [[nodiscard]] Extents::const_iterator begin() const { return this->m_extents.begin(); }
+        [[nodiscard]] Extents::const_iterator end() const { return this->m_extents.end(); }
+
+    private:
+        [[nodiscard]] Extents::const_iterator findFirstOverlapping(u64 address) const;
+
+        Extents m_extents;
+        size_t m_size = 0;
+    };
+
+    void to_json(nlohmann::json &j, const Patches &patches);
+    void from_json(const nlohmann::json &j, Patches &patches);
 
     std::vector<u8> generateIPSPatch(const Patches &patches);
     std::vector<u8> generateIPS32Patch(const Patches &patches);
 
     Patches loadIPSPatch(const std::vector<u8> &ipsPatch);
     Patches loadIPS32Patch(const std::vector<u8> &ipsPatch);
-}
\ No newline at end of file
+}
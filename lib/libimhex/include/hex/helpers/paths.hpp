@@ -18,7 +18,8 @@ namespace hex {
         Config,
         Resources,
         Constants,
-        Logs
+        Logs,
+        Cache
     };
 
     std::string getExecutablePath();
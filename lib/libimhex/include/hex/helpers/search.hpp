@@ -0,0 +1,61 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <array>
+#include <bitset>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace hex::prv { class Provider; }
+
+namespace hex {
+
+    class EncodingFile;
+
+    /*
+     * Byte pattern where every position matches a set of byte values. This covers exact bytes,
+     * wildcards and case-insensitive characters with the same matcher. Searching uses memchr on a
+     * position that only matches a single value and falls back to Boyer-Moore-Horspool otherwise.
+     * All matches are reported, including overlapping ones.
+     */
+    class SearchPattern {
+    public:
+        enum class Encoding : u8 {
+            ASCII,
+            UTF16LE,
+            UTF16BE,
+            Custom
+        };
+
+        constexpr static size_t SearchBlockSize = 0x100'0000;
+
+        using MatchCallback     = std::function<void(u64 address)>;
+        using ProgressCallback  = std::function<bool(u64 searchedSize)>;
+
+        SearchPattern() = default;
+
+        [[nodiscard]] static std::optional<SearchPattern> fromHexString(std::string_view string);
+        [[nodiscard]] static std::optional<SearchPattern> fromString(std::string_view string, bool caseSensitive = true, Encoding encoding = Encoding::ASCII);
+        [[nodiscard]] static std::optional<SearchPattern> fromString(std::string_view string, const EncodingFile &encodingFile);
+
+        void search(std::span<const u8> data, const MatchCallback &callback) const;
+        void search(prv::Provider *provider, u64 address, size_t size, const MatchCallback &callback, const ProgressCallback &progress = { }) const;
+
+        [[nodiscard]] bool matches(const u8 *data) const;
+
+        [[nodiscard]] size_t size() const { return this->m_bytes.size(); }
+        [[nodiscard]] bool empty() const { return this->m_bytes.empty(); }
+
+    private:
+        explicit SearchPattern(std::vector<std::bitset<256>> bytes);
+
+        std::vector<std::bitset<256>> m_bytes;
+        std::array<size_t, 256> m_shifts = { 0 };
+        std::optional<std::pair<size_t, u8>> m_anchor;
+    };
+
+}
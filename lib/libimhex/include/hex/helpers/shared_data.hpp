@@ -69,6 +69,7 @@ namespace hex {
         static u32 patternPaletteOffset;
         static std::string popupMessage;
         static std::list<ImHexApi::Bookmarks::Entry> bookmarkEntries;
+        static std::mutex patternDataMutex;
         static std::vector<pl::PatternData*> patternData;
 
         static std::map<std::string, std::string> languageNames;
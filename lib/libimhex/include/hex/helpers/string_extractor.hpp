@@ -0,0 +1,75 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <functional>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+#include <hex/helpers/encoding_file.hpp>
+
+namespace hex::prv { class Provider; }
+
+namespace hex {
+
+    /*
+     * Finds runs of printable characters in a given encoding. The data is split into chunks that get
+     * scanned in parallel, strings crossing chunk borders are stitched back together afterwards.
+     */
+    class StringExtractor {
+    public:
+        enum class Encoding : u8 {
+            ASCII,
+            UTF8,
+            UTF16LE,
+            UTF16BE,
+            Custom
+        };
+
+        struct Result {
+            u64 address;
+            size_t size;
+        };
+
+        constexpr static size_t ChunkSize = 0x40'0000;
+
+        using ProgressCallback = std::function<void(u64 processedSize)>;
+
+        StringExtractor(Encoding encoding, size_t minimumLength, EncodingFile encodingFile = { });
+
+        // Stops scanning once a stop is requested, whatever has been found up to then is returned
+        [[nodiscard]] std::vector<Result> extract(prv::Provider *provider, u64 address, size_t size, const ProgressCallback &progress = { }, u32 threadCount = 0, const std::stop_token &stopToken = { }) const;
+        [[nodiscard]] std::vector<Result> extract(std::span<const u8> data) const;
+
+        [[nodiscard]] std::string decode(std::span<const u8> data) const;
+
+        [[nodiscard]] Encoding getEncoding() const { return this->m_encoding; }
+
+    private:
+        struct Run {
+            u64 address;
+            size_t size;
+            size_t length;
+        };
+
+        struct ChunkResult {
+            std::optional<Run> head;
+            bool headClosed = false;
+            std::vector<Result> strings;
+            std::optional<Run> tail;
+        };
+
+        [[nodiscard]] size_t getMaxCharacterSize() const;
+
+        [[nodiscard]] ChunkResult scanChunk(u64 address, std::span<const u8> data, size_t chunkSize) const;
+        [[nodiscard]] std::vector<Result> stitch(const std::vector<ChunkResult> &chunks) const;
+
+        Encoding m_encoding;
+        size_t m_minimumLength;
+        EncodingFile m_encodingFile;
+    };
+
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <optional>
+#include <regex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hex {
+
+    /*
+     * Decoded strings stored back to back in a single buffer. Every string is followed by a null byte
+     * so the buffer can be searched as a whole without matches spanning two strings.
+     */
+    class StringTable {
+    public:
+        void add(std::string_view string);
+        void reserve(size_t count, size_t size);
+        void clear();
+
+        [[nodiscard]] std::string_view get(size_t index) const;
+        [[nodiscard]] size_t size() const { return this->m_offsets.size() - 1; }
+        [[nodiscard]] bool empty() const { return this->size() == 0; }
+
+        [[nodiscard]] const std::string &getData() const { return this->m_data; }
+        [[nodiscard]] size_t getOffset(size_t index) const { return this->m_offsets[index]; }
+
+    private:
+        std::string m_data;
+        std::vector<size_t> m_offsets = { 0 };
+    };
+
+    /*
+     * Compiled filter for a StringTable. Plain filters and regular expressions with a literal every
+     * match has to contain are searched for over the whole table buffer at once, the regex only runs on
+     * the strings that contain that literal.
+     */
+    class StringFilter {
+    public:
+        constexpr static size_t BlockSize = 0x10'0000;
+
+        StringFilter() = default;
+
+        [[nodiscard]] static std::optional<StringFilter> create(std::string_view filter, bool regex);
+
+        [[nodiscard]] bool matches(std::string_view string) const;
+
+        // Returns true if every string matched by this filter is also matched by the other one
+        [[nodiscard]] bool narrows(const StringFilter &other) const;
+
+        // Returns the indices of all matching strings, or only of the matching candidates if given. Returns nullopt when stopped
+        [[nodiscard]] std::optional<std::vector<size_t>> apply(const StringTable &table, const std::optional<std::vector<size_t>> &candidates = std::nullopt, const std::stop_token &stopToken = { }) const;
+
+        [[nodiscard]] const std::string &getLiteral() const { return this->m_literal; }
+
+    private:
+        [[nodiscard]] static std::string findRequiredLiteral(std::string_view pattern);
+
+        std::string m_filter;
+        std::string m_literal;
+        std::optional<std::regex> m_regex;
+    };
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <hex/pattern_language/token.hpp>
+#include <hex/pattern_language/bytecode.hpp>
 #include <hex/pattern_language/evaluator.hpp>
 #include <hex/pattern_language/pattern_data.hpp>
 
@@ -9,6 +10,7 @@
 #include <chrono>
 #include <optional>
 #include <map>
+#include <memory>
 #include <thread>
 #include <variant>
 #include <vector>
@@ -182,126 +184,137 @@ namespace hex::pl {
             if (this->getLeftOperand() == nullptr || this->getRightOperand() == nullptr)
                 LogConsole::abortEvaluation("attempted to use void expression in mathematical expression", this);
 
+            if (evaluator->isBytecodeEnabled()) {
+                if (!this->m_bytecode.has_value())
+                    this->m_bytecode = Bytecode::compile(this);
+
+                return new ASTNodeLiteral(this->m_bytecode->execute(evaluator));
+            }
+
             auto *left = dynamic_cast<ASTNodeLiteral*>(this->getLeftOperand()->evaluate(evaluator));
             auto *right = dynamic_cast<ASTNodeLiteral*>(this->getRightOperand()->evaluate(evaluator));
             ON_SCOPE_EXIT { delete left; delete right; };
 
+            return new ASTNodeLiteral(this->evaluateOperator(left->getValue(), right->getValue()));
+        }
+
+        [[nodiscard]] Token::Literal evaluateOperator(const Token::Literal &leftValue, const Token::Literal &rightValue) const {
             return std::visit(overloaded {
                 // TODO: :notlikethis:
-                [this](u128 left, PatternData * const &right) -> ASTNode*           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
-                [this](s128 left, PatternData * const &right) -> ASTNode*           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
-                [this](double left, PatternData * const &right) -> ASTNode*         { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
-                [this](char left, PatternData * const &right) -> ASTNode*           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
-                [this](bool left, PatternData * const &right) -> ASTNode*           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
-                [this](std::string left, PatternData * const &right) -> ASTNode*    { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
-                [this](PatternData * const &left, u128 right) -> ASTNode*           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
-                [this](PatternData * const &left, s128 right) -> ASTNode*           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
-                [this](PatternData * const &left, double right) -> ASTNode*         { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
-                [this](PatternData * const &left, char right) -> ASTNode*           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
-                [this](PatternData * const &left, bool right) -> ASTNode*           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
-                [this](PatternData * const &left, std::string right) -> ASTNode*    { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
-                [this](PatternData * const &left, PatternData *right) -> ASTNode*   { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
-
-                [this](auto&& left, std::string right) -> ASTNode*          { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
-                [this](std::string left, auto&& right) -> ASTNode* {
+                [this](u128 left, PatternData * const &right) -> Token::Literal           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
+                [this](s128 left, PatternData * const &right) -> Token::Literal           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
+                [this](double left, PatternData * const &right) -> Token::Literal         { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
+                [this](char left, PatternData * const &right) -> Token::Literal           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
+                [this](bool left, PatternData * const &right) -> Token::Literal           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
+                [this](std::string left, PatternData * const &right) -> Token::Literal    { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
+                [this](PatternData * const &left, u128 right) -> Token::Literal           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
+                [this](PatternData * const &left, s128 right) -> Token::Literal           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
+                [this](PatternData * const &left, double right) -> Token::Literal         { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
+                [this](PatternData * const &left, char right) -> Token::Literal           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
+                [this](PatternData * const &left, bool right) -> Token::Literal           { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
+                [this](PatternData * const &left, std::string right) -> Token::Literal    { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
+                [this](PatternData * const &left, PatternData *right) -> Token::Literal   { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
+
+                [this](auto&& left, std::string right) -> Token::Literal          { LogConsole::abortEvaluation("invalid operand used in mathematical expression", this); },
+                [this](std::string left, auto&& right) -> Token::Literal {
                     switch (this->getOperator()) {
                         case Token::Operator::Star: {
                             std::string result;
                             for (auto i = 0; i < right; i++)
                                 result += left;
-                            return new ASTNodeLiteral(result);
+                            return result;
                         }
                         default:
                             LogConsole::abortEvaluation("invalid operand used in mathematical expression", this);
                     }
                 },
-                [this](std::string left, std::string right) -> ASTNode* {
+                [this](std::string left, std::string right) -> Token::Literal {
                     switch (this->getOperator()) {
                         case Token::Operator::Plus:
-                            return new ASTNodeLiteral(left + right);
+                            return left + right;
                         case Token::Operator::BoolEquals:
-                            return new ASTNodeLiteral(left == right);
+                            return left == right;
                         case Token::Operator::BoolNotEquals:
-                            return new ASTNodeLiteral(left != right);
+                            return left != right;
                         case Token::Operator::BoolGreaterThan:
-                            return new ASTNodeLiteral(left > right);
+                            return left > right;
                         case Token::Operator::BoolLessThan:
-                            return new ASTNodeLiteral(left < right);
+                            return left < right;
                         case Token::Operator::BoolGreaterThanOrEquals:
-                            return new ASTNodeLiteral(left >= right);
+                            return left >= right;
                         case Token::Operator::BoolLessThanOrEquals:
-                            return new ASTNodeLiteral(left <= right);
+                            return left <= right;
                         default:
                             LogConsole::abortEvaluation("invalid operand used in mathematical expression", this);
                     }
                 },
-                [this](std::string left, char right) -> ASTNode* {
+                [this](std::string left, char right) -> Token::Literal {
                     switch (this->getOperator()) {
                         case Token::Operator::Plus:
-                            return new ASTNodeLiteral(left + right);
+                            return left + right;
                         default:
                             LogConsole::abortEvaluation("invalid operand used in mathematical expression", this);
                     }
                 },
-                [this](char left, std::string right) -> ASTNode* {
+                [this](char left, std::string right) -> Token::Literal {
                         switch (this->getOperator()) {
                             case Token::Operator::Plus:
-                                return new ASTNodeLiteral(left + right);
+                                return left + right;
                             default:
                                 LogConsole::abortEvaluation("invalid operand used in mathematical expression", this);
                         }
                     },
-                [this](auto &&left, auto &&right) -> ASTNode* {
+                [this](auto &&left, auto &&right) -> Token::Literal {
                     switch (this->getOperator()) {
                         case Token::Operator::Plus:
-                            return new ASTNodeLiteral(left + right);
+                            return left + right;
                         case Token::Operator::Minus:
-                            return new ASTNodeLiteral(left - right);
+                            return left - right;
                         case Token::Operator::Star:
-                            return new ASTNodeLiteral(left * right);
+                            return left * right;
                         case Token::Operator::Slash:
                             if (right == 0) LogConsole::abortEvaluation("division by zero!", this);
-                            return new ASTNodeLiteral(left / right);
+                            return left / right;
                         case Token::Operator::Percent:
                             if (right == 0) LogConsole::abortEvaluation("division by zero!", this);
-                            return new ASTNodeLiteral(modulus(left, right));
+                            return modulus(left, right);
                         case Token::Operator::ShiftLeft:
-                            return new ASTNodeLiteral(shiftLeft(left, right));
+                            return shiftLeft(left, right);
                         case Token::Operator::ShiftRight:
-                            return new ASTNodeLiteral(shiftRight(left, right));
+                            return shiftRight(left, right);
                         case Token::Operator::BitAnd:
-                            return new ASTNodeLiteral(bitAnd(left, right));
+                            return bitAnd(left, right);
                         case Token::Operator::BitXor:
-                            return new ASTNodeLiteral(bitXor(left, right));
+                            return bitXor(left, right);
                         case Token::Operator::BitOr:
-                            return new ASTNodeLiteral(bitOr(left, right));
+                            return bitOr(left, right);
                         case Token::Operator::BitNot:
-                            return new ASTNodeLiteral(bitNot(left, right));
+                            return bitNot(left, right);
                         case Token::Operator::BoolEquals:
-                            return new ASTNodeLiteral(bool(left == right));
+                            return bool(left == right);
                         case Token::Operator::BoolNotEquals:
-                            return new ASTNodeLiteral(bool(left != right));
+                            return bool(left != right);
                         case Token::Operator::BoolGreaterThan:
-                            return new ASTNodeLiteral(bool(left > right));
+                            return bool(left > right);
                         case Token::Operator::BoolLessThan:
-                            return new ASTNodeLiteral(bool(left < right));
+                            return bool(left < right);
                         case Token::Operator::BoolGreaterThanOrEquals:
-                            return new ASTNodeLiteral(bool(left >= right));
+                            return bool(left >= right);
                         case Token::Operator::BoolLessThanOrEquals:
-                            return new ASTNodeLiteral(bool(left <= right));
+                            return bool(left <= right);
                         case Token::Operator::BoolAnd:
-                            return new ASTNodeLiteral(bool(left && right));
+                            return bool(left && right);
                         case Token::Operator::BoolXor:
-                            return new ASTNodeLiteral(bool(left && !right || !left && right));
+                            return bool(left && !right || !left && right);
                         case Token::Operator::BoolOr:
-                            return new ASTNodeLiteral(bool(left || right));
+                            return bool(left || right);
                         case Token::Operator::BoolNot:
-                            return new ASTNodeLiteral(bool(!right));
+                            return bool(!right);
                         default:
                             LogConsole::abortEvaluation("invalid operand used in mathematical expression", this);
                     }
                 }
-            }, left->getValue(), right->getValue());
+            }, leftValue, rightValue);
         }
 
         [[nodiscard]] ASTNode *getLeftOperand() const { return this->m_left; }
@@ -311,6 +324,8 @@ namespace hex::pl {
     private:
         ASTNode *m_left, *m_right;
         Token::Operator m_operator;
+
+        mutable std::optional<Bytecode> m_bytecode;
     };
 
     class ASTNodeTernaryExpression : public ASTNode {
@@ -339,21 +354,32 @@ namespace hex::pl {
             if (this->getFirstOperand() == nullptr || this->getSecondOperand() == nullptr || this->getThirdOperand() == nullptr)
                 LogConsole::abortEvaluation("attempted to use void expression in mathematical expression", this);
 
+            if (evaluator->isBytecodeEnabled()) {
+                if (!this->m_bytecode.has_value())
+                    this->m_bytecode = Bytecode::compile(this);
+
+                return new ASTNodeLiteral(this->m_bytecode->execute(evaluator));
+            }
+
             auto *first = dynamic_cast<ASTNodeLiteral*>(this->getFirstOperand()->evaluate(evaluator));
             auto *second = dynamic_cast<ASTNodeLiteral*>(this->getSecondOperand()->evaluate(evaluator));
             auto *third = dynamic_cast<ASTNodeLiteral*>(this->getThirdOperand()->evaluate(evaluator));
             ON_SCOPE_EXIT { delete first; delete second; delete third; };
 
+            return new ASTNodeLiteral(this->evaluateOperator(first->getValue(), second->getValue(), third->getValue()));
+        }
+
+        [[nodiscard]] Token::Literal evaluateOperator(const Token::Literal &firstValue, const Token::Literal &secondValue, const Token::Literal &thirdValue) const {
             auto condition = std::visit(overloaded {
                 [this](std::string value) -> bool { return !value.empty(); },
                 [this](PatternData * const &) -> bool { LogConsole::abortEvaluation("cannot cast custom type to bool", this); },
                 [](auto &&value) -> bool { return bool(value); }
-            }, first->getValue());
+            }, firstValue);
 
             return std::visit(overloaded {
-                [condition]<typename T>(const T &second, const T &third) -> ASTNode* { return new ASTNodeLiteral(condition ? second : third); },
-                [this](auto &&second, auto &&third) -> ASTNode* { LogConsole::abortEvaluation("operands to ternary expression have different types", this); }
-            }, second->getValue(), third->getValue());
+                [condition]<typename T>(const T &second, const T &third) -> Token::Literal { return condition ? second : third; },
+                [this](auto &&second, auto &&third) -> Token::Literal { LogConsole::abortEvaluation("operands to ternary expression have different types", this); }
+            }, secondValue, thirdValue);
         }
 
         [[nodiscard]] ASTNode *getFirstOperand() const { return this->m_first; }
@@ -364,6 +390,7 @@ namespace hex::pl {
     private:
         ASTNode *m_first, *m_second, *m_third;
         Token::Operator m_operator;
+        mutable std::optional<Bytecode> m_bytecode;
     };
 
     class ASTNodeBuiltinType : public ASTNode {
@@ -483,9 +510,27 @@ namespace hex::pl {
             return new ASTNodeCast(*this);
         }
 
+        [[nodiscard]] ASTNode* getValue() const { return this->m_value; }
+        [[nodiscard]] ASTNode* getType() const { return this->m_type; }
+
         [[nodiscard]] ASTNode* evaluate(Evaluator *evaluator) const override {
+            if (evaluator->isBytecodeEnabled()) {
+                if (!this->m_bytecode.has_value())
+                    this->m_bytecode = Bytecode::compile(this);
+
+                return new ASTNodeLiteral(this->m_bytecode->execute(evaluator));
+            }
+
             auto literal = dynamic_cast<ASTNodeLiteral*>(this->m_value->evaluate(evaluator));
-            auto type = dynamic_cast<ASTNodeBuiltinType*>(this->m_type->evaluate(evaluator))->getType();
+            ON_SCOPE_EXIT { delete literal; };
+
+            return new ASTNodeLiteral(this->evaluateCast(evaluator, literal->getValue()));
+        }
+
+        [[nodiscard]] Token::Literal evaluateCast(Evaluator *evaluator, const Token::Literal &value) const {
+            auto typeNode = dynamic_cast<ASTNodeBuiltinType*>(this->m_type->evaluate(evaluator));
+            ON_SCOPE_EXIT { delete typeNode; };
+            auto type = typeNode->getType();
 
             auto startOffset= evaluator->dataOffset();
 
@@ -496,41 +541,41 @@ namespace hex::pl {
             };
 
             return std::visit(overloaded {
-                    [&, this](PatternData * value) -> ASTNode* { LogConsole::abortEvaluation(hex::format("cannot cast custom type '{}' to '{}'", value->getTypeName(), Token::getTypeName(type)), this); },
-                    [&, this](const std::string&) -> ASTNode* { LogConsole::abortEvaluation(hex::format("cannot cast string to '{}'", Token::getTypeName(type)), this); },
-                    [&, this](auto &&value) -> ASTNode* {
+                    [&, this](PatternData * value) -> Token::Literal { LogConsole::abortEvaluation(hex::format("cannot cast custom type '{}' to '{}'", value->getTypeName(), Token::getTypeName(type)), this); },
+                    [&, this](const std::string&) -> Token::Literal { LogConsole::abortEvaluation(hex::format("cannot cast string to '{}'", Token::getTypeName(type)), this); },
+                    [&, this](auto &&value) -> Token::Literal {
                         auto endianAdjustedValue = hex::changeEndianess(value, typePattern->getSize(), typePattern->getEndian());
                         switch (type) {
                             case Token::ValueType::Unsigned8Bit:
-                                return new ASTNodeLiteral(u128(u8(endianAdjustedValue)));
+                                return u128(u8(endianAdjustedValue));
                             case Token::ValueType::Unsigned16Bit:
-                                return new ASTNodeLiteral(u128(u16(endianAdjustedValue)));
+                                return u128(u16(endianAdjustedValue));
                             case Token::ValueType::Unsigned32Bit:
-                                return new ASTNodeLiteral(u128(u32(endianAdjustedValue)));
+                                return u128(u32(endianAdjustedValue));
                             case Token::ValueType::Unsigned64Bit:
-                                return new ASTNodeLiteral(u128(u64(endianAdjustedValue)));
+                                return u128(u64(endianAdjustedValue));
                             case Token::ValueType::Unsigned128Bit:
-                                return new ASTNodeLiteral(u128(endianAdjustedValue));
+                                return u128(endianAdjustedValue);
                             case Token::ValueType::Signed8Bit:
-                                return new ASTNodeLiteral(s128(s8(endianAdjustedValue)));
+                                return s128(s8(endianAdjustedValue));
                             case Token::ValueType::Signed16Bit:
-                                return new ASTNodeLiteral(s128(s16(endianAdjustedValue)));
+                                return s128(s16(endianAdjustedValue));
                             case Token::ValueType::Signed32Bit:
-                                return new ASTNodeLiteral(s128(s32(endianAdjustedValue)));
+                                return s128(s32(endianAdjustedValue));
                             case Token::ValueType::Signed64Bit:
-                                return new ASTNodeLiteral(s128(s64(endianAdjustedValue)));
+                                return s128(s64(endianAdjustedValue));
                             case Token::ValueType::Signed128Bit:
-                                return new ASTNodeLiteral(s128(endianAdjustedValue));
+                                return s128(endianAdjustedValue);
                             case Token::ValueType::Float:
-                                return new ASTNodeLiteral(double(float(endianAdjustedValue)));
+                                return double(float(endianAdjustedValue));
                             case Token::ValueType::Double:
-                                return new ASTNodeLiteral(double(endianAdjustedValue));
+                                return double(endianAdjustedValue);
                             case Token::ValueType::Character:
-                                return new ASTNodeLiteral(char(endianAdjustedValue));
+                                return char(endianAdjustedValue);
                             case Token::ValueType::Character16:
-                                return new ASTNodeLiteral(u128(char16_t(endianAdjustedValue)));
+                                return u128(char16_t(endianAdjustedValue));
                             case Token::ValueType::Boolean:
-                                return new ASTNodeLiteral(bool(endianAdjustedValue));
+                                return bool(endianAdjustedValue);
                             case Token::ValueType::String:
                             {
                                 std::string string(sizeof(value), '\x00');
@@ -540,18 +585,20 @@ namespace hex::pl {
                                 if (typePattern->getEndian() != std::endian::native)
                                     std::reverse(string.begin(), string.end());
 
-                                return new ASTNodeLiteral(string);
+                                return string;
                             }
                             default:
                                 LogConsole::abortEvaluation(hex::format("cannot cast value to '{}'", Token::getTypeName(type)), this);
                         }
                     },
-            }, literal->getValue());
+            }, value);
         }
 
     private:
         ASTNode *m_value;
         ASTNode *m_type;
+
+        mutable std::optional<Bytecode> m_bytecode;
     };
 
     class ASTNodeWhileStatement : public ASTNode {
@@ -592,6 +639,10 @@ namespace hex::pl {
             return this->m_body;
         }
 
+        [[nodiscard]] ASTNode* getPostExpression() {
+            return this->m_postExpression;
+        }
+
         FunctionResult execute(Evaluator *evaluator) const override {
 
             u64 loopIterations = 0;
@@ -865,7 +916,7 @@ namespace hex::pl {
                     return attribute->getAttribute() == "static" && !attribute->getValue().has_value();
                 });
 
-                if (isStaticType)
+                if (isStaticType || hasFixedLayout(type))
                     pattern = createStaticArray(evaluator);
                 else
                     pattern = createDynamicArray(evaluator);
@@ -888,6 +939,10 @@ namespace hex::pl {
         ASTNode *m_size;
         ASTNode *m_placementOffset;
 
+        // Types whose layout doesn't depend on the data they're placed on only need to be created once for the whole array,
+        // entries are then created on demand by moving that template over them
+        [[nodiscard]] static bool hasFixedLayout(ASTNode *type, u32 depth = 0);
+
         PatternData* createStaticArray(Evaluator *evaluator) const {
             u64 startOffset = evaluator->dataOffset();
 
@@ -921,7 +976,7 @@ namespace hex::pl {
                     if (evaluator->dataOffset() >= evaluator->getProvider()->getActualSize() - buffer.size())
                         LogConsole::abortEvaluation("reached end of file before finding end of unsized array", this);
 
-                    evaluator->getProvider()->read(evaluator->dataOffset(), buffer.data(), buffer.size());
+                    evaluator->readData(evaluator->dataOffset(), buffer.data(), buffer.size());
                     evaluator->dataOffset() += buffer.size();
 
                     entryCount++;
@@ -1070,7 +1125,7 @@ namespace hex::pl {
                             continue;
                         }
 
-                        evaluator->getProvider()->read(evaluator->dataOffset() - pattern->getSize(), buffer.data(), buffer.size());
+                        evaluator->readData(evaluator->dataOffset() - pattern->getSize(), buffer.data(), buffer.size());
                         bool reachedEnd = true;
                         for (u8 &byte : buffer) {
                             if (byte != 0x00) {
@@ -1151,7 +1206,7 @@ namespace hex::pl {
 
             {
                 u128 pointerAddress = 0;
-                evaluator->getProvider()->read(pattern->getOffset(), &pointerAddress, pattern->getSize());
+                evaluator->readData(pattern->getOffset(), &pointerAddress, pattern->getSize());
                 pointerAddress = hex::changeEndianess(pointerAddress, sizePattern->getSize(), sizePattern->getEndian());
 
                 evaluator->dataOffset() = startOffset;
@@ -1506,15 +1561,29 @@ namespace hex::pl {
             return this->m_path;
         }
 
+        void setVariableSlot(u32 slot) {
+            this->m_variableSlot = slot;
+        }
+
         [[nodiscard]] ASTNode* evaluate(Evaluator *evaluator) const override {
+            return new ASTNodeLiteral(this->evaluateValue(evaluator));
+        }
+
+        [[nodiscard]] Token::Literal evaluateValue(Evaluator *evaluator) const {
             if (this->getPath().size() == 1) {
                 if (auto name = std::get_if<std::string>(&this->getPath().front()); name != nullptr) {
-                    if (*name == "$") return new ASTNodeLiteral(u128(evaluator->dataOffset()));
+                    if (*name == "$") return u128(evaluator->dataOffset());
                 }
             }
 
-            auto pattern = this->createPatterns(evaluator).front();
-            ON_SCOPE_EXIT { delete pattern; };
+            // Plain local variables can be read directly, everything else needs a copy of the pattern at the end of the path
+            PatternData *pattern = this->getResolvedVariable(evaluator);
+            bool ownsPattern = false;
+            if (pattern == nullptr || this->getPath().size() > 1 || dynamic_cast<PatternDataPointer*>(pattern) != nullptr) {
+                pattern = this->createPatterns(evaluator).front();
+                ownsPattern = true;
+            }
+            ON_SCOPE_EXIT { if (ownsPattern) delete pattern; };
 
             Token::Literal literal;
             if (dynamic_cast<PatternDataUnsigned*>(pattern) || dynamic_cast<PatternDataEnum*>(pattern)) {
@@ -1568,7 +1637,7 @@ namespace hex::pl {
                 }
                 else {
                     value.resize(pattern->getSize());
-                    evaluator->getProvider()->read(pattern->getOffset(), value.data(), value.size());
+                    evaluator->readData(pattern->getOffset(), value.data(), value.size());
                     value.erase(std::find(value.begin(), value.end(), '\0'), value.end());
                 }
 
@@ -1589,27 +1658,42 @@ namespace hex::pl {
                 literal = result.value();
             }
 
-            return new ASTNodeLiteral(literal);
+            return literal;
         }
 
         [[nodiscard]] std::vector<PatternData*> createPatterns(Evaluator *evaluator) const override {
             std::vector<PatternData*> searchScope;
+            // Patterns along the path are only borrowed from the scopes, just the one at the end gets cloned for the caller.
+            // Static array entries don't exist as patterns of their own though and are owned here while walking the path
             PatternData *currPattern = nullptr;
+            std::unique_ptr<PatternData> ownedPattern;
             s32 scopeIndex = 0;
 
-            if (!evaluator->isGlobalScope()){
-                auto globalScope = evaluator->getGlobalScope().scope;
-                std::copy(globalScope->begin(), globalScope->end(), std::back_inserter(searchScope));
-            }
+            auto takePattern = [&]() -> PatternData* {
+                if (currPattern == ownedPattern.get())
+                    return ownedPattern.release();
+                else
+                    return currPattern->clone();
+            };
 
-            {
-                auto currScope = evaluator->getScope(scopeIndex).scope;
-                std::copy(currScope->begin(), currScope->end(), std::back_inserter(searchScope));
+            auto resolvedVariable = this->getResolvedVariable(evaluator);
+            if (resolvedVariable == nullptr) {
+                if (!evaluator->isGlobalScope()){
+                    auto globalScope = evaluator->getGlobalScope().scope;
+                    std::copy(globalScope->begin(), globalScope->end(), std::back_inserter(searchScope));
+                }
+
+                {
+                    auto currScope = evaluator->getScope(scopeIndex).scope;
+                    std::copy(currScope->begin(), currScope->end(), std::back_inserter(searchScope));
+                }
             }
 
             for (const auto &part : this->getPath()) {
 
-                if (part.index() == 0) {
+                if (resolvedVariable != nullptr && &part == &this->getPath().front()) {
+                    currPattern = resolvedVariable;
+                } else if (part.index() == 0) {
                     // Variable access
                     auto name = std::get<std::string>(part);
 
@@ -1622,11 +1706,7 @@ namespace hex::pl {
                         searchScope = *evaluator->getScope(scopeIndex).scope;
                         auto currParent = evaluator->getScope(scopeIndex).parent;
 
-                        if (currParent == nullptr) {
-                            currPattern = nullptr;
-                        } else {
-                            currPattern = currParent->clone();
-                        }
+                        currPattern = currParent;
 
                         continue;
                     } else if (name == "this") {
@@ -1637,15 +1717,13 @@ namespace hex::pl {
                         if (currParent == nullptr)
                             LogConsole::abortEvaluation("invalid use of 'this' outside of struct-like type", this);
 
-                        currPattern = currParent->clone();
+                        currPattern = currParent;
                         continue;
                     } else {
                         bool found = false;
                         for (auto iter = searchScope.crbegin(); iter != searchScope.crend(); ++iter) {
                             if ((*iter)->getVariableName() == name) {
-                                auto newPattern = (*iter)->clone();
-                                delete currPattern;
-                                currPattern = newPattern;
+                                currPattern = *iter;
                                 found = true;
                                 break;
                             }
@@ -1670,9 +1748,7 @@ namespace hex::pl {
                                 if (index >= searchScope.size() || index < 0)
                                     LogConsole::abortEvaluation("array index out of bounds", this);
 
-                                auto newPattern = searchScope[index]->clone();
-                                delete currPattern;
-                                currPattern = newPattern;
+                                currPattern = searchScope[index];
                             }
                             else if (auto staticArrayPattern = dynamic_cast<PatternDataStaticArray*>(currPattern)) {
                                 if (index >= staticArrayPattern->getEntryCount() || index < 0)
@@ -1680,7 +1756,7 @@ namespace hex::pl {
 
                                 auto newPattern = searchScope.front()->clone();
                                 newPattern->setOffset(staticArrayPattern->getOffset() + index * staticArrayPattern->getTemplate()->getSize());
-                                delete currPattern;
+                                ownedPattern.reset(newPattern);
                                 currPattern = newPattern;
                             }
                         }
@@ -1690,11 +1766,8 @@ namespace hex::pl {
                 if (currPattern == nullptr)
                     break;
 
-                if (auto pointerPattern = dynamic_cast<PatternDataPointer*>(currPattern)) {
-                    auto newPattern = pointerPattern->getPointedAtPattern()->clone();
-                    delete currPattern;
-                    currPattern = newPattern;
-                }
+                if (auto pointerPattern = dynamic_cast<PatternDataPointer*>(currPattern))
+                    currPattern = pointerPattern->getPointedAtPattern();
 
                 PatternData *indexPattern;
                 if (currPattern->isLocal()) {
@@ -1702,7 +1775,7 @@ namespace hex::pl {
                     if (auto stackPattern = std::get_if<PatternData*>(&stackLiteral); stackPattern != nullptr)
                         indexPattern = *stackPattern;
                     else
-                        return { currPattern };
+                        return { takePattern() };
                 }
                 else
                     indexPattern = currPattern;
@@ -1723,11 +1796,19 @@ namespace hex::pl {
             if (currPattern == nullptr)
                 LogConsole::abortEvaluation("cannot reference global scope", this);
 
-            return { currPattern };
+            return { takePattern() };
         }
 
     private:
         Path m_path;
+        std::optional<u32> m_variableSlot;
+
+        [[nodiscard]] PatternData* getResolvedVariable(Evaluator *evaluator) const {
+            if (!this->m_variableSlot.has_value())
+                return nullptr;
+
+            return evaluator->getLocalVariable(*this->m_variableSlot, std::get<std::string>(this->getPath().front()));
+        }
 
         void readVariable(Evaluator *evaluator, auto &value, PatternData *variablePattern) const {
             constexpr bool isString = std::same_as<std::remove_cvref_t<decltype(value)>, std::string>;
@@ -1746,10 +1827,10 @@ namespace hex::pl {
             else {
                 if constexpr (isString) {
                     value.resize(variablePattern->getSize());
-                    evaluator->getProvider()->read(variablePattern->getOffset(), value.data(), value.size());
+                    evaluator->readData(variablePattern->getOffset(), value.data(), value.size());
                     value.erase(std::find(value.begin(), value.end(), '\0'), value.end());
                 } else {
-                    evaluator->getProvider()->read(variablePattern->getOffset(), &value, variablePattern->getSize());
+                    evaluator->readData(variablePattern->getOffset(), &value, variablePattern->getSize());
                 }
             }
 
@@ -1829,8 +1910,7 @@ namespace hex::pl {
 
             for (auto &node : body) {
                 auto newPatterns = node->createPatterns(evaluator);
-                for (auto &pattern : newPatterns)
-                    scope.push_back(pattern->clone());
+                scope.insert(scope.end(), newPatterns.begin(), newPatterns.end());
             }
 
             return { };
@@ -1972,6 +2052,7 @@ namespace hex::pl {
                     while (evaluator->getDangerousFunctionPermission() == DangerousFunctionPermission::Ask) {
                         using namespace std::literals::chrono_literals;
 
+                        evaluator->handleAbort();
                         std::this_thread::sleep_for(100ms);
                     }
 
@@ -2064,6 +2145,7 @@ namespace hex::pl {
         ASTNodeAssignment(const ASTNodeAssignment &other) : ASTNode(other) {
             this->m_lvalueName = other.m_lvalueName;
             this->m_rvalue = other.m_rvalue->clone();
+            this->m_variableSlot = other.m_variableSlot;
         }
 
         [[nodiscard]] ASTNode* clone() const override {
@@ -2082,11 +2164,22 @@ namespace hex::pl {
             return this->m_rvalue;
         }
 
+        void setVariableSlot(u32 slot) {
+            this->m_variableSlot = slot;
+        }
+
         FunctionResult execute(Evaluator *evaluator) const override {
             auto literal = dynamic_cast<ASTNodeLiteral*>(this->getRValue()->evaluate(evaluator));
             ON_SCOPE_EXIT { delete literal; };
 
-            evaluator->setVariable(this->getLValueName(), literal->getValue());
+            PatternData *variable = nullptr;
+            if (this->m_variableSlot.has_value())
+                variable = evaluator->getLocalVariable(*this->m_variableSlot, this->getLValueName());
+
+            if (variable != nullptr)
+                evaluator->setVariable(variable, literal->getValue());
+            else
+                evaluator->setVariable(this->getLValueName(), literal->getValue());
 
             return { };
         }
@@ -2094,6 +2187,7 @@ namespace hex::pl {
     private:
         std::string m_lvalueName;
         ASTNode *m_rvalue;
+        std::optional<u32> m_variableSlot;
     };
 
     class ASTNodeControlFlowStatement : public ASTNode {
@@ -2133,14 +2227,15 @@ namespace hex::pl {
         FunctionResult execute(Evaluator *evaluator) const override {
             auto returnValue = this->getReturnValue();
 
-            evaluator->setCurrentControlFlowStatement(this->m_type);
-
-            if (returnValue == nullptr)
+            if (returnValue == nullptr) {
+                evaluator->setCurrentControlFlowStatement(this->m_type);
                 return std::nullopt;
-            else {
+            } else {
+                // Evaluate the value first, function calls inside of it would otherwise see the control flow statement already set
                 auto literal = dynamic_cast<ASTNodeLiteral*>(returnValue->evaluate(evaluator));
                 ON_SCOPE_EXIT { delete literal; };
 
+                evaluator->setCurrentControlFlowStatement(this->m_type);
                 return literal->getValue();
             }
         }
@@ -2325,4 +2420,44 @@ namespace hex::pl {
         bool m_newScope;
     };
 
+    inline bool ASTNodeArrayVariableDecl::hasFixedLayout(ASTNode *type, u32 depth) {
+        if (depth > 32)
+            return false;
+
+        auto isFixedMember = [depth](ASTNode *member) -> bool {
+            if (auto variableDecl = dynamic_cast<ASTNodeVariableDecl*>(member))
+                return variableDecl->getPlacementOffset() == nullptr && hasFixedLayout(variableDecl->getType(), depth + 1);
+            else if (auto arrayDecl = dynamic_cast<ASTNodeArrayVariableDecl*>(member))
+                return arrayDecl->getPlacementOffset() == nullptr && dynamic_cast<ASTNodeLiteral*>(arrayDecl->getSize()) != nullptr && hasFixedLayout(arrayDecl->getType(), depth + 1);
+            else if (auto multiVariableDecl = dynamic_cast<ASTNodeMultiVariableDecl*>(member)) {
+                auto variables = multiVariableDecl->getVariables();
+                return std::all_of(variables.begin(), variables.end(), [depth](ASTNode *variable) {
+                    auto variableDecl = dynamic_cast<ASTNodeVariableDecl*>(variable);
+                    return variableDecl != nullptr && variableDecl->getPlacementOffset() == nullptr && hasFixedLayout(variableDecl->getType(), depth + 1);
+                });
+            }
+            else
+                return false;
+        };
+
+        if (auto typeDecl = dynamic_cast<ASTNodeTypeDecl*>(type))
+            return hasFixedLayout(typeDecl->getType(), depth + 1);
+        else if (dynamic_cast<ASTNodeBuiltinType*>(type) || dynamic_cast<ASTNodeEnum*>(type) || dynamic_cast<ASTNodeBitfield*>(type))
+            return true;
+        else if (auto structNode = dynamic_cast<ASTNodeStruct*>(type)) {
+            auto &inheritance = structNode->getInheritance();
+            auto &members = structNode->getMembers();
+
+            return std::all_of(inheritance.begin(), inheritance.end(), [depth](ASTNode *base) { return hasFixedLayout(base, depth + 1); }) &&
+                   std::all_of(members.begin(), members.end(), isFixedMember);
+        }
+        else if (auto unionNode = dynamic_cast<ASTNodeUnion*>(type)) {
+            auto &members = unionNode->getMembers();
+
+            return std::all_of(members.begin(), members.end(), isFixedMember);
+        }
+        else
+            return false;
+    }
+
 };
\ No newline at end of file
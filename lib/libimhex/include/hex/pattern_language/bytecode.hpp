@@ -0,0 +1,51 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <hex/pattern_language/token.hpp>
+
+#include <vector>
+
+namespace hex::pl {
+
+    class ASTNode;
+    class Evaluator;
+
+    /*
+     * Flattened form of an expression tree. Operands are kept as plain literals on a stack instead of
+     * every node of the tree allocating a new ASTNodeLiteral for its result.
+     * Nodes that aren't expressions (function calls, type operators, ...) are still evaluated by the tree walker.
+     */
+    class Bytecode {
+    public:
+        enum class OpCode : u8 {
+            PushLiteral,    // Push the value of an ASTNodeLiteral
+            LoadVariable,   // Push the value of an ASTNodeRValue
+            Operator,       // Replace the top two values with the result of an ASTNodeMathematicalExpression
+            Ternary,        // Replace the top three values with the result of an ASTNodeTernaryExpression
+            Cast,           // Replace the top value with the result of an ASTNodeCast
+            Evaluate        // Push the result of evaluating the node with the tree walker
+        };
+
+        struct Instruction {
+            OpCode opCode;
+            const ASTNode *node;
+        };
+
+        [[nodiscard]] static Bytecode compile(const ASTNode *expression);
+
+        [[nodiscard]] Token::Literal execute(Evaluator *evaluator) const;
+
+        [[nodiscard]] const std::vector<Instruction>& getInstructions() const {
+            return this->m_instructions;
+        }
+
+    private:
+        Bytecode() = default;
+
+        void compileNode(const ASTNode *node);
+
+        std::vector<Instruction> m_instructions;
+    };
+
+}
@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <bit>
+#include <functional>
 #include <map>
 #include <optional>
 #include <vector>
@@ -40,6 +41,15 @@ namespace hex::pl {
 
         std::optional<std::vector<PatternData*>> evaluate(const std::vector<ASTNode*> &ast);
 
+        /*
+         * Evaluates the same AST again after the given regions of data changed. The patterns returned by the last run get handed back by the caller.
+         * Only the top-level statements starting at the first one that read changed data get evaluated again, everything before that is reused.
+         */
+        std::optional<std::vector<PatternData*>> reevaluate(const std::vector<ASTNode*> &ast, const std::vector<Region> &changedRegions);
+
+        // Destroys the patterns of the last run after the caller handed them back
+        void discardResult();
+
         [[nodiscard]]
         LogConsole& getConsole() {
             return this->m_console;
@@ -77,6 +87,7 @@ namespace hex::pl {
 
         void setProvider(prv::Provider *provider) {
             this->m_provider = provider;
+            this->invalidateReadCache();
         }
 
         void setInVariables(const std::map<std::string, Token::Literal> &inVariables) {
@@ -99,6 +110,10 @@ namespace hex::pl {
             return this->m_provider;
         }
 
+        // Reads data from the provider and remembers which top-level statement depended on it
+        void readData(u64 address, void *buffer, size_t size);
+        void addReadRegion(u64 address, size_t size);
+
         void setDefaultEndian(std::endian endian) {
             this->m_defaultEndian = endian;
         }
@@ -149,10 +164,50 @@ namespace hex::pl {
             return this->m_loopLimit;
         }
 
+        void setBytecodeEnabled(bool enabled) {
+            this->m_bytecodeEnabled = enabled;
+        }
+
+        [[nodiscard]]
+        bool isBytecodeEnabled() const {
+            return this->m_bytecodeEnabled;
+        }
+
+        // Operand stack shared by all bytecode programs, see Bytecode::execute
+        [[nodiscard]]
+        std::vector<Token::Literal>& getBytecodeStack() {
+            return this->m_bytecodeStack;
+        }
+
         u64& dataOffset() { return this->m_currOffset; }
 
+        /*
+         * Called on the evaluating thread after every top-level declaration that created patterns with all global patterns so far, including local variables.
+         * These stay owned by the evaluator and won't change anymore. Before patterns get destroyed, the callback is called with a list that doesn't contain
+         * them anymore, an empty one if evaluation failed. Calls that only add patterns to the previous list may be ignored.
+         */
+        using PartialResultCallback = std::function<void(const std::vector<PatternData*>&)>;
+        void setPartialResultCallback(const PartialResultCallback &callback) {
+            this->m_partialResultCallback = callback;
+        }
+
+        /*
+         * Set by whoever runs the evaluator on another thread for as long as it uses it, from setting up a run until its results have been collected.
+         * Formatters of the displayed patterns don't run on the evaluator in the meantime
+         */
+        void setBusy(bool busy) {
+            this->m_busy = busy;
+        }
+
+        [[nodiscard]]
+        bool isEvaluating() const {
+            return this->m_evaluating || this->m_busy;
+        }
+
         bool addCustomFunction(const std::string &name, u32 numParams, const ContentRegistry::PatternLanguage::Callback &function) {
             const auto [iter, inserted] = this->m_customFunctions.insert({ name, { numParams, function } });
+            if (inserted)
+                this->m_customFunctionNames.push_back(name);
 
             return inserted;
         }
@@ -174,11 +229,20 @@ namespace hex::pl {
 
         void createVariable(const std::string &name, ASTNode *type, const std::optional<Token::Literal> &value = std::nullopt, bool outVariable = false);
         void setVariable(const std::string &name, const Token::Literal& value);
+        void setVariable(PatternData *pattern, const Token::Literal& value);
+
+        // Returns the variable in the given slot of the current scope if it's the one the resolver expected there
+        [[nodiscard]] PatternData* getLocalVariable(u32 slot, const std::string &name);
 
+        // Stays set until resetAbort() is called so an abort requested before evaluation started isn't lost
         void abort() {
             this->m_aborted = true;
         }
 
+        void resetAbort() {
+            this->m_aborted = false;
+        }
+
         void handleAbort() {
             if (this->m_aborted)
                 LogConsole::abortEvaluation("evaluation aborted by user");
@@ -229,6 +293,15 @@ namespace hex::pl {
         void patternCreated();
         void patternDestroyed();
 
+        std::optional<std::vector<PatternData*>> evaluateStatements(const std::vector<ASTNode*> &ast, size_t firstStatement, size_t publishedPatternCount);
+        void createCheckpoint();
+
+        // Returns the placed global patterns to the caller and remembers the ones that stay owned by the evaluator
+        std::vector<PatternData*> handOutResult();
+
+        void invalidateReadCache();
+        void readCached(u64 address, void *buffer, size_t size);
+
     private:
         u64 m_currOffset;
         prv::Provider *m_provider = nullptr;
@@ -242,12 +315,18 @@ namespace hex::pl {
 
         u64 m_currPatternCount;
 
-        std::atomic<bool> m_aborted;
+        std::atomic<bool> m_aborted = false;
+        std::atomic<bool> m_evaluating = false;
+        std::atomic<bool> m_busy = false;
+        PartialResultCallback m_partialResultCallback;
 
         std::vector<Scope> m_scopes;
         std::map<std::string, ContentRegistry::PatternLanguage::Function> m_customFunctions;
+        std::vector<std::string> m_customFunctionNames;
         std::vector<ASTNode*> m_customFunctionDefinitions;
         std::vector<Token::Literal> m_stack;
+        bool m_bytecodeEnabled = true;
+        std::vector<Token::Literal> m_bytecodeStack;
 
         std::map<std::string, Token::Literal> m_envVariables;
         std::map<std::string, Token::Literal> m_inVariables;
@@ -257,6 +336,41 @@ namespace hex::pl {
         std::atomic<DangerousFunctionPermission> m_allowDangerousFunctions = DangerousFunctionPermission::Ask;
         ControlFlowStatement m_currControlFlowStatement;
 
+        // State before every top-level statement of the last successful run and the data that statement read, the last one belongs to the main function
+        struct Checkpoint {
+            size_t globalPatternCount;
+            std::vector<Token::Literal> stack;
+            u64 dataOffset;
+            u64 patternCount;
+            size_t functionCount;
+            size_t functionDefinitionCount;
+            size_t consoleLogSize;
+            u32 paletteOffset;
+
+            std::vector<Region> reads;
+        };
+
+        std::vector<PatternData*> m_globalPatterns;
+        std::vector<Checkpoint> m_checkpoints;
+
+        // Global local variables of the last result. Placed patterns are only owned by the caller until they're handed back
+        std::vector<PatternData*> m_ownedPatterns;
+        std::vector<Region> m_currReads;
+
+        // Pages of provider data read during the current run, so members placed next to each other don't each go through the patches and overlays again
+        constexpr static size_t ReadPageSize  = 0x1000;
+        constexpr static size_t ReadPageCount = 8;
+
+        struct ReadPage {
+            u64 address;
+            size_t size;
+            std::vector<u8> data;
+        };
+
+        std::vector<ReadPage> m_readPages;
+        size_t m_lastReadPage = 0;
+        size_t m_nextReadPage = 0;
+
         friend class PatternCreationLimiter;
     };
 
@@ -35,6 +35,7 @@ namespace hex::pl {
         static void abortEvaluation(const std::string &message, const ASTNode *node);
 
         void clear();
+        void truncate(size_t size);
 
         void setHardError(const EvaluateError &error) { this->m_lastHardError = error; }
 
@@ -254,7 +254,8 @@ namespace hex::pl {
 
         [[nodiscard]]
         std::string formatDisplayValue(const std::string &value, const Token::Literal &literal) const {
-            if (!this->m_formatterFunction.has_value())
+            // Formatters run on the evaluator which is still busy while partial results are displayed
+            if (!this->m_formatterFunction.has_value() || this->getEvaluator()->isEvaluating())
                 return value;
             else {
                 try {
@@ -868,8 +869,8 @@ namespace hex::pl {
 
         [[nodiscard]]
         const PatternData* getPattern(u64 offset) const override {
-            auto iter = std::find_if(this->m_entries.begin(), this->m_entries.end(), [this, offset](PatternData *pattern){
-               return offset >= this->getOffset() && offset < (this->getOffset() + this->getSize());
+            auto iter = std::find_if(this->m_entries.begin(), this->m_entries.end(), [offset](PatternData *pattern){
+               return offset >= pattern->getOffset() && offset < (pattern->getOffset() + pattern->getSize());
             });
 
             if (iter == this->m_entries.end())
@@ -1018,7 +1019,9 @@ namespace hex::pl {
         [[nodiscard]]
         const PatternData* getPattern(u64 offset) const override {
             if (offset >= this->getOffset() && offset < (this->getOffset() + this->getSize())) {
-                this->m_highlightTemplate->setOffset((offset / this->m_highlightTemplate->getSize()) * this->m_highlightTemplate->getSize());
+                auto entrySize = this->m_highlightTemplate->getSize();
+                this->m_highlightTemplate->setOffset(this->getOffset() + ((offset - this->getOffset()) / entrySize) * entrySize);
+
                 return this->m_highlightTemplate;
             } else {
                 return nullptr;
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace hex::pl {
+
+    class PatternData;
+
+    /*
+     * Sorted list of non-overlapping address ranges with the color of the innermost pattern placed there.
+     * Built once after evaluation so highlighting doesn't need to walk the pattern tree for every byte.
+     * Where patterns overlap, the one that comes first in the tree wins. Arrays using a template pattern
+     * are stored as a single repeating range that refers to an index of their template.
+     */
+    class PatternIndex {
+    public:
+        PatternIndex() = default;
+        explicit PatternIndex(const std::vector<PatternData*> &patterns);
+
+        // Index over plain colored regions, e.g. search results. Where regions overlap, the one that comes first wins
+        explicit PatternIndex(const std::vector<std::pair<Region, u32>> &regions);
+
+        [[nodiscard]] std::optional<u32> getColor(u64 address) const;
+
+        [[nodiscard]] bool empty() const {
+            return this->m_segments.empty();
+        }
+
+    private:
+        constexpr static u32 NoTemplate = 0xFFFF'FFFF;
+
+        struct Segment {
+            u64 start, end;
+            u32 color;
+
+            // Set for ranges covered by a template array, addresses are looked up in the template's index relative to the array's start
+            u32 templateIndex;
+            u64 base, stride;
+        };
+
+        void addPattern(std::map<u64, Segment> &segments, PatternData *pattern, u64 origin, bool inTemplate);
+        static void addSegment(std::map<u64, Segment> &segments, const Segment &segment);
+
+        [[nodiscard]] const Segment* findSegment(u64 address) const;
+
+        std::vector<Segment> m_segments;
+        std::vector<PatternIndex> m_templates;
+
+        // Highlighting queries addresses in ascending order, so the next lookup usually hits the segment found last
+        mutable size_t m_lastSegment = 0;
+    };
+
+}
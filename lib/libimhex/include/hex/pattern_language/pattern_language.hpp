@@ -3,12 +3,14 @@
 #include <hex.hpp>
 
 #include <bit>
+#include <functional>
 #include <map>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include <hex/helpers/patches.hpp>
 #include <hex/pattern_language/log_console.hpp>
 #include <hex/pattern_language/token.hpp>
 
@@ -20,6 +22,7 @@ namespace hex::pl {
     class Lexer;
     class Parser;
     class Validator;
+    class Resolver;
     class Evaluator;
     class PatternData;
 
@@ -34,12 +37,20 @@ namespace hex::pl {
         std::optional<std::vector<ASTNode*>> parseString(const std::string &code);
         [[nodiscard]]
         std::optional<std::vector<PatternData*>> executeString(prv::Provider *provider, const std::string &string, const std::map<std::string, Token::Literal> &envVars = { }, const std::map<std::string, Token::Literal> &inVariables = { });
+        /*
+         * Runs the same code again after the provider's data changed. The patterns returned by the previous run have to be handed back and
+         * must not be used anymore afterwards. They are either reused or destroyed depending on what data the code read before.
+         */
+        [[nodiscard]]
+        std::optional<std::vector<PatternData*>> reexecuteString(prv::Provider *provider, const std::string &string, const std::map<std::string, Token::Literal> &envVars = { }, const std::map<std::string, Token::Literal> &inVariables = { });
         [[nodiscard]]
         std::optional<std::vector<PatternData*>> executeFile(prv::Provider *provider, const fs::path &path, const std::map<std::string, Token::Literal> &envVars = { }, const std::map<std::string, Token::Literal> &inVariables = { });
         [[nodiscard]]
         const std::vector<ASTNode*>& getCurrentAST() const;
 
         void abort();
+        void resetAbort();
+        void setBusy(bool busy);
 
         [[nodiscard]]
         const std::vector<std::pair<LogConsole::Level, std::string>>& getConsoleLog();
@@ -57,14 +68,33 @@ namespace hex::pl {
         bool hasDangerousFunctionBeenCalled() const;
         void allowDangerousFunctions(bool allow);
 
+        void setBytecodeEnabled(bool enabled);
+        void setPartialResultCallback(const std::function<void(const std::vector<PatternData*>&)> &callback);
+
     private:
         Preprocessor *m_preprocessor;
         Lexer *m_lexer;
         Parser *m_parser;
         Validator *m_validator;
+        Resolver *m_resolver;
         Evaluator *m_evaluator;
 
         std::vector<ASTNode*> m_currAST;
+        size_t m_currCodeHash = 0;
+        std::string m_currCode;
+
+        // Everything the result of the last successful run depended on besides the data it read
+        struct LastRun {
+            prv::Provider *provider;
+            u64 dataRevision;
+            size_t size;
+            u64 baseAddress;
+            Patches patches;
+
+            std::map<std::string, Token::Literal> envVars;
+            std::map<std::string, Token::Literal> inVariables;
+        };
+        std::optional<LastRun> m_lastRun;
 
         std::optional<std::pair<u32, std::string>> m_currError;
     };
@@ -17,6 +17,9 @@ namespace hex::pl {
 
         std::optional<std::string> preprocess(const std::string& code, bool initialRun = true);
 
+        // Runs the handlers of all pragmas found by the last preprocess() call again
+        bool applyPragmas();
+
         void addPragmaHandler(const std::string &pragmaType, const std::function<bool(const std::string&)> &function);
         void addDefaultPragmaHandlers();
 
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace hex::pl {
+
+    class ASTNode;
+
+    /*
+     * Binds identifiers used inside of function bodies to the slot their variable will occupy in the function's
+     * scope, so the evaluator can access them by index instead of searching all variables by name.
+     * Identifiers that don't refer to a local variable of the function are left unresolved and still get looked up by name.
+     */
+    class Resolver {
+    public:
+        Resolver() = default;
+
+        void resolve(const std::vector<ASTNode*> &ast);
+
+    private:
+        // Names of the variables in the scope of the current function, in the order they get created in
+        std::vector<std::string> m_variables;
+
+        void resolveNode(ASTNode *node);
+        void resolveBlock(const std::vector<ASTNode*> &statements);
+
+        [[nodiscard]] std::optional<u32> findVariable(const std::string &name) const;
+    };
+
+}
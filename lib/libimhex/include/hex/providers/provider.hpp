@@ -2,19 +2,29 @@
 
 #include <hex.hpp>
 
+#include <atomic>
+#include <functional>
 #include <map>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
+#include <hex/helpers/patches.hpp>
 #include <hex/helpers/shared_data.hpp>
 #include <hex/providers/overlay.hpp>
+#include <hex/providers/read_cache.hpp>
 
 namespace hex::prv {
 
     class Provider {
     public:
         constexpr static size_t PageSize = 0x1000'0000;
+        constexpr static size_t DefaultCachePageSize  = 0x1000;
+        constexpr static size_t DefaultCachePageCount = 0x100;
+        constexpr static size_t DefaultChunkSize      = 0x10'0000;
+
+        using ChunkCallback = std::function<void(u64 address, std::span<const u8> data)>;
 
         Provider();
         virtual ~Provider();
@@ -38,10 +48,22 @@ namespace hex::prv {
         virtual void writeRaw(u64 offset, const void *buffer, size_t size) = 0;
         [[nodiscard]] virtual size_t getActualSize() const  = 0;
 
+        /*
+         * Returns a view directly into the backing storage if the backend keeps its data in memory.
+         * The offset is a raw offset like in readRaw, patches and overlays are not part of the view.
+         * The view stays valid until the provider gets written to, resized or closed.
+         */
+        [[nodiscard]] virtual std::optional<std::span<const u8>> getRawSpan(u64 offset, size_t size) const;
+
+        void readChunks(u64 offset, size_t size, const ChunkCallback &callback, size_t chunkSize = DefaultChunkSize, bool overlays = true);
+        [[nodiscard]] bool isModified(u64 offset, size_t size, bool overlays = true) const;
+
         void applyOverlays(u64 offset, void *buffer, size_t size);
 
-        [[nodiscard]] std::map<u64, u8>& getPatches();
-        [[nodiscard]] const std::map<u64, u8>& getPatches() const;
+        [[nodiscard]] const ReadCache& getReadCache() const;
+
+        [[nodiscard]] Patches& getPatches();
+        [[nodiscard]] const Patches& getPatches() const;
         void applyPatches();
 
         [[nodiscard]] Overlay* newOverlay();
@@ -72,6 +94,17 @@ namespace hex::prv {
 
         [[nodiscard]] bool canUndo() const;
         [[nodiscard]] bool canRedo() const;
+        [[nodiscard]] size_t getUndoStepCount() const;
+        [[nodiscard]] size_t getUndoHistorySize() const;
+
+        /*
+         * Changes every time the data seen through read() might have changed. Revisions are unique across
+         * all providers so cached results can be keyed on them.
+         */
+        [[nodiscard]] u64 getRevision() const;
+
+        // Only changes when the underlying data itself changes, not when patches or overlays do
+        [[nodiscard]] u64 getDataRevision() const;
 
         [[nodiscard]] virtual bool hasLoadInterface() const;
         [[nodiscard]] virtual bool hasInterface() const;
@@ -79,12 +112,38 @@ namespace hex::prv {
         virtual void drawInterface();
 
     protected:
+        friend class Overlay;
+
+        void readCached(u64 offset, void *buffer, size_t size);
+        void clearUndoHistory();
+        void updateRevision(bool dataChanged = false);
+
         u32 m_currPage = 0;
         u64 m_baseAddress = 0;
 
-        u32 m_patchTreeOffset = 0;
-        std::list<std::map<u64, u8>> m_patches;
+        Patches m_patches;
+
+        /*
+         * Every undo step only stores the bytes it wrote and the patches it replaced,
+         * the current state of all patches is always available directly through m_patches
+         */
+        struct PatchDelta {
+            u64 address;
+            std::vector<u8> data;
+            Patches previous;
+        };
+
+        std::vector<std::vector<PatchDelta>> m_undoHistory;
+        size_t m_undoPosition = 0;
+        size_t m_undoHistorySize = 0;
+        bool m_undoGroupOpen = false;
+
         std::list<Overlay*> m_overlays;
+
+        ReadCache m_readCache = ReadCache(DefaultCachePageSize, DefaultCachePageCount);
+
+        std::atomic<u64> m_revision = 0;
+        std::atomic<u64> m_dataRevision = 0;
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <hex.hpp>
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace hex::prv {
+
+    /*
+     * Size-bounded LRU cache of page-aligned blocks of raw provider data.
+     * Small reads of slow providers get served from memory and only whole pages ever get requested from the backend.
+     */
+    class ReadCache {
+    public:
+        using ReadFunction = std::function<void(u64 offset, void *buffer, size_t size)>;
+
+        ReadCache(size_t pageSize, size_t pageCount) : m_pageSize(pageSize), m_pageCount(pageCount) { }
+
+        void read(u64 offset, void *buffer, size_t size, const ReadFunction &readFunction);
+
+        void invalidate();
+        void invalidate(u64 offset, size_t size);
+
+        void setPageSize(size_t pageSize);
+        void setPageCount(size_t pageCount);
+        [[nodiscard]] size_t getPageSize() const { return this->m_pageSize; }
+        [[nodiscard]] size_t getPageCount() const { return this->m_pageCount; }
+
+        // Number of pages fetched together with a missed page when the misses before it were sequential
+        void setReadAhead(size_t pageCount) { this->m_readAhead = pageCount; }
+        [[nodiscard]] size_t getReadAhead() const { return this->m_readAhead; }
+        [[nodiscard]] bool isEnabled() const { return this->m_pageSize > 0 && this->m_pageCount > 0; }
+
+        [[nodiscard]] u64 getHitCount() const { return this->m_hits; }
+        [[nodiscard]] u64 getMissCount() const { return this->m_misses; }
+
+    private:
+        struct Page {
+            u64 address;
+            std::vector<u8> data;
+        };
+
+        const Page& getPage(u64 address, const ReadFunction &readFunction);
+        Page& insertPage(u64 address);
+
+        size_t m_pageSize, m_pageCount;
+        size_t m_readAhead = 0;
+        std::optional<u64> m_lastMissAddress;
+
+        std::list<Page> m_pages;
+        std::unordered_map<u64, std::list<Page>::iterator> m_pageLookup;
+        std::mutex m_mutex;
+
+        std::atomic<u64> m_hits = 0, m_misses = 0;
+    };
+
+}
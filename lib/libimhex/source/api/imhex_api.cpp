@@ -69,6 +69,8 @@ namespace hex {
     }
 
     void ImHexApi::Provider::remove(prv::Provider *provider) {
+        EventManager::post<EventProviderDeleted>(provider);
+
         auto &providers = SharedData::providers;
 
         auto it = std::find(providers.begin(), providers.end(), provider);
@@ -40,4 +40,14 @@ namespace hex {
         return this->m_name;
     }
 
+    void Task::setStatus(const std::string &status) {
+        std::scoped_lock lock(SharedData::tasksMutex);
+
+        this->m_status = status;
+    }
+
+    const std::string& Task::getStatus() const {
+        return this->m_status;
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,518 @@
+#include <hex/helpers/binary_diff.hpp>
+
+#include <hex/providers/provider.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+
+namespace hex {
+
+    namespace {
+
+        using ReadFunction = std::function<void(u64 offset, u8 *buffer, size_t size)>;
+
+        struct Match {
+            u64 offsetA;
+            u64 offsetB;
+            u64 size;
+        };
+
+        constexpr auto GearTable = [] {
+            std::array<u64, 256> table = { };
+
+            // splitmix64, the values only need to be well distributed and identical everywhere
+            u64 state = 0;
+            for (auto &value : table) {
+                state += 0x9E37'79B9'7F4A'7C15;
+
+                u64 z = state;
+                z = (z ^ (z >> 30)) * 0xBF58'476D'1CE4'E5B9;
+                z = (z ^ (z >> 27)) * 0x94D0'49BB'1331'11EB;
+                value = z ^ (z >> 31);
+            }
+
+            return table;
+        }();
+
+        constexpr u64 FnvOffsetBasis = 0xCBF2'9CE4'8422'2325;
+        constexpr u64 FnvPrime = 0x0000'0100'0000'01B3;
+
+        struct ChunkParameters {
+            u32 shift;
+            u64 minSize;
+            u64 maxSize;
+        };
+
+        struct Chunks {
+            std::vector<u64> hashes;
+
+            // One more entry than there are chunks, the last one is the end of the data
+            std::vector<u64> offsets;
+        };
+
+        ChunkParameters getChunkParameters(u64 size) {
+            u32 bits = BinaryDiff::MinAverageChunkSizeBits;
+            while (bits < BinaryDiff::MaxAverageChunkSizeBits && (size >> bits) > BinaryDiff::MaxChunkCount)
+                bits++;
+
+            return { 64 - bits, (1ULL << bits) / 4, (1ULL << bits) * 8 };
+        }
+
+        // Gear hash based content defined chunking. Every shift drops the oldest byte, so the top bits of the rolling hash only depend on the last 64 bytes
+        std::optional<Chunks> splitIntoChunks(const ReadFunction &read, u64 size, const ChunkParameters &parameters, std::atomic<u64> &processedSize, const std::stop_token &stopToken) {
+            Chunks chunks;
+            chunks.hashes.reserve(size / (parameters.minSize * 5) + 1);
+            chunks.offsets.reserve(size / (parameters.minSize * 5) + 2);
+            chunks.offsets.push_back(0);
+
+            std::vector<u8> buffer(std::min<u64>(BinaryDiff::ReadBlockSize, size));
+
+            u64 rollingHash = 0;
+            u64 chunkHash = FnvOffsetBasis;
+            u64 chunkStart = 0;
+
+            for (u64 blockOffset = 0; blockOffset < size; blockOffset += buffer.size()) {
+                if (stopToken.stop_requested())
+                    return std::nullopt;
+
+                const size_t blockSize = std::min<u64>(buffer.size(), size - blockOffset);
+                read(blockOffset, buffer.data(), blockSize);
+
+                for (size_t i = 0; i < blockSize; i++) {
+                    const u8 byte = buffer[i];
+
+                    rollingHash = (rollingHash << 1) + GearTable[byte];
+                    chunkHash = (chunkHash ^ byte) * FnvPrime;
+
+                    const u64 chunkSize = blockOffset + i + 1 - chunkStart;
+                    if ((chunkSize >= parameters.minSize && (rollingHash >> parameters.shift) == 0) || chunkSize >= parameters.maxSize) {
+                        chunks.hashes.push_back(chunkHash);
+                        chunks.offsets.push_back(chunkStart + chunkSize);
+
+                        chunkStart += chunkSize;
+                        chunkHash = FnvOffsetBasis;
+                    }
+                }
+
+                processedSize += blockSize;
+            }
+
+            if (chunkStart < size) {
+                chunks.hashes.push_back(chunkHash);
+                chunks.offsets.push_back(size);
+            }
+
+            return chunks;
+        }
+
+        // Myers' O((N+M)D) algorithm, gives up once more than maxDistance insertions and deletions would be needed
+        template<typename T>
+        bool alignMyers(std::span<const T> a, std::span<const T> b, u64 offsetA, u64 offsetB, std::vector<Match> &matches) {
+            const s64 n = a.size(), m = b.size();
+            const s64 maxDistance = std::min<s64>(BinaryDiff::MaxEditDistance, BinaryDiff::AlignmentBudget / (n + m));
+            if (maxDistance < std::abs(n - m))
+                return false;
+
+            // Furthest reaching x on every diagonal k = x - y, plus a copy of every round's values for backtracking.
+            // Round d stores the 2d + 1 diagonals -d to d, so it starts at d * d in the trace
+            const s64 center = maxDistance + 1;
+            std::vector<s64> furthest(2 * center + 1, 0);
+            std::vector<s64> trace;
+
+            const auto traced = [&trace](s64 d, s64 k) { return trace[d * d + k + d]; };
+
+            for (s64 d = 0; d <= maxDistance; d++) {
+                for (s64 k = -d; k <= d; k += 2) {
+                    s64 x;
+                    if (k == -d || (k != d && furthest[center + k - 1] < furthest[center + k + 1]))
+                        x = furthest[center + k + 1];
+                    else
+                        x = furthest[center + k - 1] + 1;
+
+                    s64 y = x - k;
+                    while (x < n && y < m && a[x] == b[y]) {
+                        x++;
+                        y++;
+                    }
+
+                    furthest[center + k] = x;
+
+                    if (x < n || y < m)
+                        continue;
+
+                    trace.insert(trace.end(), furthest.begin() + center - d, furthest.begin() + center + d + 1);
+
+                    // Walk back through the rounds and collect the diagonal runs between the edits
+                    std::vector<Match> found;
+                    for (s64 round = d; round > 0; round--) {
+                        const s64 diagonal = x - y;
+
+                        s64 previousDiagonal;
+                        if (diagonal == -round || (diagonal != round && traced(round - 1, diagonal - 1) < traced(round - 1, diagonal + 1)))
+                            previousDiagonal = diagonal + 1;
+                        else
+                            previousDiagonal = diagonal - 1;
+
+                        const s64 previousX = traced(round - 1, previousDiagonal);
+                        const s64 runStart = previousDiagonal == diagonal + 1 ? previousX : previousX + 1;
+
+                        if (x > runStart)
+                            found.push_back({ offsetA + runStart, offsetB + runStart - diagonal, u64(x - runStart) });
+
+                        x = previousX;
+                        y = previousX - previousDiagonal;
+                    }
+
+                    if (x > 0)
+                        found.push_back({ offsetA, offsetB, u64(x) });
+
+                    matches.insert(matches.end(), found.rbegin(), found.rend());
+                    return true;
+                }
+
+                trace.insert(trace.end(), furthest.begin() + center - d, furthest.begin() + center + d + 1);
+            }
+
+            return false;
+        }
+
+        template<typename T>
+        void alignSequences(std::span<const T> a, std::span<const T> b, u64 offsetA, u64 offsetB, u32 anchorDepth, std::vector<Match> &matches);
+
+        // Patience diff, elements that occur exactly once in both sequences are matched up in order and the ranges between them get aligned separately
+        void alignAnchors(std::span<const u64> a, std::span<const u64> b, u64 offsetA, u64 offsetB, u32 anchorDepth, std::vector<Match> &matches) {
+            std::vector<std::pair<size_t, size_t>> anchors;
+
+            {
+                struct Occurrence {
+                    u32 countA = 0, countB = 0;
+                    size_t indexA = 0, indexB = 0;
+                };
+
+                std::unordered_map<u64, Occurrence> occurrences;
+                occurrences.reserve(a.size());
+
+                for (size_t i = 0; i < a.size(); i++) {
+                    auto &occurrence = occurrences[a[i]];
+                    occurrence.countA++;
+                    occurrence.indexA = i;
+                }
+
+                for (size_t i = 0; i < b.size(); i++) {
+                    if (auto iter = occurrences.find(b[i]); iter != occurrences.end()) {
+                        iter->second.countB++;
+                        iter->second.indexB = i;
+                    }
+                }
+
+                std::vector<std::pair<size_t, size_t>> uniques;
+                for (size_t i = 0; i < a.size(); i++) {
+                    const auto &occurrence = occurrences[a[i]];
+                    if (occurrence.countA == 1 && occurrence.countB == 1)
+                        uniques.emplace_back(i, occurrence.indexB);
+                }
+
+                // Longest increasing subsequence of the positions in B
+                std::vector<size_t> tails, predecessors(uniques.size());
+                for (size_t i = 0; i < uniques.size(); i++) {
+                    auto iter = std::lower_bound(tails.begin(), tails.end(), uniques[i].second, [&](size_t index, size_t value) { return uniques[index].second < value; });
+
+                    predecessors[i] = iter == tails.begin() ? SIZE_MAX : *(iter - 1);
+                    if (iter == tails.end())
+                        tails.push_back(i);
+                    else
+                        *iter = i;
+                }
+
+                if (!tails.empty()) {
+                    for (size_t i = tails.back(); i != SIZE_MAX; i = predecessors[i])
+                        anchors.push_back(uniques[i]);
+
+                    std::reverse(anchors.begin(), anchors.end());
+                }
+            }
+
+            size_t previousA = 0, previousB = 0;
+            for (const auto &[indexA, indexB] : anchors) {
+                alignSequences(a.subspan(previousA, indexA - previousA), b.subspan(previousB, indexB - previousB), offsetA + previousA, offsetB + previousB, anchorDepth + 1, matches);
+                matches.push_back({ offsetA + indexA, offsetB + indexB, 1 });
+
+                previousA = indexA + 1;
+                previousB = indexB + 1;
+            }
+
+            if (!anchors.empty())
+                alignSequences(a.subspan(previousA), b.subspan(previousB), offsetA + previousA, offsetB + previousB, anchorDepth + 1, matches);
+        }
+
+        template<typename T>
+        void alignSequences(std::span<const T> a, std::span<const T> b, u64 offsetA, u64 offsetB, u32 anchorDepth, std::vector<Match> &matches) {
+            const size_t prefix = std::mismatch(a.begin(), a.end(), b.begin(), b.end()).first - a.begin();
+            if (prefix > 0)
+                matches.push_back({ offsetA, offsetB, prefix });
+
+            a = a.subspan(prefix);
+            b = b.subspan(prefix);
+            offsetA += prefix;
+            offsetB += prefix;
+
+            const size_t suffix = std::mismatch(a.rbegin(), a.rend(), b.rbegin(), b.rend()).first - a.rbegin();
+            a = a.first(a.size() - suffix);
+            b = b.first(b.size() - suffix);
+
+            if (!a.empty() && !b.empty()) {
+                if (!alignMyers(a, b, offsetA, offsetB, matches)) {
+                    // Bytes repeat far too often to be used as anchors
+                    if constexpr (std::same_as<T, u64>) {
+                        if (anchorDepth < BinaryDiff::MaxAnchorDepth)
+                            alignAnchors(a, b, offsetA, offsetB, anchorDepth, matches);
+                    }
+                }
+            }
+
+            if (suffix > 0)
+                matches.push_back({ offsetA + a.size(), offsetB + b.size(), suffix });
+        }
+
+        void alignBytes(const ReadFunction &readA, u64 offsetA, u64 sizeA, const ReadFunction &readB, u64 offsetB, u64 sizeB, std::vector<Match> &matches) {
+            if (sizeA == 0 || sizeB == 0 || sizeA > BinaryDiff::MaxByteAlignmentSize || sizeB > BinaryDiff::MaxByteAlignmentSize)
+                return;
+
+            std::vector<u8> bytesA(sizeA), bytesB(sizeB);
+            readA(offsetA, bytesA.data(), bytesA.size());
+            readB(offsetB, bytesB.data(), bytesB.size());
+
+            alignSequences<u8>(bytesA, bytesB, offsetA, offsetB, 0, matches);
+        }
+
+        // Compares eight bytes at a time, the first set bit of the difference of two words belongs to the first differing byte
+        size_t findNextDifference(const u8 *a, const u8 *b, size_t offset, size_t size) {
+            for (; offset + sizeof(u64) <= size; offset += sizeof(u64)) {
+                u64 wordA, wordB;
+                std::memcpy(&wordA, a + offset, sizeof(u64));
+                std::memcpy(&wordB, b + offset, sizeof(u64));
+
+                if (const u64 difference = wordA ^ wordB; difference != 0) {
+                    if constexpr (std::endian::native == std::endian::little)
+                        return offset + std::countr_zero(difference) / 8;
+                    else
+                        return offset + std::countl_zero(difference) / 8;
+                }
+            }
+
+            for (; offset < size; offset++) {
+                if (a[offset] != b[offset])
+                    return offset;
+            }
+
+            return size;
+        }
+
+        std::vector<BinaryDiff::Edit> createEditScript(const std::vector<Match> &matches, u64 sizeA, u64 sizeB) {
+            using Type = BinaryDiff::EditType;
+
+            std::vector<BinaryDiff::Edit> edits;
+
+            const auto addDifference = [&edits](u64 offsetA, u64 sizeA, u64 offsetB, u64 sizeB) {
+                if (sizeA == 0 && sizeB == 0)
+                    return;
+
+                const auto type = sizeA == 0 ? Type::Insert : sizeB == 0 ? Type::Delete : Type::Replace;
+                edits.push_back({ type, offsetA, sizeA, offsetB, sizeB });
+            };
+
+            u64 endA = 0, endB = 0;
+            for (const auto &match : matches) {
+                if (match.size == 0)
+                    continue;
+
+                addDifference(endA, match.offsetA - endA, endB, match.offsetB - endB);
+
+                if (!edits.empty() && edits.back().type == Type::Equal && match.offsetA == endA && match.offsetB == endB) {
+                    edits.back().sizeA += match.size;
+                    edits.back().sizeB += match.size;
+                } else {
+                    edits.push_back({ Type::Equal, match.offsetA, match.size, match.offsetB, match.size });
+                }
+
+                endA = match.offsetA + match.size;
+                endB = match.offsetB + match.size;
+            }
+
+            addDifference(endA, sizeA - endA, endB, sizeB - endB);
+
+            return edits;
+        }
+
+    }
+
+    std::optional<std::vector<BinaryDiff::Edit>> BinaryDiff::diff(const ReadFunction &readA, u64 sizeA, const ReadFunction &readB, u64 sizeB, bool parallel, const ProgressCallback &progress, const std::stop_token &stopToken) {
+        const auto parameters = getChunkParameters(std::max(sizeA, sizeB));
+
+        std::atomic<u64> processedSizeA = 0, processedSizeB = 0;
+        std::optional<Chunks> chunksA, chunksB;
+
+        {
+            std::jthread chunkThread;
+            if (parallel) {
+                chunkThread = std::jthread([&] {
+                    chunksB = splitIntoChunks(readB, sizeB, parameters, processedSizeB, stopToken);
+                });
+            }
+
+            // Report the progress of both inputs from the calling thread only
+            const auto reportingRead = [&](u64 offset, u8 *buffer, size_t size) {
+                readA(offset, buffer, size);
+
+                if (progress)
+                    progress(processedSizeA + processedSizeB);
+            };
+
+            chunksA = splitIntoChunks(reportingRead, sizeA, parameters, processedSizeA, stopToken);
+
+            if (!parallel)
+                chunksB = splitIntoChunks(readB, sizeB, parameters, processedSizeB, stopToken);
+        }
+
+        if (!chunksA.has_value() || !chunksB.has_value())
+            return std::nullopt;
+
+        std::vector<Match> chunkMatches;
+        alignSequences<u64>(chunksA->hashes, chunksB->hashes, 0, 0, 0, chunkMatches);
+
+        // Refine everything between the matching chunks byte by byte
+        std::vector<Match> matches;
+        u64 endA = 0, endB = 0;
+
+        const auto alignGap = [&](u64 offsetA, u64 offsetB) {
+            alignBytes(readA, endA, offsetA - endA, readB, endB, offsetB - endB, matches);
+        };
+
+        for (const auto &chunkMatch : chunkMatches) {
+            if (stopToken.stop_requested())
+                return std::nullopt;
+
+            const u64 offsetA = chunksA->offsets[chunkMatch.offsetA], offsetB = chunksB->offsets[chunkMatch.offsetB];
+            const u64 size = chunksA->offsets[chunkMatch.offsetA + chunkMatch.size] - offsetA;
+
+            // Only possible if two different chunks have the same hash
+            if (chunksB->offsets[chunkMatch.offsetB + chunkMatch.size] - offsetB != size)
+                continue;
+
+            alignGap(offsetA, offsetB);
+            matches.push_back({ offsetA, offsetB, size });
+
+            endA = offsetA + size;
+            endB = offsetB + size;
+        }
+
+        alignGap(sizeA, sizeB);
+
+        if (progress)
+            progress(sizeA + sizeB);
+
+        return createEditScript(matches, sizeA, sizeB);
+    }
+
+    std::optional<std::vector<BinaryDiff::Edit>> BinaryDiff::diff(prv::Provider *providerA, prv::Provider *providerB, const ProgressCallback &progress, const std::stop_token &stopToken) {
+        const auto readA = [providerA](u64 offset, u8 *buffer, size_t size) {
+            providerA->read(providerA->getBaseAddress() + offset, buffer, size);
+        };
+        const auto readB = [providerB](u64 offset, u8 *buffer, size_t size) {
+            providerB->read(providerB->getBaseAddress() + offset, buffer, size);
+        };
+
+        return diff(readA, providerA->getSize(), readB, providerB->getSize(), providerA != providerB, progress, stopToken);
+    }
+
+    std::vector<BinaryDiff::Edit> BinaryDiff::diff(std::span<const u8> a, std::span<const u8> b) {
+        const auto readA = [a](u64 offset, u8 *buffer, size_t size) {
+            std::copy_n(a.begin() + offset, size, buffer);
+        };
+        const auto readB = [b](u64 offset, u8 *buffer, size_t size) {
+            std::copy_n(b.begin() + offset, size, buffer);
+        };
+
+        return diff(readA, a.size(), readB, b.size(), false, { }, { }).value();
+    }
+
+    std::optional<std::vector<BinaryDiff::Edit>> BinaryDiff::compare(const ReadFunction &readA, u64 sizeA, const ReadFunction &readB, u64 sizeB, const ProgressCallback &progress, const std::stop_token &stopToken) {
+        const u64 commonSize = std::min(sizeA, sizeB);
+        const u64 mergeDistance = std::max<u64>(MinMergeDistance, commonSize / MaxDifferenceCount);
+
+        // Only the equal ranges between the differing runs are collected, createEditScript() fills in the rest
+        std::vector<Match> matches;
+        std::optional<std::pair<u64, u64>> run;
+        u64 equalStart = 0;
+
+        const auto finishRun = [&] {
+            matches.push_back({ equalStart, equalStart, run->first - equalStart });
+            equalStart = run->second;
+        };
+
+        std::vector<u8> bufferA(std::min<u64>(ReadBlockSize, commonSize)), bufferB(bufferA.size());
+        for (u64 blockOffset = 0; blockOffset < commonSize; blockOffset += bufferA.size()) {
+            if (stopToken.stop_requested())
+                return std::nullopt;
+
+            const size_t blockSize = std::min<u64>(bufferA.size(), commonSize - blockOffset);
+            readA(blockOffset, bufferA.data(), blockSize);
+            readB(blockOffset, bufferB.data(), blockSize);
+
+            // Most blocks are usually identical, memcmp is vectorized by every standard library
+            if (std::memcmp(bufferA.data(), bufferB.data(), blockSize) != 0) {
+                for (size_t offset = findNextDifference(bufferA.data(), bufferB.data(), 0, blockSize); offset < blockSize; offset = findNextDifference(bufferA.data(), bufferB.data(), offset + 1, blockSize)) {
+                    const u64 address = blockOffset + offset;
+
+                    if (run.has_value() && address - run->second < mergeDistance) {
+                        run->second = address + 1;
+                    } else {
+                        if (run.has_value())
+                            finishRun();
+
+                        run = { address, address + 1 };
+                    }
+                }
+            }
+
+            if (progress)
+                progress((blockOffset + blockSize) * 2);
+        }
+
+        if (run.has_value())
+            finishRun();
+
+        matches.push_back({ equalStart, equalStart, commonSize - equalStart });
+
+        return createEditScript(matches, sizeA, sizeB);
+    }
+
+    std::optional<std::vector<BinaryDiff::Edit>> BinaryDiff::compare(prv::Provider *providerA, prv::Provider *providerB, const ProgressCallback &progress, const std::stop_token &stopToken) {
+        const auto readA = [providerA](u64 offset, u8 *buffer, size_t size) {
+            providerA->read(providerA->getBaseAddress() + offset, buffer, size);
+        };
+        const auto readB = [providerB](u64 offset, u8 *buffer, size_t size) {
+            providerB->read(providerB->getBaseAddress() + offset, buffer, size);
+        };
+
+        return compare(readA, providerA->getSize(), readB, providerB->getSize(), progress, stopToken);
+    }
+
+    std::vector<BinaryDiff::Edit> BinaryDiff::compare(std::span<const u8> a, std::span<const u8> b) {
+        const auto readA = [a](u64 offset, u8 *buffer, size_t size) {
+            std::copy_n(a.begin() + offset, size, buffer);
+        };
+        const auto readB = [b](u64 offset, u8 *buffer, size_t size) {
+            std::copy_n(b.begin() + offset, size, buffer);
+        };
+
+        return compare(readA, a.size(), readB, b.size(), { }, { }).value();
+    }
+
+}
@@ -0,0 +1,275 @@
+#include <hex/helpers/byte_analysis.hpp>
+
+#include <hex/providers/provider.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace hex {
+
+    namespace {
+
+        constexpr static size_t CachedResultCount = 4;
+
+        std::mutex s_cacheMutex;
+        std::list<std::pair<prv::Provider*, std::shared_ptr<const ByteAnalyzer::Result>>> s_cachedResults;
+
+        // Every bank only sees a quarter of the bytes, so its 32 bit counters can't overflow for this many bytes
+        constexpr static size_t MaxBankedSize = 0x1'0000'0000;
+
+        // Below this size, merging the banks costs more than it saves
+        constexpr static size_t MinBankedSize = 0x1000;
+
+        void cacheResult(prv::Provider *provider, const std::shared_ptr<const ByteAnalyzer::Result> &result) {
+            std::scoped_lock lock(s_cacheMutex);
+
+            std::erase_if(s_cachedResults, [provider](const auto &entry) { return entry.first == provider; });
+            s_cachedResults.emplace_front(provider, result);
+            if (s_cachedResults.size() > CachedResultCount)
+                s_cachedResults.pop_back();
+        }
+
+        // FNV-1a, only used to notice when a patch or overlay kept its place but got different contents
+        u64 hashBytes(std::span<const u8> data) {
+            u64 hash = 0xCBF2'9CE4'8422'2325;
+            for (u8 byte : data) {
+                hash ^= byte;
+                hash *= 0x100'0000'01B3;
+            }
+
+            return hash;
+        }
+
+        std::vector<ByteAnalyzer::ModifiedRegion> getModifiedRegions(prv::Provider *provider) {
+            std::vector<ByteAnalyzer::ModifiedRegion> regions;
+
+            for (const auto &[address, data] : provider->getPatches())
+                regions.push_back({ address, data.size(), hashBytes(data) });
+            for (const auto &overlay : provider->getOverlays())
+                regions.push_back({ overlay->getAddress(), overlay->getSize(), hashBytes(overlay->getData()) });
+
+            std::sort(regions.begin(), regions.end());
+
+            return regions;
+        }
+
+    }
+
+    ByteStatistics ByteStatistics::fromHistogram(const ByteHistogram &histogram) {
+        ByteStatistics result;
+
+        u64 sum = 0, printable = 0, highBit = 0;
+        for (u16 value = 0; value < 256; value++) {
+            const u64 count = histogram[value];
+
+            result.size += count;
+            sum += count * value;
+
+            if (value >= 0x20 && value <= 0x7E)
+                printable += count;
+            if (value >= 0x80)
+                highBit += count;
+        }
+
+        if (result.size == 0)
+            return result;
+
+        const double size = result.size;
+        const double expected = size / 256;
+        for (u64 count : histogram) {
+            if (count != 0) {
+                const double probability = count / size;
+                result.entropy -= probability * std::log2(probability);
+            }
+
+            result.chiSquare += (count - expected) * (count - expected) / expected;
+        }
+
+        result.entropy       /= 8; // log2(256) = 8
+        result.mean           = sum / size;
+        result.printableRatio = printable / size;
+        result.zeroRatio      = histogram[0x00] / size;
+        result.highBitRatio   = highBit / size;
+
+        return result;
+    }
+
+    void ByteAnalyzer::countBytes(std::span<const u8> data, ByteHistogram &histogram) {
+        if (data.size() < MinBankedSize) {
+            for (u8 byte : data)
+                histogram[byte]++;
+
+            return;
+        }
+
+        // Spreading neighbouring bytes over multiple tables avoids waiting on the previous increment when the same value repeats
+        std::array<std::array<u32, 256>, 4> banks;
+
+        for (size_t offset = 0; offset < data.size(); offset += MaxBankedSize) {
+            const u8 *bytes = data.data() + offset;
+            const size_t size = std::min(MaxBankedSize, data.size() - offset);
+
+            for (auto &bank : banks)
+                bank.fill(0);
+
+            size_t i = 0;
+            for (; i + sizeof(u64) <= size; i += sizeof(u64)) {
+                u64 value;
+                std::memcpy(&value, bytes + i, sizeof(value));
+
+                banks[0][(value >>  0) & 0xFF]++;
+                banks[1][(value >>  8) & 0xFF]++;
+                banks[2][(value >> 16) & 0xFF]++;
+                banks[3][(value >> 24) & 0xFF]++;
+                banks[0][(value >> 32) & 0xFF]++;
+                banks[1][(value >> 40) & 0xFF]++;
+                banks[2][(value >> 48) & 0xFF]++;
+                banks[3][(value >> 56) & 0xFF]++;
+            }
+
+            for (; i < size; i++)
+                banks[0][bytes[i]]++;
+
+            for (u16 value = 0; value < 256; value++)
+                histogram[value] += u64(banks[0][value]) + banks[1][value] + banks[2][value] + banks[3][value];
+        }
+    }
+
+    std::shared_ptr<const ByteAnalyzer::Result> ByteAnalyzer::getCachedResult(prv::Provider *provider, u64 address, size_t size, size_t blockSize) {
+        std::scoped_lock lock(s_cacheMutex);
+
+        for (const auto &[cachedProvider, result] : s_cachedResults) {
+            if (cachedProvider == provider && result->revision == provider->getRevision() && result->address == address && result->size == size && result->blockSize == blockSize)
+                return result;
+        }
+
+        return nullptr;
+    }
+
+    std::shared_ptr<const ByteAnalyzer::Result> ByteAnalyzer::analyze(prv::Provider *provider, u64 address, size_t size, size_t blockSize, const ProgressCallback &progress, u32 threadCount) {
+        if (auto cachedResult = getCachedResult(provider, address, size, blockSize); cachedResult != nullptr)
+            return cachedResult;
+
+        auto result = std::make_shared<Result>();
+        result->address         = address;
+        result->size            = size;
+        result->blockSize       = blockSize;
+        result->revision        = provider->getRevision();
+        result->dataRevision    = provider->getDataRevision();
+        result->modifiedRegions = getModifiedRegions(provider);
+
+        const size_t blockCount = (size + blockSize - 1) / blockSize;
+        result->blockHistograms.resize(blockCount, { 0 });
+        result->blockStatistics.resize(blockCount);
+
+        const size_t blocksPerBatch = std::max<size_t>(BatchSize / blockSize, 1);
+        const size_t batchCount = (blockCount + blocksPerBatch - 1) / blocksPerBatch;
+
+        // Backends that can't hand out their data directly usually don't support being read from multiple threads either
+        if (threadCount == 0)
+            threadCount = provider->getRawSpan(0, 1).has_value() ? std::max(std::thread::hardware_concurrency(), 1U) : 1;
+        threadCount = std::min<size_t>(threadCount, batchCount);
+
+        std::atomic<size_t> nextBatch = 0;
+        std::atomic<u64> processedSize = 0;
+
+        auto analyzeBatches = [&](bool reportProgress) {
+            for (size_t batch = nextBatch++; batch < batchCount; batch = nextBatch++) {
+                const u64 batchOffset = batch * blocksPerBatch * blockSize;
+                const size_t batchSize = std::min<u64>(blocksPerBatch * blockSize, size - batchOffset);
+
+                provider->readChunks(address + batchOffset, batchSize, [&](u64 blockAddress, std::span<const u8> data) {
+                    const size_t block = (blockAddress - address) / blockSize;
+
+                    countBytes(data, result->blockHistograms[block]);
+                    result->blockStatistics[block] = ByteStatistics::fromHistogram(result->blockHistograms[block]);
+                }, blockSize);
+
+                processedSize += batchSize;
+                if (reportProgress && progress)
+                    progress(processedSize);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (u32 i = 1; i < threadCount; i++)
+            workers.emplace_back(analyzeBatches, false);
+
+        analyzeBatches(true);
+
+        for (auto &worker : workers)
+            worker.join();
+
+        for (const auto &blockHistogram : result->blockHistograms) {
+            for (u16 value = 0; value < 256; value++)
+                result->histogram[value] += blockHistogram[value];
+        }
+        result->statistics = ByteStatistics::fromHistogram(result->histogram);
+
+        cacheResult(provider, result);
+
+        return result;
+    }
+
+    std::shared_ptr<const ByteAnalyzer::Result> ByteAnalyzer::update(prv::Provider *provider, const std::shared_ptr<const Result> &previous) {
+        if (previous->revision == provider->getRevision())
+            return previous;
+
+        if (previous->dataRevision != provider->getDataRevision())
+            return analyze(provider, previous->address, previous->size, previous->blockSize);
+
+        auto result = std::make_shared<Result>(*previous);
+        result->revision        = provider->getRevision();
+        result->modifiedRegions = getModifiedRegions(provider);
+
+        // Only blocks with patches or overlays that were added, removed or changed can be different now
+        std::vector<ModifiedRegion> changedRegions;
+        std::set_symmetric_difference(previous->modifiedRegions.begin(), previous->modifiedRegions.end(), result->modifiedRegions.begin(), result->modifiedRegions.end(), std::back_inserter(changedRegions));
+
+        const u64 endAddress = result->address + result->size;
+        std::vector<bool> changedBlocks(result->blockHistograms.size(), false);
+        for (const auto &[address, size, hash] : changedRegions) {
+            if (size == 0 || address + size <= result->address || address >= endAddress)
+                continue;
+
+            const size_t firstBlock = (std::max(address, result->address) - result->address) / result->blockSize;
+            const size_t lastBlock  = (std::min(address + size, endAddress) - 1 - result->address) / result->blockSize;
+            std::fill(changedBlocks.begin() + firstBlock, changedBlocks.begin() + lastBlock + 1, true);
+        }
+
+        for (size_t block = 0; block < changedBlocks.size(); block++) {
+            if (!changedBlocks[block])
+                continue;
+
+            auto &blockHistogram = result->blockHistograms[block];
+            for (u16 value = 0; value < 256; value++)
+                result->histogram[value] -= blockHistogram[value];
+
+            const u64 blockAddress = result->address + block * result->blockSize;
+            const size_t blockSize = std::min<u64>(result->blockSize, endAddress - blockAddress);
+
+            blockHistogram.fill(0);
+            provider->readChunks(blockAddress, blockSize, [&](u64, std::span<const u8> data) {
+                countBytes(data, blockHistogram);
+            }, blockSize);
+
+            for (u16 value = 0; value < 256; value++)
+                result->histogram[value] += blockHistogram[value];
+
+            result->blockStatistics[block] = ByteStatistics::fromHistogram(blockHistogram);
+        }
+
+        result->statistics = ByteStatistics::fromHistogram(result->histogram);
+
+        cacheResult(provider, result);
+
+        return result;
+    }
+
+}
@@ -16,10 +16,14 @@
 #include <array>
 #include <span>
 #include <concepts>
+#include <condition_variable>
 #include <functional>
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 #if MBEDTLS_VERSION_MAJOR <= 2
 
@@ -44,15 +48,12 @@
 namespace hex::crypt {
     using namespace std::placeholders;
 
-    template<std::invocable<unsigned char*, size_t> Func>
+    template<std::invocable<const unsigned char*, size_t> Func>
     void processDataByChunks(prv::Provider* data, u64 offset, size_t size, Func func)
     {
-        std::array<u8, 512> buffer = { 0 };
-        for (size_t bufferOffset = 0; bufferOffset < size; bufferOffset += buffer.size()) {
-            const auto readSize = std::min(buffer.size(), size - bufferOffset);
-            data->read(offset + bufferOffset, buffer.data(), readSize);
-            func(buffer.data(), readSize);
-        }
+        data->readChunks(offset, size, [&](u64, std::span<const u8> chunk) {
+            func(chunk.data(), chunk.size());
+        });
     }
 
     template<typename T>
@@ -371,6 +372,269 @@ namespace hex::crypt {
     }
 
 
+    namespace {
+
+        class HashContext {
+        public:
+            virtual ~HashContext() = default;
+
+            virtual void update(std::span<const u8> data) = 0;
+            [[nodiscard]] virtual std::vector<u8> finish() = 0;
+        };
+
+        class CrcContext : public HashContext {
+        public:
+            CrcContext(int bits, const CrcParameters &parameters)
+                : m_bits(bits), m_crc(bits, parameters.polynomial, parameters.init, parameters.xorout, parameters.reflectIn, parameters.reflectOut) { }
+
+            void update(std::span<const u8> data) override {
+                this->m_crc.processBytes(data.data(), data.size());
+            }
+
+            std::vector<u8> finish() override {
+                const auto checksum = this->m_crc.checksum();
+
+                std::vector<u8> result;
+                for (int shift = this->m_bits - 8; shift >= 0; shift -= 8)
+                    result.push_back(checksum >> shift);
+
+                return result;
+            }
+
+        private:
+            int m_bits;
+            Crc m_crc;
+        };
+
+        class Md5Context : public HashContext {
+        public:
+            Md5Context() {
+                mbedtls_md5_init(&this->m_ctx);
+                mbedtls_md5_starts(&this->m_ctx);
+            }
+
+            ~Md5Context() override {
+                mbedtls_md5_free(&this->m_ctx);
+            }
+
+            void update(std::span<const u8> data) override {
+                mbedtls_md5_update(&this->m_ctx, data.data(), data.size());
+            }
+
+            std::vector<u8> finish() override {
+                std::vector<u8> result(16, 0x00);
+                mbedtls_md5_finish(&this->m_ctx, result.data());
+
+                return result;
+            }
+
+        private:
+            mbedtls_md5_context m_ctx;
+        };
+
+        class Sha1Context : public HashContext {
+        public:
+            Sha1Context() {
+                mbedtls_sha1_init(&this->m_ctx);
+                mbedtls_sha1_starts(&this->m_ctx);
+            }
+
+            ~Sha1Context() override {
+                mbedtls_sha1_free(&this->m_ctx);
+            }
+
+            void update(std::span<const u8> data) override {
+                mbedtls_sha1_update(&this->m_ctx, data.data(), data.size());
+            }
+
+            std::vector<u8> finish() override {
+                std::vector<u8> result(20, 0x00);
+                mbedtls_sha1_finish(&this->m_ctx, result.data());
+
+                return result;
+            }
+
+        private:
+            mbedtls_sha1_context m_ctx;
+        };
+
+        class Sha256Context : public HashContext {
+        public:
+            explicit Sha256Context(bool is224) : m_is224(is224) {
+                mbedtls_sha256_init(&this->m_ctx);
+                mbedtls_sha256_starts(&this->m_ctx, is224);
+            }
+
+            ~Sha256Context() override {
+                mbedtls_sha256_free(&this->m_ctx);
+            }
+
+            void update(std::span<const u8> data) override {
+                mbedtls_sha256_update(&this->m_ctx, data.data(), data.size());
+            }
+
+            std::vector<u8> finish() override {
+                std::vector<u8> result(32, 0x00);
+                mbedtls_sha256_finish(&this->m_ctx, result.data());
+                result.resize(this->m_is224 ? 28 : 32);
+
+                return result;
+            }
+
+        private:
+            bool m_is224;
+            mbedtls_sha256_context m_ctx;
+        };
+
+        class Sha512Context : public HashContext {
+        public:
+            explicit Sha512Context(bool is384) : m_is384(is384) {
+                mbedtls_sha512_init(&this->m_ctx);
+                mbedtls_sha512_starts(&this->m_ctx, is384);
+            }
+
+            ~Sha512Context() override {
+                mbedtls_sha512_free(&this->m_ctx);
+            }
+
+            void update(std::span<const u8> data) override {
+                mbedtls_sha512_update(&this->m_ctx, data.data(), data.size());
+            }
+
+            std::vector<u8> finish() override {
+                std::vector<u8> result(64, 0x00);
+                mbedtls_sha512_finish(&this->m_ctx, result.data());
+                result.resize(this->m_is384 ? 48 : 64);
+
+                return result;
+            }
+
+        private:
+            bool m_is384;
+            mbedtls_sha512_context m_ctx;
+        };
+
+        std::unique_ptr<HashContext> createHashContext(const HashRequest &request) {
+            switch (request.function) {
+                case HashFunction::CRC8:    return std::make_unique<CrcContext>(8, request.crc);
+                case HashFunction::CRC16:   return std::make_unique<CrcContext>(16, request.crc);
+                case HashFunction::CRC32:   return std::make_unique<CrcContext>(32, request.crc);
+                case HashFunction::MD5:     return std::make_unique<Md5Context>();
+                case HashFunction::SHA1:    return std::make_unique<Sha1Context>();
+                case HashFunction::SHA224:  return std::make_unique<Sha256Context>(true);
+                case HashFunction::SHA256:  return std::make_unique<Sha256Context>(false);
+                case HashFunction::SHA384:  return std::make_unique<Sha512Context>(true);
+                case HashFunction::SHA512:  return std::make_unique<Sha512Context>(false);
+            }
+
+            return nullptr;
+        }
+
+        // Number of blocks that can be in flight at once, one being read while the others are hashed
+        constexpr static size_t HashPipelineDepth = 3;
+
+    }
+
+    std::optional<std::vector<std::vector<u8>>> hash(prv::Provider *provider, u64 offset, size_t size, const std::vector<HashRequest> &requests, const HashProgressCallback &progress, const std::stop_token &stopToken) {
+        std::vector<std::unique_ptr<HashContext>> contexts;
+        for (const auto &request : requests)
+            contexts.push_back(createHashContext(request));
+
+        if (contexts.empty())
+            return std::vector<std::vector<u8>>();
+
+        const u64 endOffset = std::min<u64>(offset + size, provider->getBaseAddress() + provider->getActualSize());
+        const size_t blockCount = offset < endOffset ? (endOffset - offset + HashBlockSize - 1) / HashBlockSize : 0;
+
+        struct Slot {
+            std::vector<u8> buffer;
+            std::span<const u8> data;
+        };
+        std::array<Slot, HashPipelineDepth> slots;
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        size_t readBlocks = 0;
+        std::vector<size_t> hashedBlocks(contexts.size(), 0);
+        bool stopped = false;
+
+        auto hashBlocks = [&](size_t index) {
+            for (size_t block = 0; block < blockCount; block++) {
+                {
+                    std::unique_lock lock(mutex);
+                    condition.wait(lock, [&] { return readBlocks > block || stopped; });
+                    if (stopped)
+                        return;
+                }
+
+                contexts[index]->update(slots[block % HashPipelineDepth].data);
+
+                {
+                    std::scoped_lock lock(mutex);
+                    hashedBlocks[index] = block + 1;
+                }
+                condition.notify_all();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < contexts.size(); i++)
+            workers.emplace_back(hashBlocks, i);
+
+        for (size_t block = 0; block < blockCount; block++) {
+            {
+                std::unique_lock lock(mutex);
+
+                // A slot can only be reused once every hash function is done with the block in it
+                condition.wait(lock, [&] { return std::all_of(hashedBlocks.begin(), hashedBlocks.end(), [&](size_t hashed) { return hashed + HashPipelineDepth > block; }); });
+
+                if (stopToken.stop_requested()) {
+                    stopped = true;
+                    break;
+                }
+            }
+
+            auto &slot = slots[block % HashPipelineDepth];
+            const u64 blockOffset = offset + block * HashBlockSize;
+            const size_t blockSize = std::min<u64>(HashBlockSize, endOffset - blockOffset);
+
+            // Unmodified data doesn't need to be copied if the backend can hand it out directly
+            std::optional<std::span<const u8>> span;
+            if (!provider->isModified(blockOffset, blockSize))
+                span = provider->getRawSpan(blockOffset - provider->getBaseAddress(), blockSize);
+
+            if (span.has_value() && span->size() == blockSize) {
+                slot.data = *span;
+            } else {
+                slot.buffer.resize(blockSize);
+                provider->read(blockOffset, slot.buffer.data(), blockSize);
+                slot.data = slot.buffer;
+            }
+
+            {
+                std::scoped_lock lock(mutex);
+                readBlocks = block + 1;
+            }
+            condition.notify_all();
+
+            if (progress)
+                progress(blockOffset + blockSize - offset);
+        }
+
+        condition.notify_all();
+        for (auto &worker : workers)
+            worker.join();
+
+        if (stopped)
+            return std::nullopt;
+
+        std::vector<std::vector<u8>> digests;
+        for (auto &context : contexts)
+            digests.push_back(context->finish());
+
+        return digests;
+    }
+
     std::vector<u8> decode64(const std::vector<u8> &input) {
 
         size_t written = 0;
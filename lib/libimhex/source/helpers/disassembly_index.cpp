@@ -0,0 +1,168 @@
+#include <hex/helpers/disassembly_index.hpp>
+
+#include <hex/providers/provider.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace hex {
+
+    namespace {
+
+        // Bytes that don't decode to anything are skipped one at a time, like Capstone's SKIPDATA does
+        size_t decodeInstruction(const DisassemblyIndex::DecodeFunction &decode, u64 address, std::span<const u8> code) {
+            return std::clamp<size_t>(decode(address, code), 1, std::min<size_t>(code.size(), 0xFF));
+        }
+
+    }
+
+    void DisassemblyIndex::append(u8 instructionSize) {
+        if (this->m_sizes.size() % CheckpointInterval == 0)
+            this->m_checkpoints.push_back(this->m_endOffset);
+
+        this->m_sizes.push_back(instructionSize);
+        this->m_endOffset += instructionSize;
+    }
+
+    DisassemblyIndex::Instruction DisassemblyIndex::getInstruction(size_t index) const {
+        if (index >= this->m_sizes.size())
+            return { this->m_endOffset, 0 };
+
+        const size_t checkpoint = index / CheckpointInterval;
+
+        u64 offset = this->m_checkpoints[checkpoint];
+        for (size_t i = checkpoint * CheckpointInterval; i < index; i++)
+            offset += this->m_sizes[i];
+
+        return { offset, this->m_sizes[index] };
+    }
+
+    DisassemblyIndex::ChunkResult DisassemblyIndex::decodeChunk(const ReadFunction &read, size_t size, u64 baseAddress, u64 chunkOffset, const DecodeFunction &decode) {
+        const size_t chunkSize = std::min<u64>(ChunkSize, size - chunkOffset);
+        const size_t readSize  = std::min<u64>(chunkSize + MaxInstructionSize, size - chunkOffset);
+
+        std::vector<u8> buffer(readSize);
+        read(chunkOffset, buffer.data(), buffer.size());
+
+        ChunkResult result;
+        result.sizes.reserve(chunkSize / 4);
+
+        // The last instruction may reach into the next chunk
+        for (size_t offset = 0; offset < chunkSize;) {
+            const size_t instructionSize = decodeInstruction(decode, baseAddress + chunkOffset + offset, std::span(buffer).subspan(offset));
+
+            result.sizes.push_back(instructionSize);
+            offset += instructionSize;
+        }
+
+        return result;
+    }
+
+    DisassemblyIndex DisassemblyIndex::build(const ReadFunction &read, size_t size, u64 baseAddress, const DecoderFactory &decoderFactory, const ProgressCallback &progress, u32 threadCount, const std::stop_token &stopToken) {
+        DisassemblyIndex index;
+        if (size == 0)
+            return index;
+
+        const size_t chunkCount = (size + ChunkSize - 1) / ChunkSize;
+        threadCount = std::clamp<size_t>(threadCount, 1, chunkCount);
+
+        std::vector<ChunkResult> chunks(chunkCount);
+        std::atomic<size_t> nextChunk = 0;
+        std::atomic<u64> processedSize = 0;
+
+        auto decodeChunks = [&](bool reportProgress) {
+            auto decode = decoderFactory();
+
+            for (size_t chunk = nextChunk++; chunk < chunkCount && !stopToken.stop_requested(); chunk = nextChunk++) {
+                chunks[chunk] = decodeChunk(read, size, baseAddress, chunk * ChunkSize, decode);
+
+                processedSize += std::min<u64>(ChunkSize, size - chunk * ChunkSize);
+                if (reportProgress && progress)
+                    progress(processedSize);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (u32 i = 1; i < threadCount; i++)
+            workers.emplace_back(decodeChunks, false);
+
+        decodeChunks(true);
+
+        for (auto &worker : workers)
+            worker.join();
+
+        if (stopToken.stop_requested())
+            return index;
+
+        // Every chunk was decoded as if an instruction started at its border. Where the instructions of the previous
+        // chunk end somewhere else, decode again from there until both streams share an instruction boundary
+        DecodeFunction decode;
+        std::vector<u8> buffer;
+
+        for (size_t chunk = 0; chunk < chunkCount; chunk++) {
+            const u64 chunkOffset = chunk * ChunkSize;
+            const u64 chunkEnd    = std::min<u64>(chunkOffset + ChunkSize, size);
+            auto &sizes = chunks[chunk].sizes;
+
+            size_t speculativeIndex = 0;
+            u64 speculativeOffset = chunkOffset;
+
+            const auto advanceSpeculative = [&] {
+                while (speculativeIndex < sizes.size() && speculativeOffset < index.m_endOffset)
+                    speculativeOffset += sizes[speculativeIndex++];
+            };
+
+            advanceSpeculative();
+
+            if (speculativeOffset != index.m_endOffset) {
+                if (!decode) {
+                    decode = decoderFactory();
+                    buffer.resize(ChunkSize + MaxInstructionSize);
+                }
+
+                const u64 bufferOffset = index.m_endOffset;
+                const size_t bufferSize = std::min<u64>(buffer.size(), size - bufferOffset);
+                read(bufferOffset, buffer.data(), bufferSize);
+
+                while (index.m_endOffset < chunkEnd && speculativeOffset != index.m_endOffset) {
+                    const u64 relativeOffset = index.m_endOffset - bufferOffset;
+                    index.append(decodeInstruction(decode, baseAddress + index.m_endOffset, std::span(buffer.data() + relativeOffset, bufferSize - relativeOffset)));
+
+                    advanceSpeculative();
+                }
+            }
+
+            if (speculativeOffset == index.m_endOffset) {
+                for (size_t i = speculativeIndex; i < sizes.size(); i++)
+                    index.append(sizes[i]);
+            }
+
+            sizes.clear();
+            sizes.shrink_to_fit();
+        }
+
+        return index;
+    }
+
+    DisassemblyIndex DisassemblyIndex::build(prv::Provider *provider, u64 address, size_t size, u64 baseAddress, const DecoderFactory &decoderFactory, const ProgressCallback &progress, u32 threadCount, const std::stop_token &stopToken) {
+        // Backends that can't hand out their data directly usually don't support being read from multiple threads either
+        if (threadCount == 0)
+            threadCount = provider->getRawSpan(0, 1).has_value() ? std::max(std::thread::hardware_concurrency(), 1U) : 1;
+
+        const auto read = [provider, address](u64 offset, u8 *buffer, size_t size) {
+            provider->read(address + offset, buffer, size);
+        };
+
+        return build(read, size, baseAddress, decoderFactory, progress, threadCount, stopToken);
+    }
+
+    DisassemblyIndex DisassemblyIndex::build(std::span<const u8> code, u64 baseAddress, const DecoderFactory &decoderFactory, u32 threadCount) {
+        const auto read = [code](u64 offset, u8 *buffer, size_t size) {
+            std::copy_n(code.begin() + offset, size, buffer);
+        };
+
+        return build(read, code.size(), baseAddress, decoderFactory, { }, threadCount, { });
+    }
+
+}
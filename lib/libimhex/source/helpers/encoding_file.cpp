@@ -17,18 +17,109 @@ namespace hex {
         this->m_valid = true;
     }
 
-    std::pair<std::string_view, size_t> EncodingFile::getEncodingFor(const std::vector<u8> &buffer) const {
-        for (auto riter = this->m_mapping.crbegin(); riter != this->m_mapping.crend(); ++riter) {
-            const auto &[size, mapping] = *riter;
+    std::pair<std::string_view, size_t> EncodingFile::getEncodingFor(std::span<const u8> buffer) const {
+        return this->findEncodingFor(buffer).value_or(std::pair<std::string_view, size_t> { ".", 1 });
+    }
+
+    std::optional<std::pair<std::string_view, size_t>> EncodingFile::findEncodingFor(std::span<const u8> buffer) const {
+        if (this->m_nodes.empty())
+            return std::nullopt;
+
+        std::optional<std::pair<std::string_view, size_t>> result;
 
-            if (size > buffer.size()) continue;
+        // Follow the data down the trie and remember the last node that had a text, that's the longest match
+        u32 node = 0;
+        const size_t size = std::min(buffer.size(), this->m_longestSequence);
+        for (size_t i = 0; i < size; i++) {
+            const u32 children = this->m_nodes[node].children;
+            if (children == None)
+                break;
 
-            auto key = std::vector<u8>(buffer.begin(), buffer.begin() + size);
-            if (mapping.contains(key))
-                return { mapping.at(key), size };
+            node = this->m_children[children][buffer[i]];
+            if (node == 0)
+                break;
+
+            const auto &[nodeChildren, textOffset, textSize] = this->m_nodes[node];
+            if (textOffset != None)
+                result = { std::string_view(this->m_texts).substr(textOffset, textSize), i + 1 };
         }
 
-        return { ".", 1 };
+        return result;
+    }
+
+    void EncodingFile::decode(std::span<const u8> data, std::string &result) const {
+        for (size_t i = 0; i < data.size();) {
+            auto [decoded, size] = this->getEncodingFor(data.subspan(i));
+
+            result += decoded;
+            i += size;
+        }
+    }
+
+    std::string EncodingFile::decode(std::span<const u8> data) const {
+        std::string result;
+        result.reserve(data.size());
+
+        this->decode(data, result);
+
+        return result;
+    }
+
+    std::optional<std::vector<u8>> EncodingFile::encode(std::string_view text) const {
+        std::vector<u8> result;
+
+        for (size_t i = 0; i < text.size();) {
+            bool found = false;
+
+            for (size_t size = std::min(this->m_longestText, text.size() - i); size > 0; size--) {
+                if (auto iter = this->m_reverseMapping.find(text.substr(i, size)); iter != this->m_reverseMapping.end()) {
+                    result.insert(result.end(), iter->second.begin(), iter->second.end());
+                    i += size;
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found)
+                return std::nullopt;
+        }
+
+        return result;
+    }
+
+    void EncodingFile::addMapping(std::span<const u8> bytes, std::string_view text) {
+        if (this->m_nodes.empty())
+            this->m_nodes.emplace_back();
+
+        u32 node = 0;
+        for (u8 byte : bytes) {
+            if (this->m_nodes[node].children == None) {
+                this->m_nodes[node].children = this->m_children.size();
+                this->m_children.emplace_back().fill(0);
+            }
+
+            auto &child = this->m_children[this->m_nodes[node].children][byte];
+            if (child == 0) {
+                child = this->m_nodes.size();
+                this->m_nodes.emplace_back();
+            }
+
+            node = child;
+        }
+
+        // Like before, the first entry of a byte sequence that's listed multiple times wins
+        auto &entry = this->m_nodes[node];
+        if (entry.textOffset == None) {
+            entry.textOffset = this->m_texts.size();
+            entry.textSize = text.size();
+            this->m_texts += text;
+        }
+
+        if (!this->m_reverseMapping.contains(text))
+            this->m_reverseMapping.emplace(text, std::vector<u8>(bytes.begin(), bytes.end()));
+
+        this->m_longestSequence = std::max(this->m_longestSequence, bytes.size());
+        this->m_longestText = std::max(this->m_longestText, text.size());
     }
 
     void EncodingFile::parseThingyFile(std::ifstream &content) {
@@ -52,14 +143,10 @@ namespace hex {
             }
 
             auto fromBytes = hex::parseByteString(from);
-            if (fromBytes.empty()) continue;
-
-            if (!this->m_mapping.contains(fromBytes.size()))
-                this->m_mapping.insert({ fromBytes.size(), { } });
-            this->m_mapping[fromBytes.size()].insert({ fromBytes, to });
+            if (fromBytes.empty() || fromBytes.size() > MaxSequenceLength) continue;
 
-            this->m_longestSequence = std::max(this->m_longestSequence, fromBytes.size());
+            this->addMapping(fromBytes, to);
         }
     }
 
-}
\ No newline at end of file
+}
@@ -4,6 +4,7 @@
 
 #include <cstring>
 #include <string_view>
+#include <nlohmann/json.hpp>
 #include <type_traits>
 
 namespace hex {
@@ -18,98 +19,236 @@ namespace hex {
         std::memcpy((&buffer.back() - sizeof(T)) + 1, &bytes, sizeof(T));
     }
     
-    std::vector<u8> generateIPSPatch(const Patches &patches) {
-        std::vector<u8> result;
+    Patches::Extents::const_iterator Patches::findFirstOverlapping(u64 address) const {
+        auto iter = this->m_extents.upper_bound(address);
 
-        pushStringBack(result, "PATCH");
+        if (iter != this->m_extents.begin()) {
+            auto prev = std::prev(iter);
+            if (prev->first + prev->second.size() > address)
+                return prev;
+        }
+
+        return iter;
+    }
 
-        std::vector<u64> addresses;
-        std::vector<u8> values;
+    void Patches::add(u64 address, const void *buffer, size_t size) {
+        if (buffer == nullptr || size == 0)
+            return;
 
-        for (const auto &[address, value] : patches) {
-            addresses.push_back(address);
-            values.push_back(value);
+        const u64 endAddress = address + size;
+
+        // Find all extents that overlap or directly touch the new data so they can be merged into one
+        auto first = this->m_extents.upper_bound(address);
+        if (first != this->m_extents.begin()) {
+            auto prev = std::prev(first);
+            if (prev->first + prev->second.size() >= address)
+                first = prev;
         }
 
-        std::optional<u64> startAddress;
-        std::vector<u8> bytes;
-        for (u32 i = 0; i < addresses.size(); i++) {
-            if (!startAddress.has_value())
-                startAddress = addresses[i];
+        auto last = first;
+        size_t replacedSize = 0;
+        while (last != this->m_extents.end() && last->first <= endAddress) {
+            replacedSize += last->second.size();
+            last++;
+        }
 
-            if (i != addresses.size() - 1 && addresses[i] == (addresses[i + 1] - 1)) {
-                bytes.push_back(values[i]);
-            } else {
-                bytes.push_back(values[i]);
+        if (first == last) {
+            this->m_extents.emplace_hint(last, address, std::vector<u8>(static_cast<const u8*>(buffer), static_cast<const u8*>(buffer) + size));
+            this->m_size += size;
+            return;
+        }
 
-                if (bytes.size() > 0xFFFF || startAddress > 0xFF'FFFF)
-                    return { };
+        const auto lastExtent = std::prev(last);
+        const u64 mergedStart = std::min(address, first->first);
+        const u64 mergedEnd   = std::max(endAddress, lastExtent->first + lastExtent->second.size());
+
+        if (first->first == mergedStart) {
+            // Grow the first extent in place, this keeps appending to an existing patch cheap
+            auto &data = first->second;
+            data.resize(mergedEnd - mergedStart);
+
+            for (auto iter = std::next(first); iter != last; iter++)
+                std::memcpy(data.data() + (iter->first - mergedStart), iter->second.data(), iter->second.size());
+            std::memcpy(data.data() + (address - mergedStart), buffer, size);
 
-                u32 address = startAddress.value();
-                auto addressBytes = reinterpret_cast<u8*>(&address);
+            this->m_extents.erase(std::next(first), last);
+        } else {
+            std::vector<u8> data(mergedEnd - mergedStart);
 
-                result.push_back(addressBytes[2]); result.push_back(addressBytes[1]); result.push_back(addressBytes[0]);
-                pushBytesBack<u16>(result, changeEndianess<u16>(bytes.size(), std::endian::big));
+            for (auto iter = first; iter != last; iter++)
+                std::memcpy(data.data() + (iter->first - mergedStart), iter->second.data(), iter->second.size());
+            std::memcpy(data.data() + (address - mergedStart), buffer, size);
+
+            this->m_extents.erase(first, last);
+            this->m_extents.emplace_hint(last, mergedStart, std::move(data));
+        }
 
-                for (auto byte : bytes)
-                    result.push_back(byte);
+        this->m_size = this->m_size - replacedSize + (mergedEnd - mergedStart);
+    }
+
+    void Patches::remove(u64 address, size_t size) {
+        const u64 endAddress = address + size;
+
+        auto iter = this->m_extents.upper_bound(address);
+        if (iter != this->m_extents.begin()) {
+            auto prev = std::prev(iter);
+            if (prev->first + prev->second.size() > address)
+                iter = prev;
+        }
 
-                bytes.clear();
-                startAddress = { };
+        while (iter != this->m_extents.end() && iter->first < endAddress) {
+            auto &data = iter->second;
+            const u64 extentStart = iter->first;
+            const u64 extentEnd   = extentStart + data.size();
+
+            this->m_size -= std::min(extentEnd, endAddress) - std::max(extentStart, address);
+
+            // Keep the part of the extent behind the removed region around as its own extent
+            if (extentEnd > endAddress)
+                this->m_extents.emplace_hint(std::next(iter), endAddress, std::vector<u8>(data.begin() + (endAddress - extentStart), data.end()));
+
+            if (extentStart < address) {
+                data.resize(address - extentStart);
+                iter++;
+            } else {
+                iter = this->m_extents.erase(iter);
             }
         }
+    }
 
-        pushStringBack(result, "EOF");
+    void Patches::shift(u64 address, size_t offset) {
+        if (offset == 0)
+            return;
 
-        return result;
+        // Split an extent that spans over the insertion point so its tail moves along with the data
+        auto iter = this->m_extents.upper_bound(address);
+        if (iter != this->m_extents.begin()) {
+            auto prev = std::prev(iter);
+            auto &data = prev->second;
+
+            if (prev->first < address && prev->first + data.size() > address) {
+                this->m_extents.emplace_hint(iter, address, std::vector<u8>(data.begin() + (address - prev->first), data.end()));
+                data.resize(address - prev->first);
+            }
+        }
+
+        std::vector<Extents::node_type> movedExtents;
+        for (auto curr = this->m_extents.lower_bound(address); curr != this->m_extents.end(); curr = this->m_extents.lower_bound(address))
+            movedExtents.push_back(this->m_extents.extract(curr));
+
+        for (auto &node : movedExtents) {
+            node.key() += offset;
+            this->m_extents.insert(std::move(node));
+        }
     }
 
-    std::vector<u8> generateIPS32Patch(const Patches &patches) {
-        std::vector<u8> result;
+    void Patches::clear() {
+        this->m_extents.clear();
+        this->m_size = 0;
+    }
 
-        pushStringBack(result, "IPS32");
+    void Patches::apply(u64 address, void *buffer, size_t size) const {
+        const u64 endAddress = address + size;
 
-        std::vector<u64> addresses;
-        std::vector<u8> values;
+        for (auto iter = this->findFirstOverlapping(address); iter != this->m_extents.end() && iter->first < endAddress; iter++) {
+            const u64 overlapStart = std::max(iter->first, address);
+            const u64 overlapEnd   = std::min(iter->first + iter->second.size(), endAddress);
 
-        for (const auto &[address, value] : patches) {
-            addresses.push_back(address);
-            values.push_back(value);
+            std::memcpy(static_cast<u8*>(buffer) + (overlapStart - address), iter->second.data() + (overlapStart - iter->first), overlapEnd - overlapStart);
         }
+    }
 
-        std::optional<u64> startAddress;
-        std::vector<u8> bytes;
-        for (u32 i = 0; i < addresses.size(); i++) {
-            if (!startAddress.has_value())
-                startAddress = addresses[i];
+    bool Patches::contains(u64 address) const {
+        auto iter = this->findFirstOverlapping(address);
 
-            if (i != addresses.size() - 1 && addresses[i] == (addresses[i + 1] - 1)) {
-                bytes.push_back(values[i]);
-            } else {
-                bytes.push_back(values[i]);
+        return iter != this->m_extents.end() && iter->first <= address;
+    }
 
-                if (bytes.size() > 0xFFFF || startAddress > 0xFFFF'FFFF)
-                    return { };
+    bool Patches::overlaps(u64 address, size_t size) const {
+        auto iter = this->findFirstOverlapping(address);
+
+        return iter != this->m_extents.end() && iter->first < address + size;
+    }
+
+    std::optional<u8> Patches::get(u64 address) const {
+        auto iter = this->findFirstOverlapping(address);
+
+        if (iter == this->m_extents.end() || iter->first > address)
+            return std::nullopt;
+
+        return iter->second[address - iter->first];
+    }
+
+    Patches Patches::getRange(u64 address, size_t size) const {
+        Patches result;
+        const u64 endAddress = address + size;
+
+        for (auto iter = this->findFirstOverlapping(address); iter != this->m_extents.end() && iter->first < endAddress; iter++) {
+            const u64 overlapStart = std::max(iter->first, address);
+            const u64 overlapEnd   = std::min(iter->first + iter->second.size(), endAddress);
 
-                u32 address = startAddress.value();
-                auto addressBytes = reinterpret_cast<u8*>(&address);
+            result.add(overlapStart, iter->second.data() + (overlapStart - iter->first), overlapEnd - overlapStart);
+        }
 
-                result.push_back(addressBytes[3]); result.push_back(addressBytes[2]); result.push_back(addressBytes[1]); result.push_back(addressBytes[0]);
-                pushBytesBack<u16>(result, changeEndianess<u16>(bytes.size(), std::endian::big));
+        return result;
+    }
 
-                for (auto byte : bytes)
-                    result.push_back(byte);
+    void to_json(nlohmann::json &j, const Patches &patches) {
+        std::map<u64, u8> bytes;
+
+        for (const auto &[address, data] : patches) {
+            for (u64 i = 0; i < data.size(); i++)
+                bytes.emplace(address + i, data[i]);
+        }
+
+        j = bytes;
+    }
 
-                bytes.clear();
-                startAddress = { };
+    void from_json(const nlohmann::json &j, Patches &patches) {
+        patches.clear();
+
+        for (const auto &[address, value] : j.get<std::map<u64, u8>>())
+            patches.add(address, value);
+    }
+
+    template<size_t AddressSize>
+    static std::vector<u8> generateIPSPatchImpl(const Patches &patches, const std::string &magic, const std::string &eofMarker) {
+        constexpr static u64 MaxAddress = (1ULL << (AddressSize * 8)) - 1;
+        constexpr static size_t MaxRecordSize = 0xFFFF;
+
+        std::vector<u8> result;
+
+        pushStringBack(result, magic);
+
+        for (const auto &[extentAddress, data] : patches) {
+            for (u64 recordOffset = 0; recordOffset < data.size(); recordOffset += MaxRecordSize) {
+                const u64 address = extentAddress + recordOffset;
+                const size_t recordSize = std::min<size_t>(MaxRecordSize, data.size() - recordOffset);
+
+                if (address > MaxAddress)
+                    return { };
+
+                for (s32 i = AddressSize - 1; i >= 0; i--)
+                    result.push_back((address >> (i * 8)) & 0xFF);
+                pushBytesBack<u16>(result, changeEndianess<u16>(recordSize, std::endian::big));
+
+                std::copy(data.begin() + recordOffset, data.begin() + recordOffset + recordSize, std::back_inserter(result));
             }
         }
 
-        pushStringBack(result, "EEOF");
+        pushStringBack(result, eofMarker);
 
         return result;
     }
 
+    std::vector<u8> generateIPSPatch(const Patches &patches) {
+        return generateIPSPatchImpl<3>(patches, "PATCH", "EOF");
+    }
+
+    std::vector<u8> generateIPS32Patch(const Patches &patches) {
+        return generateIPSPatchImpl<4>(patches, "IPS32", "EEOF");
+    }
+
     Patches loadIPSPatch(const std::vector<u8> &ipsPatch) {
         if (ipsPatch.size() < (5 + 3))
             return { };
@@ -132,8 +271,7 @@ namespace hex {
                 if (ipsOffset + size > ipsPatch.size() - 3)
                     return { };
 
-                for (u16 i = 0; i < size; i++)
-                    result[offset + i] = ipsPatch[ipsOffset + i];
+                result.add(offset, &ipsPatch[ipsOffset], size);
                 ipsOffset += size;
             }
             // Handle RLE record
@@ -145,8 +283,8 @@ namespace hex {
 
                 ipsOffset += 2;
 
-                for (u16 i = 0; i < rleSize; i++)
-                    result[offset + i] = ipsPatch[ipsOffset + 0];
+                const std::vector<u8> rleData(rleSize, ipsPatch[ipsOffset + 0]);
+                result.add(offset, rleData.data(), rleData.size());
 
                 ipsOffset += 1;
             }
@@ -183,8 +321,7 @@ namespace hex {
                 if (ipsOffset + size > ipsPatch.size() - 3)
                     return { };
 
-                for (u16 i = 0; i < size; i++)
-                    result[offset + i] = ipsPatch[ipsOffset + i];
+                result.add(offset, &ipsPatch[ipsOffset], size);
                 ipsOffset += size;
             }
             // Handle RLE record
@@ -196,8 +333,8 @@ namespace hex {
 
                 ipsOffset += 2;
 
-                for (u16 i = 0; i < rleSize; i++)
-                    result[offset + i] = ipsPatch[ipsOffset + 0];
+                const std::vector<u8> rleData(rleSize, ipsPatch[ipsOffset + 0]);
+                result.add(offset, rleData.data(), rleData.size());
 
                 ipsOffset += 1;
             }
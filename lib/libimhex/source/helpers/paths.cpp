@@ -103,6 +103,8 @@ namespace hex {
                         return (path / "logs").string();
                     });
                     break;
+                case ImHexPath::Cache:
+                    return { (appDataDir / "imhex" / "cache").string() };
                 default: __builtin_unreachable();
             }
         #elif defined(OS_MACOS)
@@ -145,6 +147,9 @@ namespace hex {
             case ImHexPath::Logs:
                 result.push_back((applicationSupportDir / "logs").string());
                 break;
+            case ImHexPath::Cache:
+                result.push_back((applicationSupportDir / "cache").string());
+                break;
             default: __builtin_unreachable();
             }
         #else
@@ -203,6 +208,9 @@ namespace hex {
                     std::transform(dataDirs.begin(), dataDirs.end(), std::back_inserter(result),
                         [](auto p) { return (p / "logs").string(); });
                     break;
+                case ImHexPath::Cache:
+                    result.push_back((xdg::CacheHomeDir() / "imhex").string());
+                    break;
                 default: __builtin_unreachable();
             }
         #endif
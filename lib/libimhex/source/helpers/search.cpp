@@ -0,0 +1,233 @@
+#include <hex/helpers/search.hpp>
+
+#include <hex/helpers/encoding_file.hpp>
+#include <hex/providers/provider.hpp>
+
+#include <cctype>
+#include <codecvt>
+#include <cstring>
+#include <locale>
+#include <string>
+
+namespace hex {
+
+    SearchPattern::SearchPattern(std::vector<std::bitset<256>> bytes) : m_bytes(std::move(bytes)) {
+        const size_t size = this->m_bytes.size();
+
+        // Horspool shift table, every byte value matched by a position further back limits how far the window may move
+        this->m_shifts.fill(size);
+        for (size_t i = 0; i + 1 < size; i++) {
+            for (u16 value = 0; value < 256; value++) {
+                if (this->m_bytes[i].test(value))
+                    this->m_shifts[value] = size - 1 - i;
+            }
+        }
+
+        // Prefer anchoring on the last exact byte, but avoid bytes that are very common in binary data
+        std::optional<std::pair<size_t, u8>> fallbackAnchor;
+        for (size_t i = size; i > 0; i--) {
+            const auto &byte = this->m_bytes[i - 1];
+            if (byte.count() != 1)
+                continue;
+
+            u8 value = 0x00;
+            while (!byte.test(value))
+                value++;
+
+            if (value != 0x00 && value != 0xFF) {
+                this->m_anchor = { i - 1, value };
+                break;
+            } else if (!fallbackAnchor.has_value()) {
+                fallbackAnchor = { i - 1, value };
+            }
+        }
+
+        if (!this->m_anchor.has_value())
+            this->m_anchor = fallbackAnchor;
+    }
+
+    std::optional<SearchPattern> SearchPattern::fromHexString(std::string_view string) {
+        std::string digits;
+        for (char c : string) {
+            if (std::isspace(static_cast<unsigned char>(c)))
+                continue;
+            else if (std::isxdigit(static_cast<unsigned char>(c)) || c == '?')
+                digits += c;
+            else
+                return std::nullopt;
+        }
+
+        if (digits.empty())
+            return std::nullopt;
+
+        if ((digits.size() % 2) == 1)
+            digits = "0" + digits;
+
+        std::vector<std::bitset<256>> bytes;
+        bytes.reserve(digits.size() / 2);
+
+        auto parseNibble = [](char c) -> std::optional<u8> {
+            if (c == '?')
+                return std::nullopt;
+            else
+                return std::stoul(std::string(1, c), nullptr, 16);
+        };
+
+        for (size_t i = 0; i < digits.size(); i += 2) {
+            const auto high = parseNibble(digits[i]), low = parseNibble(digits[i + 1]);
+
+            // Every nibble can be a wildcard on its own, e.g. 4? matches 0x40 to 0x4F
+            std::bitset<256> byte;
+            for (u16 value = 0; value < 256; value++) {
+                if ((!high.has_value() || *high == (value >> 4)) && (!low.has_value() || *low == (value & 0x0F)))
+                    byte.set(value);
+            }
+
+            bytes.push_back(byte);
+        }
+
+        return SearchPattern(std::move(bytes));
+    }
+
+    std::optional<SearchPattern> SearchPattern::fromString(std::string_view string, bool caseSensitive, Encoding encoding) {
+        // Custom encodings need their encoding file
+        if (string.empty() || encoding == Encoding::Custom)
+            return std::nullopt;
+
+        auto makeByte = [caseSensitive](u8 value) {
+            std::bitset<256> byte;
+            byte.set(value);
+
+            if (!caseSensitive && std::isalpha(value)) {
+                byte.set(std::tolower(value));
+                byte.set(std::toupper(value));
+            }
+
+            return byte;
+        };
+
+        std::vector<std::bitset<256>> bytes;
+
+        if (encoding == Encoding::ASCII) {
+            for (char c : string)
+                bytes.push_back(makeByte(c));
+        } else {
+            std::u16string utf16;
+            try {
+                utf16 = std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>().from_bytes(string.data(), string.data() + string.size());
+            } catch (const std::range_error &e) {
+                return std::nullopt;
+            }
+
+            for (char16_t c : utf16) {
+                const u8 low = c & 0xFF, high = c >> 8;
+
+                // Case folding only applies to the ASCII range where the high byte is zero
+                auto lowByte  = high == 0x00 ? makeByte(low) : std::bitset<256>().set(low);
+                auto highByte = std::bitset<256>().set(high);
+
+                if (encoding == Encoding::UTF16LE) {
+                    bytes.push_back(lowByte);
+                    bytes.push_back(highByte);
+                } else {
+                    bytes.push_back(highByte);
+                    bytes.push_back(lowByte);
+                }
+            }
+        }
+
+        return SearchPattern(std::move(bytes));
+    }
+
+    std::optional<SearchPattern> SearchPattern::fromString(std::string_view string, const EncodingFile &encodingFile) {
+        if (string.empty() || !encodingFile.valid())
+            return std::nullopt;
+
+        auto encoded = encodingFile.encode(string);
+        if (!encoded.has_value())
+            return std::nullopt;
+
+        std::vector<std::bitset<256>> bytes;
+        for (u8 byte : *encoded)
+            bytes.push_back(std::bitset<256>().set(byte));
+
+        return SearchPattern(std::move(bytes));
+    }
+
+    bool SearchPattern::matches(const u8 *data) const {
+        for (size_t i = 0; i < this->m_bytes.size(); i++) {
+            if (!this->m_bytes[i].test(data[i]))
+                return false;
+        }
+
+        return true;
+    }
+
+    void SearchPattern::search(std::span<const u8> data, const MatchCallback &callback) const {
+        const size_t size = this->m_bytes.size();
+        if (size == 0 || data.size() < size)
+            return;
+
+        const u8 *begin = data.data();
+        const size_t lastOffset = data.size() - size;
+
+        if (this->m_anchor.has_value()) {
+            // memchr is vectorized by all common C libraries and quickly skips over data that can't contain a match
+            const auto [anchorIndex, anchorValue] = *this->m_anchor;
+
+            const u8 *curr = begin + anchorIndex;
+            const u8 *last = begin + lastOffset + anchorIndex;
+            while (curr <= last) {
+                auto found = static_cast<const u8*>(std::memchr(curr, anchorValue, (last - curr) + 1));
+                if (found == nullptr)
+                    break;
+
+                const u8 *start = found - anchorIndex;
+                if (this->matches(start))
+                    callback(start - begin);
+
+                curr = found + 1;
+            }
+        } else {
+            for (u64 offset = 0; offset <= lastOffset; offset += this->m_shifts[begin[offset + size - 1]]) {
+                if (this->matches(begin + offset))
+                    callback(offset);
+            }
+        }
+    }
+
+    void SearchPattern::search(prv::Provider *provider, u64 address, size_t size, const MatchCallback &callback, const ProgressCallback &progress) const {
+        const size_t patternSize = this->m_bytes.size();
+        if (patternSize == 0)
+            return;
+
+        // Tail of the previous chunk, needed to find matches crossing the border between two chunks
+        std::vector<u8> boundary;
+
+        const u64 endAddress = address + size;
+        for (u64 blockAddress = address; blockAddress < endAddress; blockAddress += SearchBlockSize) {
+            provider->readChunks(blockAddress, std::min<u64>(SearchBlockSize, endAddress - blockAddress), [&](u64 chunkAddress, std::span<const u8> data) {
+                if (!boundary.empty()) {
+                    const size_t tailSize = boundary.size();
+                    boundary.insert(boundary.end(), data.begin(), data.begin() + std::min(data.size(), patternSize - 1));
+
+                    this->search(boundary, [&](u64 offset) {
+                        if (offset < tailSize)
+                            callback(chunkAddress - tailSize + offset);
+                    });
+                }
+
+                this->search(data, [&](u64 offset) {
+                    callback(chunkAddress + offset);
+                });
+
+                const size_t tailSize = std::min(data.size(), patternSize - 1);
+                boundary.assign(data.end() - tailSize, data.end());
+            });
+
+            if (progress && !progress(std::min<u64>(blockAddress + SearchBlockSize, endAddress) - address))
+                break;
+        }
+    }
+
+}
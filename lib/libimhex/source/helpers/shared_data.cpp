@@ -19,6 +19,7 @@ namespace hex {
     u32 SharedData::patternPaletteOffset;
     std::string SharedData::popupMessage;
     std::list<ImHexApi::Bookmarks::Entry> SharedData::bookmarkEntries;
+    std::mutex SharedData::patternDataMutex;
     std::vector<pl::PatternData*> SharedData::patternData;
 
     std::map<std::string, std::string> SharedData::languageNames;
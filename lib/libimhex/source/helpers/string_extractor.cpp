@@ -0,0 +1,349 @@
+#include <hex/helpers/string_extractor.hpp>
+
+#include <hex/providers/provider.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <thread>
+
+namespace hex {
+
+    StringExtractor::StringExtractor(Encoding encoding, size_t minimumLength, EncodingFile encodingFile)
+        : m_encoding(encoding), m_minimumLength(minimumLength), m_encodingFile(std::move(encodingFile)) {
+
+        if (this->m_encoding == Encoding::Custom && !this->m_encodingFile.valid())
+            this->m_encoding = Encoding::ASCII;
+    }
+
+    size_t StringExtractor::getMaxCharacterSize() const {
+        switch (this->m_encoding) {
+            case Encoding::UTF8:    return 4;
+            case Encoding::UTF16LE:
+            case Encoding::UTF16BE: return 2;
+            case Encoding::Custom:  return std::max<size_t>(this->m_encodingFile.getLongestSequence(), 1);
+            default:                return 1;
+        }
+    }
+
+    namespace {
+
+        /*
+         * Calls onRun for every run of characters starting inside of the first chunkSize bytes.
+         * Instantiated separately for every encoding so the character check gets inlined into the loops.
+         */
+        template<typename CharacterSizeFunction, typename RunFunction>
+        void scanRuns(std::span<const u8> data, size_t chunkSize, CharacterSizeFunction getCharacterSize, RunFunction onRun) {
+            const u8 *bytes = data.data();
+            const size_t available = data.size();
+
+            size_t i = 0;
+            while (i < chunkSize) {
+                size_t characterSize = 0;
+                while (i < chunkSize && (characterSize = getCharacterSize(bytes + i, available - i)) == 0)
+                    i++;
+
+                if (i >= chunkSize)
+                    break;
+
+                const size_t start = i;
+                size_t length = 0;
+                do {
+                    i += characterSize;
+                    length++;
+                } while (i < chunkSize && (characterSize = getCharacterSize(bytes + i, available - i)) > 0);
+
+                onRun(start, i - start, length, i < chunkSize);
+            }
+        }
+
+        constexpr bool isPrintable(u8 c) {
+            return c >= ' ' && c <= '~';
+        }
+
+        constexpr bool isContinuation(u8 c) {
+            return (c & 0xC0) == 0x80;
+        }
+
+        // Tests eight bytes at once, returns a bitmask with one bit set for every printable byte
+        u64 getPrintableBits(const u8 *bytes) {
+            u64 value;
+            std::memcpy(&value, bytes, sizeof(value));
+
+            const u64 lowBits       = value & 0x7F7F'7F7F'7F7F'7F7FULL;
+            const u64 atLeastSpace  = lowBits + 0x6060'6060'6060'6060ULL;
+            const u64 isDelete      = lowBits + 0x0101'0101'0101'0101ULL;
+            const u64 printable     = atLeastSpace & ~isDelete & ~value & 0x8080'8080'8080'8080ULL;
+
+            // Gathers the top bit of every byte into the lowest byte
+            return ((printable >> 7) * 0x0102'0408'1020'4080ULL) >> 56;
+        }
+
+        std::vector<u64> shiftBitsRight(const std::vector<u64> &bits, size_t shift) {
+            std::vector<u64> result(bits.size(), 0);
+
+            const size_t wordShift = shift / 64, bitShift = shift % 64;
+            for (size_t i = 0; i + wordShift < bits.size(); i++) {
+                result[i] = bits[i + wordShift] >> bitShift;
+                if (bitShift != 0 && i + wordShift + 1 < bits.size())
+                    result[i] |= bits[i + wordShift + 1] << (64 - bitShift);
+            }
+
+            return result;
+        }
+
+        /*
+         * Binary data switches between printable and unprintable bytes all the time which makes a per byte
+         * state machine mispredict constantly. Instead, build a bitmask of all printable bytes, narrow it down
+         * to the positions where at least minimumLength printable bytes follow and only visit those.
+         */
+        template<typename RunFunction>
+        void scanAsciiRuns(const u8 *bytes, size_t chunkSize, size_t minimumLength, RunFunction onRun) {
+            // Runs touching either end of the chunk are needed for stitching regardless of their length
+            size_t headSize = 0;
+            while (headSize < chunkSize && isPrintable(bytes[headSize]))
+                headSize++;
+
+            if (headSize == chunkSize) {
+                if (chunkSize > 0)
+                    onRun(0, chunkSize, chunkSize, false);
+                return;
+            }
+
+            if (headSize > 0)
+                onRun(0, headSize, headSize, true);
+
+            size_t tailStart = chunkSize;
+            while (isPrintable(bytes[tailStart - 1]))
+                tailStart--;
+
+            std::vector<u64> printable((chunkSize + 63) / 64, 0);
+            for (size_t word = 0; word < printable.size(); word++) {
+                const size_t count = std::min<size_t>(64, chunkSize - word * 64);
+
+                u64 mask = 0;
+                size_t bit = 0;
+                for (; bit + 8 <= count; bit += 8)
+                    mask |= getPrintableBits(bytes + word * 64 + bit) << bit;
+                for (; bit < count; bit++)
+                    mask |= u64(isPrintable(bytes[word * 64 + bit])) << bit;
+
+                printable[word] = mask;
+            }
+
+            // Double the number of covered bytes until every set bit marks the start of a long enough run
+            auto starts = printable;
+            for (size_t covered = 1; covered < minimumLength;) {
+                const size_t shift = std::min(covered, minimumLength - covered);
+                const auto shifted = shiftBitsRight(starts, shift);
+
+                for (size_t i = 0; i < starts.size(); i++)
+                    starts[i] &= shifted[i];
+
+                covered += shift;
+            }
+
+            size_t offset = headSize;
+            while (offset < tailStart) {
+                u64 word = starts[offset / 64] & (~u64(0) << (offset % 64));
+                if (word == 0) {
+                    offset = (offset / 64 + 1) * 64;
+                    continue;
+                }
+
+                const size_t start = (offset / 64) * 64 + std::countr_zero(word);
+                if (start >= tailStart)
+                    break;
+
+                size_t end = start;
+                while (end < tailStart && isPrintable(bytes[end]))
+                    end++;
+
+                onRun(start, end - start, end - start, true);
+                offset = end;
+            }
+
+            if (tailStart < chunkSize)
+                onRun(tailStart, chunkSize - tailStart, chunkSize - tailStart, false);
+        }
+
+    }
+
+    StringExtractor::ChunkResult StringExtractor::scanChunk(u64 address, std::span<const u8> data, size_t chunkSize) const {
+        ChunkResult result;
+        bool firstRun = true;
+
+        // A run that starts within the first character of the chunk may be the continuation of one from the previous chunk
+        auto onRun = [&](size_t offset, size_t size, size_t length, bool closed) {
+            const Run run = { address + offset, size, length };
+
+            if (firstRun && offset < this->getMaxCharacterSize()) {
+                result.head = run;
+                result.headClosed = closed;
+            } else if (!closed) {
+                result.tail = run;
+            } else if (length >= this->m_minimumLength) {
+                result.strings.push_back({ run.address, run.size });
+            }
+
+            firstRun = false;
+        };
+
+        // Characters have to start inside of the chunk but may extend into the data following it
+        chunkSize = std::min(chunkSize, data.size());
+
+        switch (this->m_encoding) {
+            case Encoding::ASCII:
+                scanAsciiRuns(data.data(), chunkSize, this->m_minimumLength, onRun);
+                break;
+            case Encoding::UTF8:
+                scanRuns(data, chunkSize, [](const u8 *bytes, size_t available) -> size_t {
+                    const u8 c = bytes[0];
+
+                    if (isPrintable(c)) [[likely]]
+                        return 1;
+
+                    // Only well-formed sequences count, overlong encodings, surrogates and C1 control characters don't
+                    if (c >= 0xC2 && c <= 0xDF) {
+                        if (available >= 2 && isContinuation(bytes[1]) && !(c == 0xC2 && bytes[1] < 0xA0))
+                            return 2;
+                    } else if (c >= 0xE0 && c <= 0xEF) {
+                        if (available >= 3 && isContinuation(bytes[1]) && isContinuation(bytes[2]) && !(c == 0xE0 && bytes[1] < 0xA0) && !(c == 0xED && bytes[1] >= 0xA0))
+                            return 3;
+                    } else if (c >= 0xF0 && c <= 0xF4) {
+                        if (available >= 4 && isContinuation(bytes[1]) && isContinuation(bytes[2]) && isContinuation(bytes[3]) && !(c == 0xF0 && bytes[1] < 0x90) && !(c == 0xF4 && bytes[1] >= 0x90))
+                            return 4;
+                    }
+
+                    return 0;
+                }, onRun);
+                break;
+            case Encoding::UTF16LE:
+                scanRuns(data, chunkSize, [](const u8 *bytes, size_t available) -> size_t { return (available >= 2 && isPrintable(bytes[0]) && bytes[1] == 0x00) ? 2 : 0; }, onRun);
+                break;
+            case Encoding::UTF16BE:
+                scanRuns(data, chunkSize, [](const u8 *bytes, size_t available) -> size_t { return (available >= 2 && bytes[0] == 0x00 && isPrintable(bytes[1])) ? 2 : 0; }, onRun);
+                break;
+            case Encoding::Custom:
+                scanRuns(data, chunkSize, [this](const u8 *bytes, size_t available) -> size_t {
+                    auto encoding = this->m_encodingFile.findEncodingFor({ bytes, std::min(available, this->getMaxCharacterSize()) });
+
+                    return encoding.has_value() ? encoding->second : 0;
+                }, onRun);
+                break;
+        }
+
+        return result;
+    }
+
+    std::vector<StringExtractor::Result> StringExtractor::stitch(const std::vector<ChunkResult> &chunks) const {
+        std::vector<Result> results;
+        std::optional<Run> carry;
+
+        auto addRun = [&](const Run &run) {
+            if (run.length >= this->m_minimumLength)
+                results.push_back({ run.address, run.size });
+        };
+
+        for (const auto &chunk : chunks) {
+            if (chunk.head.has_value()) {
+                Run run = *chunk.head;
+
+                if (carry.has_value() && carry->address + carry->size == run.address)
+                    run = Run { carry->address, carry->size + run.size, carry->length + run.length };
+                else if (carry.has_value())
+                    addRun(*carry);
+
+                carry.reset();
+
+                // The string covers the entire chunk and may continue in the next one
+                if (!chunk.headClosed) {
+                    carry = run;
+                    continue;
+                }
+
+                addRun(run);
+            } else if (carry.has_value()) {
+                addRun(*carry);
+                carry.reset();
+            }
+
+            std::copy(chunk.strings.begin(), chunk.strings.end(), std::back_inserter(results));
+            carry = chunk.tail;
+        }
+
+        if (carry.has_value())
+            addRun(*carry);
+
+        return results;
+    }
+
+    std::vector<StringExtractor::Result> StringExtractor::extract(std::span<const u8> data) const {
+        return this->stitch({ this->scanChunk(0, data, data.size()) });
+    }
+
+    std::vector<StringExtractor::Result> StringExtractor::extract(prv::Provider *provider, u64 address, size_t size, const ProgressCallback &progress, u32 threadCount, const std::stop_token &stopToken) const {
+        const u64 endAddress = address + size;
+        const size_t chunkCount = (size + ChunkSize - 1) / ChunkSize;
+        const size_t lookahead = this->getMaxCharacterSize() - 1;
+
+        // Backends that can't hand out their data directly usually don't support being read from multiple threads either
+        if (threadCount == 0)
+            threadCount = provider->getRawSpan(0, 1).has_value() ? std::max(std::thread::hardware_concurrency(), 1U) : 1;
+        threadCount = std::min<size_t>(threadCount, chunkCount);
+
+        std::vector<ChunkResult> chunks(chunkCount);
+        std::atomic<size_t> nextChunk = 0;
+        std::atomic<u64> processedSize = 0;
+
+        auto scanChunks = [&](bool reportProgress) {
+            for (size_t index = nextChunk++; index < chunkCount && !stopToken.stop_requested(); index = nextChunk++) {
+                const u64 chunkAddress = address + index * ChunkSize;
+                const size_t chunkSize = std::min<u64>(ChunkSize, endAddress - chunkAddress);
+                const size_t readSize  = std::min<u64>(chunkSize + lookahead, endAddress - chunkAddress);
+
+                provider->readChunks(chunkAddress, readSize, [&](u64, std::span<const u8> data) {
+                    chunks[index] = this->scanChunk(chunkAddress, data, chunkSize);
+                }, readSize);
+
+                processedSize += chunkSize;
+                if (reportProgress && progress)
+                    progress(processedSize);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (u32 i = 1; i < threadCount; i++)
+            workers.emplace_back(scanChunks, false);
+
+        scanChunks(true);
+
+        for (auto &worker : workers)
+            worker.join();
+
+        return this->stitch(chunks);
+    }
+
+    std::string StringExtractor::decode(std::span<const u8> data) const {
+        std::string result;
+
+        switch (this->m_encoding) {
+            case Encoding::ASCII:
+            case Encoding::UTF8:
+                result.assign(data.begin(), data.end());
+                break;
+            case Encoding::UTF16LE:
+            case Encoding::UTF16BE:
+                for (size_t i = this->m_encoding == Encoding::UTF16LE ? 0 : 1; i < data.size(); i += 2)
+                    result += char(data[i]);
+                break;
+            case Encoding::Custom:
+                this->m_encodingFile.decode(data, result);
+                break;
+        }
+
+        return result;
+    }
+
+}
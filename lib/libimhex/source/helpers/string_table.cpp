@@ -0,0 +1,252 @@
+#include <hex/helpers/string_table.hpp>
+
+#include <hex/helpers/search.hpp>
+
+#include <algorithm>
+#include <cctype>
+
+namespace hex {
+
+    void StringTable::add(std::string_view string) {
+        this->m_data.append(string);
+        this->m_data.push_back('\x00');
+        this->m_offsets.push_back(this->m_data.size());
+    }
+
+    void StringTable::reserve(size_t count, size_t size) {
+        this->m_data.reserve(size + count);
+        this->m_offsets.reserve(count + 1);
+    }
+
+    void StringTable::clear() {
+        this->m_data.clear();
+        this->m_offsets = { 0 };
+    }
+
+    std::string_view StringTable::get(size_t index) const {
+        const auto begin = this->m_offsets[index], end = this->m_offsets[index + 1] - 1;
+
+        return { this->m_data.data() + begin, end - begin };
+    }
+
+
+    std::optional<StringFilter> StringFilter::create(std::string_view filter, bool regex) {
+        StringFilter result;
+        result.m_filter = filter;
+
+        if (regex) {
+            try {
+                result.m_regex = std::regex(result.m_filter, std::regex::ECMAScript | std::regex::optimize);
+            } catch (const std::regex_error &e) {
+                return std::nullopt;
+            }
+
+            result.m_literal = findRequiredLiteral(filter);
+        } else {
+            result.m_literal = filter;
+        }
+
+        return result;
+    }
+
+    std::string StringFilter::findRequiredLiteral(std::string_view pattern) {
+        // Alternations could make any part of the pattern optional
+        if (pattern.find('|') != std::string_view::npos)
+            return "";
+
+        std::string longest, current;
+        bool lastWasLiteral = false;
+
+        auto endRun = [&] {
+            if (current.size() > longest.size())
+                longest = current;
+
+            current.clear();
+            lastWasLiteral = false;
+        };
+
+        // Skip over bracket expressions and groups, i points to the opening character and the closing one is returned
+        auto skipBracket = [&](size_t i) {
+            for (i++; i < pattern.size(); i++) {
+                if (pattern[i] == '\\')
+                    i++;
+                else if (pattern[i] == ']')
+                    break;
+            }
+
+            return i;
+        };
+
+        auto skipGroup = [&](size_t i) {
+            u32 depth = 0;
+            for (; i < pattern.size(); i++) {
+                if (pattern[i] == '\\')
+                    i++;
+                else if (pattern[i] == '[')
+                    i = skipBracket(i);
+                else if (pattern[i] == '(')
+                    depth++;
+                else if (pattern[i] == ')' && --depth == 0)
+                    break;
+            }
+
+            return i;
+        };
+
+        // Skip over escapes and their operands, i points to the backslash and the last character of the escape is returned
+        auto skipEscape = [&](size_t i) {
+            i++;
+            if (i >= pattern.size())
+                return i;
+
+            const char c = pattern[i];
+            if ((c == 'x' || c == 'u') && i + 1 < pattern.size() && pattern[i + 1] == '{')
+                return std::min(pattern.find('}', i), pattern.size());
+
+            switch (c) {
+                case 'x': return std::min(i + 2, pattern.size());
+                case 'u': return std::min(i + 4, pattern.size());
+                case 'c': return std::min(i + 1, pattern.size());
+                default:
+                    // Back references may have more than one digit
+                    if (std::isdigit(static_cast<unsigned char>(c))) {
+                        while (i + 1 < pattern.size() && std::isdigit(static_cast<unsigned char>(pattern[i + 1])))
+                            i++;
+                    }
+
+                    return i;
+            }
+        };
+
+        for (size_t i = 0; i < pattern.size(); i++) {
+            const char c = pattern[i];
+
+            switch (c) {
+                case '\\':
+                    // Escaped punctuation is a literal character, everything else is a character class, an assertion, a back reference or a character code
+                    if (i + 1 < pattern.size() && std::ispunct(static_cast<unsigned char>(pattern[i + 1]))) {
+                        current += pattern[++i];
+                        lastWasLiteral = true;
+                    } else {
+                        endRun();
+                        i = skipEscape(i);
+                    }
+                    break;
+                case '[':
+                    endRun();
+                    i = skipBracket(i);
+                    break;
+                case '(':
+                    endRun();
+                    i = skipGroup(i);
+                    break;
+                case '*':
+                case '?':
+                case '{':
+                    // The previous character is optional
+                    if (lastWasLiteral)
+                        current.pop_back();
+                    endRun();
+
+                    if (c == '{')
+                        i = std::min(pattern.find('}', i), pattern.size());
+                    if (i + 1 < pattern.size() && pattern[i + 1] == '?')
+                        i++;
+                    break;
+                case '+':
+                    // The previous character has to be there at least once but may repeat
+                    endRun();
+                    if (i + 1 < pattern.size() && pattern[i + 1] == '?')
+                        i++;
+                    break;
+                case '.':
+                case '^':
+                case '$':
+                    endRun();
+                    break;
+                default:
+                    current += c;
+                    lastWasLiteral = true;
+                    break;
+            }
+        }
+
+        endRun();
+
+        return longest;
+    }
+
+    bool StringFilter::matches(std::string_view string) const {
+        if (!this->m_literal.empty() && string.find(this->m_literal) == std::string_view::npos)
+            return false;
+
+        if (this->m_regex.has_value())
+            return std::regex_search(string.begin(), string.end(), *this->m_regex);
+
+        return true;
+    }
+
+    bool StringFilter::narrows(const StringFilter &other) const {
+        if (!other.m_regex.has_value() && other.m_literal.empty())
+            return true;
+
+        if (this->m_regex.has_value() || other.m_regex.has_value())
+            return this->m_regex.has_value() == other.m_regex.has_value() && this->m_filter == other.m_filter;
+
+        return this->m_literal.find(other.m_literal) != std::string::npos;
+    }
+
+    std::optional<std::vector<size_t>> StringFilter::apply(const StringTable &table, const std::optional<std::vector<size_t>> &candidates, const std::stop_token &stopToken) const {
+        std::vector<size_t> result;
+
+        const bool searchTable = !candidates.has_value() && !this->m_literal.empty() && this->m_literal.find('\x00') == std::string::npos;
+        if (!searchTable) {
+            const size_t count = candidates.has_value() ? candidates->size() : table.size();
+            for (size_t i = 0; i < count; i++) {
+                if ((i % 0x1000) == 0 && stopToken.stop_requested())
+                    return std::nullopt;
+
+                const size_t index = candidates.has_value() ? (*candidates)[i] : i;
+                if (this->matches(table.get(index)))
+                    result.push_back(index);
+            }
+
+            return result;
+        }
+
+        // Look for the literal in the whole buffer and map the matches back to the strings they're in
+        const auto pattern = SearchPattern::fromString(this->m_literal);
+        const auto &data = table.getData();
+
+        size_t index = 0;
+        std::optional<size_t> lastChecked;
+        while (index < table.size()) {
+            if (stopToken.stop_requested())
+                return std::nullopt;
+
+            const size_t blockStart = table.getOffset(index);
+
+            size_t blockEnd = index + 1;
+            while (blockEnd < table.size() && table.getOffset(blockEnd + 1) - blockStart <= BlockSize)
+                blockEnd++;
+
+            size_t curr = index;
+            pattern->search({ reinterpret_cast<const u8*>(data.data()) + blockStart, table.getOffset(blockEnd) - blockStart }, [&](u64 offset) {
+                while (table.getOffset(curr + 1) <= blockStart + offset)
+                    curr++;
+
+                if (lastChecked == curr)
+                    return;
+                lastChecked = curr;
+
+                if (!this->m_regex.has_value() || std::regex_search(table.get(curr).begin(), table.get(curr).end(), *this->m_regex))
+                    result.push_back(curr);
+            });
+
+            index = blockEnd;
+        }
+
+        return result;
+    }
+
+}
@@ -0,0 +1,88 @@
+#include <hex/pattern_language/bytecode.hpp>
+
+#include <hex/pattern_language/ast_node.hpp>
+
+namespace hex::pl {
+
+    Bytecode Bytecode::compile(const ASTNode *expression) {
+        Bytecode bytecode;
+
+        bytecode.compileNode(expression);
+
+        return bytecode;
+    }
+
+    void Bytecode::compileNode(const ASTNode *node) {
+        // Operands are compiled in the same order the tree walker evaluates them in so side effects of function calls stay the same
+        if (dynamic_cast<const ASTNodeLiteral*>(node) != nullptr) {
+            this->m_instructions.push_back({ OpCode::PushLiteral, node });
+        } else if (dynamic_cast<const ASTNodeRValue*>(node) != nullptr) {
+            this->m_instructions.push_back({ OpCode::LoadVariable, node });
+        } else if (auto mathNode = dynamic_cast<const ASTNodeMathematicalExpression*>(node); mathNode != nullptr && mathNode->getLeftOperand() != nullptr && mathNode->getRightOperand() != nullptr) {
+            this->compileNode(mathNode->getLeftOperand());
+            this->compileNode(mathNode->getRightOperand());
+            this->m_instructions.push_back({ OpCode::Operator, node });
+        } else if (auto ternaryNode = dynamic_cast<const ASTNodeTernaryExpression*>(node); ternaryNode != nullptr && ternaryNode->getFirstOperand() != nullptr && ternaryNode->getSecondOperand() != nullptr && ternaryNode->getThirdOperand() != nullptr) {
+            this->compileNode(ternaryNode->getFirstOperand());
+            this->compileNode(ternaryNode->getSecondOperand());
+            this->compileNode(ternaryNode->getThirdOperand());
+            this->m_instructions.push_back({ OpCode::Ternary, node });
+        } else if (auto castNode = dynamic_cast<const ASTNodeCast*>(node); castNode != nullptr) {
+            this->compileNode(castNode->getValue());
+            this->m_instructions.push_back({ OpCode::Cast, node });
+        } else {
+            this->m_instructions.push_back({ OpCode::Evaluate, node });
+        }
+    }
+
+    Token::Literal Bytecode::execute(Evaluator *evaluator) const {
+        // Programs can run recursively through function calls, so each one only uses the part of the stack above where it started
+        auto &stack = evaluator->getBytecodeStack();
+        const auto stackBase = stack.size();
+        ON_SCOPE_EXIT { stack.resize(stackBase); };
+
+        for (const auto &[opCode, node] : this->m_instructions) {
+            switch (opCode) {
+                case OpCode::PushLiteral:
+                    stack.push_back(static_cast<const ASTNodeLiteral*>(node)->getValue());
+                    break;
+                case OpCode::LoadVariable:
+                    stack.push_back(static_cast<const ASTNodeRValue*>(node)->evaluateValue(evaluator));
+                    break;
+                case OpCode::Operator: {
+                    auto result = static_cast<const ASTNodeMathematicalExpression*>(node)->evaluateOperator(stack[stack.size() - 2], stack[stack.size() - 1]);
+                    stack.pop_back();
+                    stack.back() = std::move(result);
+                    break;
+                }
+                case OpCode::Ternary: {
+                    auto result = static_cast<const ASTNodeTernaryExpression*>(node)->evaluateOperator(stack[stack.size() - 3], stack[stack.size() - 2], stack[stack.size() - 1]);
+                    stack.resize(stack.size() - 2);
+                    stack.back() = std::move(result);
+                    break;
+                }
+                case OpCode::Cast: {
+                    auto value = std::move(stack.back());
+                    stack.pop_back();
+
+                    stack.push_back(static_cast<const ASTNodeCast*>(node)->evaluateCast(evaluator, value));
+                    break;
+                }
+                case OpCode::Evaluate: {
+                    auto result = node->evaluate(evaluator);
+                    ON_SCOPE_EXIT { delete result; };
+
+                    auto literal = dynamic_cast<ASTNodeLiteral*>(result);
+                    if (literal == nullptr)
+                        LogConsole::abortEvaluation("attempted to use void expression in mathematical expression", node);
+
+                    stack.push_back(literal->getValue());
+                    break;
+                }
+            }
+        }
+
+        return std::move(stack.back());
+    }
+
+}
@@ -1,6 +1,12 @@
 #include <hex/pattern_language/evaluator.hpp>
 #include <hex/pattern_language/ast_node.hpp>
 
+#include <hex/helpers/shared_data.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
 namespace hex::pl {
 
     void Evaluator::createVariable(const std::string &name, ASTNode *type, const std::optional<Token::Literal> &value, bool outVariable) {
@@ -78,6 +84,19 @@ namespace hex::pl {
         if (pattern == nullptr)
             LogConsole::abortEvaluation(hex::format("no variable with name '{}' found", name));
 
+        this->setVariable(pattern, value);
+    }
+
+    PatternData* Evaluator::getLocalVariable(u32 slot, const std::string &name) {
+        auto &variables = *this->getScope(0).scope;
+
+        if (slot < variables.size() && variables[slot]->getVariableName() == name)
+            return variables[slot];
+        else
+            return nullptr;
+    }
+
+    void Evaluator::setVariable(PatternData *pattern, const Token::Literal& value) {
         Token::Literal castedLiteral = std::visit(overloaded {
                 [&](double &value) -> Token::Literal {
                     if (dynamic_cast<PatternDataUnsigned*>(pattern))
@@ -122,34 +141,237 @@ namespace hex::pl {
     }
 
     std::optional<std::vector<PatternData*>> Evaluator::evaluate(const std::vector<ASTNode*> &ast) {
+        // Placed patterns of the last run belong to the caller now and may already be gone, only the global local variables are still owned by the evaluator
+        for (auto &pattern : this->m_ownedPatterns)
+            delete pattern;
+        this->m_ownedPatterns.clear();
+        this->m_globalPatterns.clear();
+        this->m_checkpoints.clear();
+
         this->m_stack.clear();
         this->m_customFunctions.clear();
+        this->m_customFunctionNames.clear();
+
+        this->dataOffset() = 0x00;
+        this->m_currPatternCount = 0;
+
+        for (auto &func : this->m_customFunctionDefinitions)
+            delete func;
+        this->m_customFunctionDefinitions.clear();
+
+        return this->evaluateStatements(ast, 0, 0);
+    }
+
+    std::optional<std::vector<PatternData*>> Evaluator::reevaluate(const std::vector<ASTNode*> &ast, const std::vector<Region> &changedRegions) {
+        // The caller handed the placed patterns back, so all global patterns are owned by the evaluator again
+        this->m_ownedPatterns.clear();
+
+        if (this->m_checkpoints.size() != ast.size() + 1) {
+            this->discardResult();
+            return this->evaluate(ast);
+        }
+
+        // Changed regions are sorted and don't overlap so their ends are sorted as well
+        auto readsChangedData = [&changedRegions](const std::vector<Region> &reads) {
+            return std::any_of(reads.begin(), reads.end(), [&changedRegions](const Region &read) {
+                auto change = std::upper_bound(changedRegions.begin(), changedRegions.end(), read.address, [](u64 address, const Region &region) {
+                    return address < region.address + region.size;
+                });
+
+                return change != changedRegions.end() && change->address < read.address + read.size;
+            });
+        };
+
+        auto firstChanged = std::find_if(this->m_checkpoints.begin(), this->m_checkpoints.end(), [&](const Checkpoint &checkpoint) {
+            return readsChangedData(checkpoint.reads);
+        });
+
+        // Nothing that decided the layout of the patterns changed, their values are read from the provider when they're displayed anyways
+        if (firstChanged == this->m_checkpoints.end()) {
+            this->m_envVariables.clear();
+
+            return this->handOutResult();
+        }
+
+        const auto firstStatement = std::distance(this->m_checkpoints.begin(), firstChanged);
+        auto checkpoint = std::move(*firstChanged);
+        this->m_checkpoints.erase(firstChanged, this->m_checkpoints.end());
+
+        // Patterns that are kept need to replace the old ones wherever they're displayed before the rest gets destroyed, even if none are kept
+        if (this->m_partialResultCallback)
+            this->m_partialResultCallback({ this->m_globalPatterns.begin(), this->m_globalPatterns.begin() + checkpoint.globalPatternCount });
+
+        for (auto pattern = this->m_globalPatterns.begin() + checkpoint.globalPatternCount; pattern != this->m_globalPatterns.end(); pattern++)
+            delete *pattern;
+        this->m_globalPatterns.resize(checkpoint.globalPatternCount);
+
+        for (auto definition = this->m_customFunctionDefinitions.begin() + checkpoint.functionDefinitionCount; definition != this->m_customFunctionDefinitions.end(); definition++)
+            delete *definition;
+        this->m_customFunctionDefinitions.resize(checkpoint.functionDefinitionCount);
+
+        for (auto name = this->m_customFunctionNames.begin() + checkpoint.functionCount; name != this->m_customFunctionNames.end(); name++)
+            this->m_customFunctions.erase(*name);
+        this->m_customFunctionNames.resize(checkpoint.functionCount);
+
+        this->m_stack = std::move(checkpoint.stack);
+        this->dataOffset() = checkpoint.dataOffset;
+        this->m_currPatternCount = checkpoint.patternCount;
+        this->m_console.truncate(checkpoint.consoleLogSize);
+        SharedData::patternPaletteOffset = checkpoint.paletteOffset;
+
+        return this->evaluateStatements(ast, firstStatement, this->m_partialResultCallback ? checkpoint.globalPatternCount : 0);
+    }
+
+    void Evaluator::discardResult() {
+        if (this->m_partialResultCallback && !this->m_globalPatterns.empty())
+            this->m_partialResultCallback({ });
+
+        this->m_ownedPatterns.clear();
+
+        for (auto &pattern : this->m_globalPatterns)
+            delete pattern;
+        this->m_globalPatterns.clear();
+        this->m_checkpoints.clear();
+    }
+
+    void Evaluator::createCheckpoint() {
+        this->m_checkpoints.push_back({
+            this->m_globalPatterns.size(),
+            this->m_stack,
+            this->dataOffset(),
+            this->m_currPatternCount,
+            this->m_customFunctionNames.size(),
+            this->m_customFunctionDefinitions.size(),
+            this->m_console.getLog().size(),
+            SharedData::patternPaletteOffset,
+            { }
+        });
+
+        this->m_currReads.clear();
+    }
+
+    void Evaluator::readData(u64 address, void *buffer, size_t size) {
+        this->addReadRegion(address, size);
+
+        // The data may change between runs and outside of one nothing invalidates the cache
+        if (this->m_evaluating)
+            this->readCached(address, buffer, size);
+        else
+            this->getProvider()->read(address, buffer, size);
+    }
+
+    void Evaluator::invalidateReadCache() {
+        this->m_readPages.clear();
+        this->m_lastReadPage = 0;
+        this->m_nextReadPage = 0;
+    }
+
+    void Evaluator::readCached(u64 address, void *buffer, size_t size) {
+        // Most reads continue right where the last one ended and can be answered without asking the provider anything
+        if (this->m_lastReadPage < this->m_readPages.size()) {
+            const auto &page = this->m_readPages[this->m_lastReadPage];
+            if (address >= page.address && address - page.address + size <= page.size) {
+                std::memcpy(buffer, page.data.data() + (address - page.address), size);
+                return;
+            }
+        }
+
+        auto provider = this->getProvider();
+        const u64 baseAddress = provider->getBaseAddress();
+        const size_t actualSize = provider->getActualSize();
+
+        // Reads the provider would reject and ones too large to benefit from the cache go straight to it
+        if (size == 0 || size > ReadPageSize || size > actualSize || (address - baseAddress) > (actualSize - size)) {
+            provider->read(address, buffer, size);
+            return;
+        }
+
+        auto findPage = [&, this](u64 pageAddress) -> ReadPage& {
+            if (this->m_lastReadPage < this->m_readPages.size() && this->m_readPages[this->m_lastReadPage].address == pageAddress)
+                return this->m_readPages[this->m_lastReadPage];
+
+            for (size_t i = 0; i < this->m_readPages.size(); i++) {
+                if (this->m_readPages[i].address == pageAddress) {
+                    this->m_lastReadPage = i;
+                    return this->m_readPages[i];
+                }
+            }
+
+            if (this->m_readPages.size() < ReadPageCount) {
+                this->m_readPages.push_back({ 0, 0, std::vector<u8>(ReadPageSize) });
+                this->m_lastReadPage = this->m_readPages.size() - 1;
+            } else {
+                this->m_lastReadPage = this->m_nextReadPage;
+                this->m_nextReadPage = (this->m_nextReadPage + 1) % ReadPageCount;
+            }
+
+            auto &page = this->m_readPages[this->m_lastReadPage];
+            page.address = pageAddress;
+            page.size    = std::min<u64>(ReadPageSize, baseAddress + actualSize - pageAddress);
+            provider->read(page.address, page.data.data(), page.size);
+
+            return page;
+        };
+
+        // Pages are aligned relative to the start of the data, a read can span at most two of them
+        auto bytes = static_cast<u8*>(buffer);
+        u64 curr = address;
+        while (size > 0) {
+            const u64 pageAddress = baseAddress + ((curr - baseAddress) & ~u64(ReadPageSize - 1));
+            auto &page = findPage(pageAddress);
+
+            const size_t pageOffset = curr - page.address;
+            const size_t copySize   = std::min<u64>(size, page.size - pageOffset);
+            std::memcpy(bytes, page.data.data() + pageOffset, copySize);
+
+            bytes += copySize;
+            curr  += copySize;
+            size  -= copySize;
+        }
+    }
+
+    void Evaluator::addReadRegion(u64 address, size_t size) {
+        // Formatters run on the UI thread after evaluation finished and can't affect the patterns anymore
+        if (!this->m_evaluating || size == 0)
+            return;
+
+        // Most reads continue where the last one ended, merge them so reading a large array doesn't need an entry per element
+        if (!this->m_currReads.empty()) {
+            auto &last = this->m_currReads.back();
+            if (address >= last.address && address <= last.address + last.size) {
+                last.size = std::max<u64>(last.size, address + size - last.address);
+                return;
+            }
+        }
+
+        this->m_currReads.push_back({ address, size });
+    }
+
+    std::optional<std::vector<PatternData*>> Evaluator::evaluateStatements(const std::vector<ASTNode*> &ast, size_t firstStatement, size_t publishedPatternCount) {
         this->m_scopes.clear();
-        this->m_aborted = false;
 
         if (this->m_allowDangerousFunctions == DangerousFunctionPermission::Deny)
             this->m_allowDangerousFunctions = DangerousFunctionPermission::Ask;
 
         this->m_dangerousFunctionCalled = false;
 
+        this->invalidateReadCache();
+        this->m_evaluating = true;
         ON_SCOPE_EXIT {
             this->m_envVariables.clear();
+            this->m_evaluating = false;
         };
 
-        this->dataOffset() = 0x00;
-        this->m_currPatternCount = 0;
-
-        for (auto &func : this->m_customFunctionDefinitions)
-            delete func;
-        this->m_customFunctionDefinitions.clear();
-
-        std::vector<PatternData*> patterns;
+        auto &patterns = this->m_globalPatterns;
 
         try {
             this->setCurrentControlFlowStatement(ControlFlowStatement::None);
             pushScope(nullptr, patterns);
 
-            for (auto node : ast) {
+            for (auto statement = firstStatement; statement < ast.size(); statement++) {
+                auto node = ast[statement];
+                this->createCheckpoint();
+
                 if (dynamic_cast<ASTNodeTypeDecl*>(node)) {
                     ;// Don't create patterns from type declarations
                 } else if (dynamic_cast<ASTNodeFunctionCall*>(node)) {
@@ -177,8 +399,17 @@ namespace hex::pl {
                     auto newPatterns = node->createPatterns(this);
                     patterns.insert(patterns.end(), newPatterns.begin(), newPatterns.end());
                 }
+
+                this->m_checkpoints.back().reads = std::move(this->m_currReads);
+
+                if (this->m_partialResultCallback && patterns.size() != publishedPatternCount) {
+                    publishedPatternCount = patterns.size();
+                    this->m_partialResultCallback(patterns);
+                }
             }
 
+            this->createCheckpoint();
+
             if (this->m_customFunctions.contains("main")) {
                 auto mainFunction = this->m_customFunctions["main"];
 
@@ -194,6 +425,8 @@ namespace hex::pl {
                 }
             }
 
+            this->m_checkpoints.back().reads = std::move(this->m_currReads);
+
             popScope();
         } catch (const LogConsole::EvaluateError &error) {
             this->m_console.log(LogConsole::Level::Error, error.second);
@@ -201,21 +434,37 @@ namespace hex::pl {
             if (error.first != 0)
                 this->m_console.setHardError(error);
 
+            if (this->m_partialResultCallback && publishedPatternCount > 0)
+                this->m_partialResultCallback({ });
+
             for (auto &pattern : patterns)
                 delete pattern;
             patterns.clear();
+            this->m_ownedPatterns.clear();
 
+            this->m_checkpoints.clear();
+            this->m_currReads.clear();
             this->m_currPatternCount = 0;
 
             return std::nullopt;
         }
 
-        // Remove global local variables
-        std::erase_if(patterns, [](PatternData *pattern) {
-            return pattern->isLocal();
-        });
+        return this->handOutResult();
+    }
+
+    std::vector<PatternData*> Evaluator::handOutResult() {
+        // Global local variables stay in the global scope so a later run can continue from any statement
+        std::vector<PatternData*> result;
+
+        this->m_ownedPatterns.clear();
+        for (auto pattern : this->m_globalPatterns) {
+            if (pattern->isLocal())
+                this->m_ownedPatterns.push_back(pattern);
+            else
+                result.push_back(pattern);
+        }
 
-        return patterns;
+        return result;
     }
 
     void Evaluator::patternCreated() {
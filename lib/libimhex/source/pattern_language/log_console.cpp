@@ -29,4 +29,10 @@ namespace hex::pl {
         this->m_lastHardError = { };
     }
 
+    void LogConsole::truncate(size_t size) {
+        if (size < this->m_consoleLog.size())
+            this->m_consoleLog.erase(this->m_consoleLog.begin() + size, this->m_consoleLog.end());
+        this->m_lastHardError = { };
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include <hex/pattern_language/pattern_index.hpp>
+
+#include <hex/pattern_language/pattern_data.hpp>
+
+#include <algorithm>
+
+namespace hex::pl {
+
+    PatternIndex::PatternIndex(const std::vector<PatternData*> &patterns) {
+        std::map<u64, Segment> segments;
+
+        for (auto pattern : patterns)
+            this->addPattern(segments, pattern, 0, false);
+
+        this->m_segments.reserve(segments.size());
+        for (const auto &[start, segment] : segments)
+            this->m_segments.push_back(segment);
+    }
+
+    PatternIndex::PatternIndex(const std::vector<std::pair<Region, u32>> &regions) {
+        std::map<u64, Segment> segments;
+
+        for (const auto &[region, color] : regions) {
+            if (region.size > 0)
+                addSegment(segments, { region.address, region.address + region.size, color, NoTemplate, 0, 0 });
+        }
+
+        this->m_segments.reserve(segments.size());
+        for (const auto &[start, segment] : segments)
+            this->m_segments.push_back(segment);
+    }
+
+    void PatternIndex::addPattern(std::map<u64, Segment> &segments, PatternData *pattern, u64 origin, bool inTemplate) {
+        if (pattern == nullptr || pattern->isHidden() || pattern->getSize() == 0)
+            return;
+
+        const u64 start = pattern->getOffset() - origin;
+
+        if (auto structPattern = dynamic_cast<PatternDataStruct*>(pattern)) {
+            for (auto member : structPattern->getMembers())
+                this->addPattern(segments, member, origin, inTemplate);
+        } else if (auto unionPattern = dynamic_cast<PatternDataUnion*>(pattern)) {
+            for (auto member : unionPattern->getMembers())
+                this->addPattern(segments, member, origin, inTemplate);
+        } else if (auto dynamicArrayPattern = dynamic_cast<PatternDataDynamicArray*>(pattern)) {
+            for (auto entry : dynamicArrayPattern->getEntries())
+                this->addPattern(segments, entry, origin, inTemplate);
+        } else if (auto staticArrayPattern = dynamic_cast<PatternDataStaticArray*>(pattern)) {
+            auto entry = staticArrayPattern->getTemplate();
+            if (entry == nullptr || entry->getSize() == 0 || entry->isHidden())
+                return;
+
+            const bool isLeaf = dynamic_cast<PatternDataStruct*>(entry) == nullptr &&
+                                dynamic_cast<PatternDataUnion*>(entry) == nullptr &&
+                                dynamic_cast<PatternDataDynamicArray*>(entry) == nullptr &&
+                                dynamic_cast<PatternDataStaticArray*>(entry) == nullptr &&
+                                dynamic_cast<PatternDataPointer*>(entry) == nullptr;
+
+            if (isLeaf) {
+                addSegment(segments, { start, start + pattern->getSize(), entry->getColor(), NoTemplate, 0, 0 });
+            } else {
+                PatternIndex templateIndex;
+                std::map<u64, Segment> templateSegments;
+                templateIndex.addPattern(templateSegments, entry, entry->getOffset(), true);
+                for (const auto &[segmentStart, segment] : templateSegments)
+                    templateIndex.m_segments.push_back(segment);
+
+                this->m_templates.push_back(std::move(templateIndex));
+                addSegment(segments, { start, start + pattern->getSize(), 0, u32(this->m_templates.size() - 1), start, entry->getSize() });
+            }
+        } else if (auto pointerPattern = dynamic_cast<PatternDataPointer*>(pattern)) {
+            addSegment(segments, { start, start + pattern->getSize(), pattern->getColor(), NoTemplate, 0, 0 });
+
+            // What a pointer inside of a template points to is different for every entry
+            if (!inTemplate)
+                this->addPattern(segments, pointerPattern->getPointedAtPattern(), origin, inTemplate);
+        } else {
+            addSegment(segments, { start, start + pattern->getSize(), pattern->getColor(), NoTemplate, 0, 0 });
+        }
+    }
+
+    void PatternIndex::addSegment(std::map<u64, Segment> &segments, const Segment &segment) {
+        // Only fill the parts of the range that aren't covered by a segment yet
+        u64 curr = segment.start;
+
+        if (auto next = segments.upper_bound(curr); next != segments.begin()) {
+            auto prev = std::prev(next);
+            curr = std::max(curr, prev->second.end);
+        }
+
+        while (curr < segment.end) {
+            auto next = segments.lower_bound(curr);
+            const u64 gapEnd = next == segments.end() ? segment.end : std::min(segment.end, next->first);
+
+            if (curr < gapEnd) {
+                auto part = segment;
+                part.start = curr;
+                part.end = gapEnd;
+                segments.emplace(curr, part);
+            }
+
+            if (next == segments.end() || next->first >= segment.end)
+                break;
+
+            curr = next->second.end;
+        }
+    }
+
+    const PatternIndex::Segment* PatternIndex::findSegment(u64 address) const {
+        if (this->m_segments.empty())
+            return nullptr;
+
+        auto contains = [address](const Segment &segment) {
+            return address >= segment.start && address < segment.end;
+        };
+
+        if (this->m_lastSegment < this->m_segments.size()) {
+            if (contains(this->m_segments[this->m_lastSegment]))
+                return &this->m_segments[this->m_lastSegment];
+
+            if (this->m_lastSegment + 1 < this->m_segments.size() && contains(this->m_segments[this->m_lastSegment + 1])) {
+                this->m_lastSegment++;
+                return &this->m_segments[this->m_lastSegment];
+            }
+        }
+
+        auto next = std::upper_bound(this->m_segments.begin(), this->m_segments.end(), address, [](u64 address, const Segment &segment) {
+            return address < segment.start;
+        });
+
+        if (next == this->m_segments.begin())
+            return nullptr;
+
+        auto segment = std::prev(next);
+        if (!contains(*segment))
+            return nullptr;
+
+        this->m_lastSegment = std::distance(this->m_segments.begin(), segment);
+        return &*segment;
+    }
+
+    std::optional<u32> PatternIndex::getColor(u64 address) const {
+        auto segment = this->findSegment(address);
+        if (segment == nullptr)
+            return std::nullopt;
+
+        if (segment->templateIndex == NoTemplate)
+            return segment->color;
+        else
+            return this->m_templates[segment->templateIndex].getColor((address - segment->base) % segment->stride);
+    }
+
+}
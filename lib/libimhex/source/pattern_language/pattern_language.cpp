@@ -8,8 +8,12 @@
 #include <hex/pattern_language/lexer.hpp>
 #include <hex/pattern_language/parser.hpp>
 #include <hex/pattern_language/validator.hpp>
+#include <hex/pattern_language/resolver.hpp>
 #include <hex/pattern_language/evaluator.hpp>
 
+#include <algorithm>
+#include <functional>
+
 #include <unistd.h>
 
 namespace hex::pl {
@@ -21,6 +25,7 @@ namespace hex::pl {
         this->m_lexer = new Lexer();
         this->m_parser = new Parser();
         this->m_validator = new Validator();
+        this->m_resolver = new Resolver();
         this->m_evaluator = new Evaluator();
 
         this->m_preprocessor->addPragmaHandler("endian", [this](std::string value) {
@@ -92,6 +97,7 @@ namespace hex::pl {
         delete this->m_lexer;
         delete this->m_parser;
         delete this->m_validator;
+        delete this->m_resolver;
     }
 
     std::optional<std::vector<ASTNode*>> PatternLanguage::parseString(const std::string &code) {
@@ -113,11 +119,14 @@ namespace hex::pl {
             return { };
         }
 
+        this->m_resolver->resolve(ast.value());
+
         return ast;
     }
 
     std::optional<std::vector<PatternData*>> PatternLanguage::executeString(prv::Provider *provider, const std::string &code, const std::map<std::string, Token::Literal> &envVars, const std::map<std::string, Token::Literal> &inVariables) {
         this->m_currError.reset();
+        this->m_lastRun.reset();
         this->m_evaluator->getConsole().clear();
         this->m_evaluator->setProvider(provider);
         this->m_evaluator->setDefaultEndian(std::endian::native);
@@ -130,22 +139,119 @@ namespace hex::pl {
         for (const auto &[name, value] : envVars)
             this->m_evaluator->setEnvVariable(name, value);
 
-        for (auto &node : this->m_currAST)
-            delete node;
-        this->m_currAST.clear();
+        // The AST only depends on the code so it can be reused as long as that didn't change. Pragmas have to be applied again though since the settings were just reset
+        const auto codeHash = std::hash<std::string>{}(code);
+        if (this->m_currAST.empty() || codeHash != this->m_currCodeHash || code != this->m_currCode) {
+            for (auto &node : this->m_currAST)
+                delete node;
+            this->m_currAST.clear();
+            this->m_currCode.clear();
+
+            auto ast = this->parseString(code);
+            if (!ast)
+                return { };
+
+            this->m_currAST = ast.value();
+            this->m_currCodeHash = codeHash;
+            this->m_currCode = code;
+        } else if (!this->m_preprocessor->applyPragmas()) {
+            this->m_currError = this->m_preprocessor->getError();
+            return { };
+        }
 
-        auto ast = this->parseString(code);
-        if (!ast)
+        // Data may be edited while evaluating, those changes have to be picked up by the next run
+        std::optional<LastRun> lastRun;
+        if (provider != nullptr)
+            lastRun = LastRun { provider, provider->getDataRevision(), provider->getActualSize(), provider->getBaseAddress(), provider->getPatches(), envVars, inVariables };
+
+        auto patterns = this->m_evaluator->evaluate(this->m_currAST);
+        if (!patterns.has_value()) {
+            this->m_currError = this->m_evaluator->getConsole().getLastHardError();
             return { };
+        }
+
+        this->m_lastRun = std::move(lastRun);
+
+        return patterns;
+    }
+
+    static std::vector<Region> getChangedRegions(const Patches &oldPatches, const Patches &newPatches) {
+        std::vector<u64> changedAddresses;
+
+        auto compareExtent = [&changedAddresses](u64 address, const std::vector<u8> &data, const Patches &other) {
+            for (u64 i = 0; i < data.size(); i++) {
+                if (other.get(address + i) != data[i])
+                    changedAddresses.push_back(address + i);
+            }
+        };
+
+        // Both sides are sorted so extents that weren't touched at all can be skipped without looking at every byte
+        auto oldExtent = oldPatches.begin(), newExtent = newPatches.begin();
+        while (oldExtent != oldPatches.end() || newExtent != newPatches.end()) {
+            if (oldExtent != oldPatches.end() && newExtent != newPatches.end() && oldExtent->first == newExtent->first) {
+                if (oldExtent->second != newExtent->second) {
+                    compareExtent(oldExtent->first, oldExtent->second, newPatches);
+                    compareExtent(newExtent->first, newExtent->second, oldPatches);
+                }
+
+                oldExtent++;
+                newExtent++;
+            } else if (newExtent == newPatches.end() || (oldExtent != oldPatches.end() && oldExtent->first < newExtent->first)) {
+                compareExtent(oldExtent->first, oldExtent->second, newPatches);
+                oldExtent++;
+            } else {
+                compareExtent(newExtent->first, newExtent->second, oldPatches);
+                newExtent++;
+            }
+        }
+
+        std::sort(changedAddresses.begin(), changedAddresses.end());
+        changedAddresses.erase(std::unique(changedAddresses.begin(), changedAddresses.end()), changedAddresses.end());
+
+        std::vector<Region> regions;
+        for (auto address : changedAddresses) {
+            if (!regions.empty() && regions.back().address + regions.back().size == address)
+                regions.back().size++;
+            else
+                regions.push_back({ address, 1 });
+        }
 
-        this->m_currAST = ast.value();
+        return regions;
+    }
+
+    std::optional<std::vector<PatternData*>> PatternLanguage::reexecuteString(prv::Provider *provider, const std::string &code, const std::map<std::string, Token::Literal> &envVars, const std::map<std::string, Token::Literal> &inVariables) {
+        // Only changes made through patches can be tracked, everything else might have changed any byte
+        const bool canReuse = this->m_lastRun.has_value() &&
+                              provider != nullptr &&
+                              this->m_lastRun->provider == provider &&
+                              this->m_lastRun->dataRevision == provider->getDataRevision() &&
+                              this->m_lastRun->size == provider->getActualSize() &&
+                              this->m_lastRun->baseAddress == provider->getBaseAddress() &&
+                              this->m_lastRun->envVars == envVars &&
+                              this->m_lastRun->inVariables == inVariables &&
+                              code == this->m_currCode;
+
+        if (!canReuse) {
+            this->m_evaluator->discardResult();
+            return this->executeString(provider, code, envVars, inVariables);
+        }
+
+        this->m_currError.reset();
+        this->m_evaluator->setInVariables(inVariables);
+
+        for (const auto &[name, value] : envVars)
+            this->m_evaluator->setEnvVariable(name, value);
 
-        auto patterns = this->m_evaluator->evaluate(ast.value());
+        auto patches = provider->getPatches();
+        auto patterns = this->m_evaluator->reevaluate(this->m_currAST, getChangedRegions(this->m_lastRun->patches, patches));
         if (!patterns.has_value()) {
             this->m_currError = this->m_evaluator->getConsole().getLastHardError();
+            this->m_lastRun.reset();
             return { };
         }
 
+        this->m_lastRun->patches = std::move(patches);
+
         return patterns;
     }
 
@@ -159,6 +265,14 @@ namespace hex::pl {
         this->m_evaluator->abort();
     }
 
+    void PatternLanguage::resetAbort() {
+        this->m_evaluator->resetAbort();
+    }
+
+    void PatternLanguage::setBusy(bool busy) {
+        this->m_evaluator->setBusy(busy);
+    }
+
     const std::vector<ASTNode*> &PatternLanguage::getCurrentAST() const {
         return this->m_currAST;
     }
@@ -190,6 +304,14 @@ namespace hex::pl {
         this->m_evaluator->allowDangerousFunctions(allow);
     }
 
+    void PatternLanguage::setBytecodeEnabled(bool enabled) {
+        this->m_evaluator->setBytecodeEnabled(enabled);
+    }
+
+    void PatternLanguage::setPartialResultCallback(const std::function<void(const std::vector<PatternData*>&)> &callback) {
+        this->m_evaluator->setPartialResultCallback(callback);
+    }
+
     bool PatternLanguage::hasDangerousFunctionBeenCalled() const {
         return this->m_evaluator->hasDangerousFunctionBeenCalled();
     }
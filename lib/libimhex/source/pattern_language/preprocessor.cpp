@@ -203,13 +203,8 @@ namespace hex::pl {
                 }
 
                 // Handle pragmas
-                for (const auto &[type, value, pragmaLine] : this->m_pragmas) {
-                    if (this->m_pragmaHandlers.contains(type)) {
-                        if (!this->m_pragmaHandlers[type](value))
-                            throwPreprocessorError(hex::format("invalid value provided to '{0}' #pragma directive", type.c_str()), pragmaLine);
-                    } else
-                        throwPreprocessorError(hex::format("no #pragma handler registered for type {0}", type.c_str()), pragmaLine);
-                }
+                if (!this->applyPragmas())
+                    return { };
             }
         } catch (PreprocessorError &e) {
             this->m_error = e;
@@ -219,6 +214,23 @@ namespace hex::pl {
         return output;
     }
 
+    bool Preprocessor::applyPragmas() {
+        try {
+            for (const auto &[type, value, pragmaLine] : this->m_pragmas) {
+                if (this->m_pragmaHandlers.contains(type)) {
+                    if (!this->m_pragmaHandlers[type](value))
+                        throwPreprocessorError(hex::format("invalid value provided to '{0}' #pragma directive", type.c_str()), pragmaLine);
+                } else
+                    throwPreprocessorError(hex::format("no #pragma handler registered for type {0}", type.c_str()), pragmaLine);
+            }
+        } catch (PreprocessorError &e) {
+            this->m_error = e;
+            return false;
+        }
+
+        return true;
+    }
+
     void Preprocessor::addPragmaHandler(const std::string &pragmaType, const std::function<bool(const std::string&)> &function) {
         if (!this->m_pragmaHandlers.contains(pragmaType))
             this->m_pragmaHandlers.emplace(pragmaType, function);
@@ -0,0 +1,108 @@
+#include <hex/pattern_language/resolver.hpp>
+
+#include <hex/pattern_language/ast_node.hpp>
+
+namespace hex::pl {
+
+    void Resolver::resolve(const std::vector<ASTNode*> &ast) {
+        for (const auto &node : ast) {
+            if (auto functionNode = dynamic_cast<ASTNodeFunctionDefinition*>(node); functionNode != nullptr) {
+                this->m_variables.clear();
+
+                // Parameters are the first variables created in a function's scope
+                for (const auto &[name, type] : functionNode->getParams())
+                    this->m_variables.push_back(name);
+
+                for (const auto &statement : functionNode->getBody())
+                    this->resolveNode(statement);
+            }
+        }
+
+        this->m_variables.clear();
+    }
+
+    void Resolver::resolveBlock(const std::vector<ASTNode*> &statements) {
+        // Nested blocks start out with a copy of the enclosing scope and drop their own variables again when they end
+        const auto variableCount = this->m_variables.size();
+
+        for (const auto &statement : statements)
+            this->resolveNode(statement);
+
+        this->m_variables.resize(variableCount);
+    }
+
+    void Resolver::resolveNode(ASTNode *node) {
+        if (node == nullptr)
+            return;
+
+        if (auto variableDeclNode = dynamic_cast<ASTNodeVariableDecl*>(node); variableDeclNode != nullptr) {
+            this->m_variables.push_back(variableDeclNode->getName());
+        } else if (auto multiVariableDeclNode = dynamic_cast<ASTNodeMultiVariableDecl*>(node); multiVariableDeclNode != nullptr) {
+            for (const auto &variable : multiVariableDeclNode->getVariables())
+                this->resolveNode(variable);
+        } else if (auto compoundNode = dynamic_cast<ASTNodeCompoundStatement*>(node); compoundNode != nullptr) {
+            if (compoundNode->m_newScope) {
+                this->resolveBlock(compoundNode->m_statements);
+            } else {
+                for (const auto &statement : compoundNode->m_statements)
+                    this->resolveNode(statement);
+            }
+        } else if (auto assignmentNode = dynamic_cast<ASTNodeAssignment*>(node); assignmentNode != nullptr) {
+            this->resolveNode(assignmentNode->getRValue());
+
+            if (auto slot = this->findVariable(assignmentNode->getLValueName()); slot.has_value())
+                assignmentNode->setVariableSlot(*slot);
+        } else if (auto conditionalNode = dynamic_cast<ASTNodeConditionalStatement*>(node); conditionalNode != nullptr) {
+            this->resolveNode(conditionalNode->getCondition());
+            this->resolveBlock(conditionalNode->getTrueBody());
+            this->resolveBlock(conditionalNode->getFalseBody());
+        } else if (auto whileNode = dynamic_cast<ASTNodeWhileStatement*>(node); whileNode != nullptr) {
+            this->resolveNode(whileNode->getCondition());
+
+            // The post expression runs in the same scope as the loop body
+            const auto variableCount = this->m_variables.size();
+            for (const auto &statement : whileNode->getBody())
+                this->resolveNode(statement);
+            this->resolveNode(whileNode->getPostExpression());
+            this->m_variables.resize(variableCount);
+        } else if (auto controlFlowNode = dynamic_cast<ASTNodeControlFlowStatement*>(node); controlFlowNode != nullptr) {
+            this->resolveNode(controlFlowNode->getReturnValue());
+        } else if (auto functionCallNode = dynamic_cast<ASTNodeFunctionCall*>(node); functionCallNode != nullptr) {
+            for (const auto &param : functionCallNode->getParams())
+                this->resolveNode(param);
+        } else if (auto mathNode = dynamic_cast<ASTNodeMathematicalExpression*>(node); mathNode != nullptr) {
+            this->resolveNode(mathNode->getLeftOperand());
+            this->resolveNode(mathNode->getRightOperand());
+        } else if (auto ternaryNode = dynamic_cast<ASTNodeTernaryExpression*>(node); ternaryNode != nullptr) {
+            this->resolveNode(ternaryNode->getFirstOperand());
+            this->resolveNode(ternaryNode->getSecondOperand());
+            this->resolveNode(ternaryNode->getThirdOperand());
+        } else if (auto castNode = dynamic_cast<ASTNodeCast*>(node); castNode != nullptr) {
+            this->resolveNode(castNode->getValue());
+        } else if (auto typeOperatorNode = dynamic_cast<ASTNodeTypeOperator*>(node); typeOperatorNode != nullptr) {
+            this->resolveNode(typeOperatorNode->getExpression());
+        } else if (auto rvalueNode = dynamic_cast<ASTNodeRValue*>(node); rvalueNode != nullptr) {
+            const auto &path = rvalueNode->getPath();
+
+            for (const auto &part : path) {
+                if (auto index = std::get_if<ASTNode*>(&part); index != nullptr)
+                    this->resolveNode(*index);
+            }
+
+            if (auto name = std::get_if<std::string>(&path.front()); name != nullptr) {
+                if (auto slot = this->findVariable(*name); slot.has_value())
+                    rvalueNode->setVariableSlot(*slot);
+            }
+        }
+    }
+
+    std::optional<u32> Resolver::findVariable(const std::string &name) const {
+        for (u32 slot = this->m_variables.size(); slot > 0; slot--) {
+            if (this->m_variables[slot - 1] == name)
+                return slot - 1;
+        }
+
+        return std::nullopt;
+    }
+
+}
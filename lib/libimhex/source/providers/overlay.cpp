@@ -0,0 +1,19 @@
+#include <hex/providers/overlay.hpp>
+
+#include <hex/providers/provider.hpp>
+
+namespace hex::prv {
+
+    void Overlay::setAddress(u64 address) {
+        this->m_address = address;
+
+        this->m_provider->updateRevision();
+    }
+
+    void Overlay::setData(const std::vector<u8> &data) {
+        this->m_data = data;
+
+        this->m_provider->updateRevision();
+    }
+
+}
@@ -3,6 +3,7 @@
 #include <hex.hpp>
 #include <hex/api/event.hpp>
 
+#include <atomic>
 #include <cmath>
 #include <cstring>
 #include <map>
@@ -11,8 +12,14 @@
 
 namespace hex::prv {
 
+    namespace {
+
+        std::atomic<u64> s_nextRevision = 1;
+
+    }
+
     Provider::Provider() {
-        this->m_patches.emplace_back();
+        this->updateRevision(true);
 
         if (this->hasLoadInterface())
             EventManager::post<RequestOpenPopup>(View::toWindowName("hex.builtin.view.provider_settings.load_popup"));
@@ -24,32 +31,90 @@ namespace hex::prv {
     }
 
     void Provider::read(u64 offset, void *buffer, size_t size, bool overlays) {
-        this->readRaw(offset - this->getBaseAddress(), buffer, size);
+        if ((offset - this->getBaseAddress()) > (this->getActualSize() - size) || buffer == nullptr || size == 0)
+            return;
+
+        this->readCached(offset - this->getBaseAddress(), buffer, size);
+
+        getPatches().apply(offset, buffer, size);
+
+        if (overlays)
+            this->applyOverlays(offset, buffer, size);
     }
 
     void Provider::write(u64 offset, const void *buffer, size_t size) {
         this->writeRaw(offset - this->getBaseAddress(), buffer, size);
+        this->m_readCache.invalidate(offset - this->getBaseAddress(), size);
+        this->updateRevision(true);
+    }
+
+    void Provider::readCached(u64 offset, void *buffer, size_t size) {
+        this->m_readCache.read(offset, buffer, size, [this](u64 pageOffset, void *pageBuffer, size_t pageSize) {
+            // The last page usually extends past the end of the data
+            const size_t actualSize = this->getActualSize();
+            if (pageOffset < actualSize)
+                this->readRaw(pageOffset, pageBuffer, std::min<u64>(pageSize, actualSize - pageOffset));
+        });
+    }
+
+    std::optional<std::span<const u8>> Provider::getRawSpan(u64 offset, size_t size) const {
+        return std::nullopt;
+    }
+
+    void Provider::readChunks(u64 offset, size_t size, const ChunkCallback &callback, size_t chunkSize, bool overlays) {
+        if (offset < this->getBaseAddress() || chunkSize == 0)
+            return;
+
+        const u64 endOffset = std::min<u64>(offset + size, this->getBaseAddress() + this->getActualSize());
+
+        std::vector<u8> buffer;
+        for (u64 chunkOffset = offset; chunkOffset < endOffset; chunkOffset += chunkSize) {
+            const size_t readSize = std::min<u64>(chunkSize, endOffset - chunkOffset);
+
+            // Unmodified data can be handed out without copying it if the backend allows it
+            if (!this->isModified(chunkOffset, readSize, overlays)) {
+                if (auto span = this->getRawSpan(chunkOffset - this->getBaseAddress(), readSize); span.has_value() && span->size() == readSize) {
+                    callback(chunkOffset, *span);
+                    continue;
+                }
+            }
+
+            buffer.resize(readSize);
+            this->read(chunkOffset, buffer.data(), readSize, overlays);
+            callback(chunkOffset, buffer);
+        }
+    }
+
+    bool Provider::isModified(u64 offset, size_t size, bool overlays) const {
+        if (this->m_patches.overlaps(offset, size))
+            return true;
+
+        if (overlays) {
+            for (const auto &overlay : this->m_overlays) {
+                if (overlay->getAddress() < offset + size && overlay->getAddress() + overlay->getSize() > offset)
+                    return true;
+            }
+        }
+
+        return false;
     }
 
     void Provider::save() { }
     void Provider::saveAs(const fs::path &path) { }
 
-    void Provider::resize(size_t newSize) { }
+    void Provider::resize(size_t newSize) {
+        this->m_readCache.invalidate();
+        this->updateRevision(true);
+    }
 
     void Provider::insert(u64 offset, size_t size) {
-        auto &patches = getPatches();
+        this->m_readCache.invalidate();
+        this->updateRevision(true);
 
-        std::vector<std::pair<u64, u8>> patchesToMove;
-
-        for (auto &[address, value] : patches) {
-            if (address > offset)
-                patchesToMove.emplace_back(address, value);
-        }
+        getPatches().shift(offset + this->getBaseAddress(), size);
 
-        for (const auto &[address, value] : patchesToMove)
-            patches.erase(address);
-        for (const auto &[address, value] : patchesToMove)
-            patches.insert({ address + offset, value });
+        // The recorded deltas refer to the addresses from before the insertion
+        this->clearUndoHistory();
     }
 
     void Provider::applyOverlays(u64 offset, void *buffer, size_t size) {
@@ -65,36 +130,39 @@ namespace hex::prv {
     }
 
 
-    std::map<u64, u8>& Provider::getPatches() {
-        auto iter = this->m_patches.end();
-        for (auto i = 0; i < this->m_patchTreeOffset + 1; i++)
-            iter--;
-
-        return *(iter);
+    const ReadCache& Provider::getReadCache() const {
+        return this->m_readCache;
     }
 
-    const std::map<u64, u8>& Provider::getPatches() const {
-        auto iter = this->m_patches.end();
-        for (auto i = 0; i < this->m_patchTreeOffset + 1; i++)
-            iter--;
+    Patches& Provider::getPatches() {
+        return this->m_patches;
+    }
 
-        return *(iter);
+    const Patches& Provider::getPatches() const {
+        return this->m_patches;
     }
 
     void Provider::applyPatches() {
-        for (auto &[patchAddress, patch] : getPatches()) {
-            this->writeRaw(patchAddress - this->getBaseAddress(), &patch, 1);
+        for (auto &[patchAddress, data] : getPatches()) {
+            this->writeRaw(patchAddress - this->getBaseAddress(), data.data(), data.size());
+            this->m_readCache.invalidate(patchAddress - this->getBaseAddress(), data.size());
         }
+
+        this->updateRevision(true);
     }
 
 
     Overlay* Provider::newOverlay() {
-        return this->m_overlays.emplace_back(new Overlay());
+        this->updateRevision();
+
+        return this->m_overlays.emplace_back(new Overlay(this));
     }
 
     void Provider::deleteOverlay(Overlay *overlay) {
         this->m_overlays.erase(std::find(this->m_overlays.begin(), this->m_overlays.end(), overlay));
         delete overlay;
+
+        this->updateRevision();
     }
 
     const std::list<Overlay*>& Provider::getOverlays() {
@@ -142,42 +210,105 @@ namespace hex::prv {
     }
 
     void Provider::addPatch(u64 offset, const void *buffer, size_t size, bool createUndo) {
-        if (this->m_patchTreeOffset > 0) {
-            auto iter = this->m_patches.end();
-            for (auto i = 0; i < this->m_patchTreeOffset; i++)
-                iter--;
+        if (createUndo)
+            this->createUndoPoint();
+
+        // A new edit makes all undone steps unreachable
+        while (this->m_undoHistory.size() > this->m_undoPosition) {
+            for (const auto &delta : this->m_undoHistory.back())
+                this->m_undoHistorySize -= delta.data.size() + delta.previous.size();
 
-            this->m_patches.erase(iter, this->m_patches.end());
-            this->m_patchTreeOffset = 0;
+            this->m_undoHistory.pop_back();
         }
 
-        if (createUndo)
-            createUndoPoint();
+        if (!this->m_undoGroupOpen) {
+            this->m_undoHistory.emplace_back();
+            this->m_undoPosition++;
+            this->m_undoGroupOpen = true;
+        }
+
+        auto bytes = static_cast<const u8*>(buffer);
+        auto &delta = this->m_undoHistory.back().emplace_back(PatchDelta { offset, { bytes, bytes + size }, this->m_patches.getRange(offset, size) });
+        this->m_undoHistorySize += delta.data.size() + delta.previous.size();
+
+        this->m_patches.add(offset, buffer, size);
+        this->updateRevision();
 
-        for (u64 i = 0; i < size; i++)
-            getPatches()[offset + i] = reinterpret_cast<const u8*>(buffer)[i];
+        if (createUndo)
+            this->createUndoPoint();
     }
 
     void Provider::createUndoPoint() {
-        this->m_patches.push_back(getPatches());
+        this->m_undoGroupOpen = false;
     }
 
     void Provider::undo() {
-        if (canUndo())
-            this->m_patchTreeOffset++;
+        if (!canUndo())
+            return;
+
+        this->m_undoGroupOpen = false;
+        this->m_undoPosition--;
+
+        const auto &deltas = this->m_undoHistory[this->m_undoPosition];
+        for (auto delta = deltas.rbegin(); delta != deltas.rend(); delta++) {
+            this->m_patches.remove(delta->address, delta->data.size());
+
+            for (const auto &[address, data] : delta->previous)
+                this->m_patches.add(address, data.data(), data.size());
+        }
+
+        this->updateRevision();
     }
 
     void Provider::redo() {
-        if (canRedo())
-            this->m_patchTreeOffset--;
+        if (!canRedo())
+            return;
+
+        this->m_undoGroupOpen = false;
+
+        for (const auto &delta : this->m_undoHistory[this->m_undoPosition])
+            this->m_patches.add(delta.address, delta.data.data(), delta.data.size());
+
+        this->m_undoPosition++;
+        this->updateRevision();
     }
 
     bool Provider::canUndo() const {
-        return this->m_patchTreeOffset < this->m_patches.size() - 1;
+        return this->m_undoPosition > 0;
     }
 
     bool Provider::canRedo() const {
-        return this->m_patchTreeOffset > 0;
+        return this->m_undoPosition < this->m_undoHistory.size();
+    }
+
+    size_t Provider::getUndoStepCount() const {
+        return this->m_undoHistory.size();
+    }
+
+    size_t Provider::getUndoHistorySize() const {
+        return this->m_undoHistorySize;
+    }
+
+    u64 Provider::getRevision() const {
+        return this->m_revision;
+    }
+
+    u64 Provider::getDataRevision() const {
+        return this->m_dataRevision;
+    }
+
+    void Provider::updateRevision(bool dataChanged) {
+        this->m_revision = s_nextRevision++;
+
+        if (dataChanged)
+            this->m_dataRevision = this->m_revision.load();
+    }
+
+    void Provider::clearUndoHistory() {
+        this->m_undoHistory.clear();
+        this->m_undoPosition = 0;
+        this->m_undoHistorySize = 0;
+        this->m_undoGroupOpen = false;
     }
 
 
@@ -0,0 +1,142 @@
+#include <hex/providers/read_cache.hpp>
+
+#include <cstring>
+
+namespace hex::prv {
+
+    const ReadCache::Page& ReadCache::getPage(u64 address, const ReadFunction &readFunction) {
+        if (auto iter = this->m_pageLookup.find(address); iter != this->m_pageLookup.end()) {
+            this->m_hits++;
+
+            // Move the page to the front so the least recently used one is always at the back
+            this->m_pages.splice(this->m_pages.begin(), this->m_pages, iter->second);
+            return this->m_pages.front();
+        }
+
+        this->m_misses++;
+
+        const bool sequential = this->m_lastMissAddress.has_value() && address == *this->m_lastMissAddress + this->m_pageSize;
+        this->m_lastMissAddress = address;
+
+        // Fetch the following pages with the same request, slow backends pay mostly for the round trip and not for the size
+        const size_t readAhead = sequential ? std::min(this->m_readAhead, this->m_pageCount - 1) : 0;
+        if (readAhead > 0) {
+            std::vector<u8> buffer((readAhead + 1) * this->m_pageSize, 0x00);
+            readFunction(address, buffer.data(), buffer.size());
+
+            // Insert the pages back to front so the requested page ends up being the most recently used one
+            for (size_t i = readAhead; i > 0; i--) {
+                const u64 pageAddress = address + i * this->m_pageSize;
+                if (this->m_pageLookup.contains(pageAddress))
+                    continue;
+
+                auto &page = this->insertPage(pageAddress);
+                std::memcpy(page.data.data(), buffer.data() + i * this->m_pageSize, this->m_pageSize);
+            }
+
+            this->m_lastMissAddress = address + readAhead * this->m_pageSize;
+
+            auto &page = this->insertPage(address);
+            std::memcpy(page.data.data(), buffer.data(), this->m_pageSize);
+
+            return page;
+        }
+
+        auto &page = this->insertPage(address);
+        readFunction(address, page.data.data(), page.data.size());
+
+        return page;
+    }
+
+    ReadCache::Page& ReadCache::insertPage(u64 address) {
+        if (this->m_pages.size() >= this->m_pageCount) {
+            // Reuse the buffer of the evicted page to avoid reallocating it
+            this->m_pageLookup.erase(this->m_pages.back().address);
+            this->m_pages.splice(this->m_pages.begin(), this->m_pages, std::prev(this->m_pages.end()));
+        } else {
+            this->m_pages.emplace_front();
+        }
+
+        auto &page = this->m_pages.front();
+        page.address = address;
+        page.data.resize(this->m_pageSize);
+
+        this->m_pageLookup[address] = this->m_pages.begin();
+
+        return page;
+    }
+
+    void ReadCache::read(u64 offset, void *buffer, size_t size, const ReadFunction &readFunction) {
+        // Reads that would evict most of the cache anyways are passed through directly
+        if (!this->isEnabled() || size >= (this->m_pageSize * this->m_pageCount) / 2) {
+            readFunction(offset, buffer, size);
+            return;
+        }
+
+        std::scoped_lock lock(this->m_mutex);
+
+        const u64 endOffset = offset + size;
+        for (u64 pageAddress = offset - (offset % this->m_pageSize); pageAddress < endOffset; pageAddress += this->m_pageSize) {
+            const auto &page = this->getPage(pageAddress, readFunction);
+
+            const u64 copyStart = std::max(pageAddress, offset);
+            const u64 copyEnd   = std::min(pageAddress + this->m_pageSize, endOffset);
+
+            std::memcpy(static_cast<u8*>(buffer) + (copyStart - offset), page.data.data() + (copyStart - pageAddress), copyEnd - copyStart);
+        }
+    }
+
+    void ReadCache::invalidate() {
+        std::scoped_lock lock(this->m_mutex);
+
+        this->m_pages.clear();
+        this->m_pageLookup.clear();
+        this->m_lastMissAddress.reset();
+    }
+
+    void ReadCache::invalidate(u64 offset, size_t size) {
+        if (!this->isEnabled() || size == 0)
+            return;
+
+        std::scoped_lock lock(this->m_mutex);
+
+        const u64 endOffset = offset + size;
+        const u64 firstPage = offset - (offset % this->m_pageSize);
+
+        // Walk whichever is smaller, the cached pages or the pages in the invalidated region
+        if ((endOffset - firstPage) / this->m_pageSize > this->m_pages.size()) {
+            std::erase_if(this->m_pages, [&, this](const Page &page) {
+                if (page.address + this->m_pageSize <= offset || page.address >= endOffset)
+                    return false;
+
+                this->m_pageLookup.erase(page.address);
+                return true;
+            });
+        } else {
+            for (u64 pageAddress = firstPage; pageAddress < endOffset; pageAddress += this->m_pageSize) {
+                if (auto iter = this->m_pageLookup.find(pageAddress); iter != this->m_pageLookup.end()) {
+                    this->m_pages.erase(iter->second);
+                    this->m_pageLookup.erase(iter);
+                }
+            }
+        }
+    }
+
+    void ReadCache::setPageSize(size_t pageSize) {
+        this->invalidate();
+
+        std::scoped_lock lock(this->m_mutex);
+        this->m_pageSize = pageSize;
+    }
+
+    void ReadCache::setPageCount(size_t pageCount) {
+        std::scoped_lock lock(this->m_mutex);
+
+        this->m_pageCount = pageCount;
+        while (this->m_pages.size() > this->m_pageCount) {
+            this->m_pageLookup.erase(this->m_pages.back().address);
+            this->m_pages.pop_back();
+        }
+    }
+
+}
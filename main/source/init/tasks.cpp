@@ -67,7 +67,8 @@ namespace hex::init {
             ImHexPath::Constants,
             ImHexPath::Yara,
             ImHexPath::Python,
-            ImHexPath::Logs
+            ImHexPath::Logs,
+            ImHexPath::Cache
         };
 
         for (auto path : paths) {
@@ -2,6 +2,9 @@
 
 #include <hex/providers/provider.hpp>
 
+#include <memory>
+#include <mutex>
+#include <new>
 #include <set>
 #include <string>
 #include <vector>
@@ -41,6 +44,40 @@ namespace hex::plugin::builtin::prv {
     protected:
         void reloadDrives();
 
+        /*
+         * Direct I/O requires sector aligned offsets, sizes and buffer addresses. Unaligned requests go through
+         * aligned bounce buffers which are kept around so scanning a disk doesn't allocate for every read
+         */
+        struct AlignedDeleter {
+            size_t alignment;
+
+            void operator()(u8 *pointer) const {
+                ::operator delete[](pointer, std::align_val_t(this->alignment));
+            }
+        };
+        using AlignedBuffer = std::unique_ptr<u8[], AlignedDeleter>;
+
+        [[nodiscard]] AlignedBuffer acquireBuffer();
+        void releaseBuffer(AlignedBuffer &&buffer);
+
+        [[nodiscard]] bool isAligned(u64 value) const { return value % this->m_sectorSize == 0; }
+        [[nodiscard]] u64 alignDown(u64 value) const { return value - (value % this->m_sectorSize); }
+        [[nodiscard]] u64 alignUp(u64 value) const { return this->alignDown(value + this->m_sectorSize - 1); }
+
+        // Positional transfers of whole sectors, offset, size and buffer have to be sector aligned
+        void readSectors(u64 offset, u8 *buffer, size_t size);
+        void writeSectors(u64 offset, const u8 *buffer, size_t size);
+
+        constexpr static size_t DefaultSectorSize   = 0x200;
+        constexpr static size_t MinimumAlignment    = 0x1000;
+        constexpr static size_t BulkTransferSize    = 0x10'0000;
+        constexpr static size_t MaxPooledBuffers    = 0x04;
+
+        // Recently used extents are kept in the provider's read cache, sequential misses fetch BulkTransferSize at once
+        constexpr static size_t CachePageSize       = 0x1'0000;
+        constexpr static size_t CachePageCount      = 0x100;
+        constexpr static size_t CacheReadAhead      = BulkTransferSize / CachePageSize - 1;
+
         std::set<std::string> m_availableDrives;
         fs::path m_path;
 
@@ -51,11 +88,11 @@ namespace hex::plugin::builtin::prv {
             int m_diskHandle = -1;
         #endif
 
-        size_t m_diskSize;
-        size_t m_sectorSize;
+        size_t m_diskSize = 0;
+        size_t m_sectorSize = DefaultSectorSize;
 
-        u64 m_sectorBufferAddress;
-        std::vector<u8> m_sectorBuffer;
+        std::vector<AlignedBuffer> m_bufferPool;
+        std::mutex m_bufferPoolMutex;
 
         bool m_readable = false;
         bool m_writable = false;
@@ -36,6 +36,7 @@ namespace hex::plugin::builtin::prv {
         void readRaw(u64 offset, void *buffer, size_t size) override;
         void writeRaw(u64 offset, const void *buffer, size_t size) override;
         [[nodiscard]] size_t getActualSize() const override;
+        [[nodiscard]] std::optional<std::span<const u8>> getRawSpan(u64 offset, size_t size) const override;
 
         void save() override;
         void saveAs(const fs::path &path) override;
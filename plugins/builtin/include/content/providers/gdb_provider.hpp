@@ -3,7 +3,9 @@
 #include <hex/helpers/socket.hpp>
 #include <hex/providers/provider.hpp>
 
+#include <chrono>
 #include <mutex>
+#include <string>
 #include <string_view>
 #include <thread>
 
@@ -20,7 +22,6 @@ class GDBProvider : public hex::prv::Provider {
         [[nodiscard]] bool isResizable() const override;
         [[nodiscard]] bool isSavable() const override;
 
-        void read(u64 offset, void *buffer, size_t size, bool overlays) override;
         void write(u64 offset, const void *buffer, size_t size) override;
 
         void readRaw(u64 offset, void *buffer, size_t size) override;
@@ -48,19 +49,21 @@ class GDBProvider : public hex::prv::Provider {
         int m_port;
 
         u64 m_size;
+        u64 m_cacheSize = DefaultCacheSize;
 
         constexpr static size_t CacheLineSize = 0x1000;
+        constexpr static size_t DefaultCacheSize = 0x100'0000;
+        constexpr static size_t CacheReadAhead = 0x0F;
+        constexpr static auto StopStateCheckInterval = std::chrono::seconds(1);
 
-        struct CacheLine {
-            u64 address;
+        // Largest amount of memory a single m packet may request, limited by the packet size the server announced
+        size_t m_maxReadSize = CacheLineSize;
 
-            std::array<u8, CacheLineSize> data;
-        };
-
-        std::list<CacheLine> m_cache;
+        // Every request and its reply have to be sent and received as a whole
+        std::mutex m_socketMutex;
+        std::string m_lastStopReason;
 
         std::thread m_cacheUpdateThread;
-        std::mutex m_cacheLock;
     };
 
 }
\ No newline at end of file
@@ -4,9 +4,14 @@
 
 #include <imgui.h>
 #include <hex/views/view.hpp>
+#include <hex/helpers/binary_diff.hpp>
 
 #include <array>
+#include <atomic>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace hex::plugin::builtin {
@@ -15,6 +20,8 @@ namespace hex::plugin::builtin {
 
     class ViewDiff : public View {
     public:
+        constexpr static int MaxColumnCount = 0x20;
+
         ViewDiff();
         ~ViewDiff() override;
 
@@ -22,13 +29,54 @@ namespace hex::plugin::builtin {
         void drawMenu() override;
 
     private:
-        void drawDiffLine(const std::array<int, 2> &providerIds, u64 row) const;
+        void drawDiffLine(u64 row) const;
+        void drawMinimap(float height);
+
+        void startDiff();
+        void resetDiff();
+        void updateRowLayout();
+        void jumpToDifference(bool forward);
 
         int m_providerA = -1, m_providerB = -1;
 
         bool m_greyedOutZeros = true;
         bool m_upperCaseHex = true;
         int m_columnCount = 16;
+
+        // Detecting insertions and deletions is a lot more expensive than comparing bytes at the same offsets
+        bool m_alignData = true;
+        bool m_differencesOnly = false;
+
+        constexpr static size_t MinimapBinCount = 0x200;
+        constexpr static float MinimapWidth = 20.0F;
+
+        // Providers and revisions the last diff was started for, a new diff gets started once they change
+        std::array<int, 2> m_diffedProviders = { -1, -1 };
+        std::array<u64, 2> m_diffedRevisions = { 0, 0 };
+        bool m_diffedAligned = true;
+        std::atomic<bool> m_diffing = false;
+
+        // Finished edit script, handed over to the UI thread by the diff thread
+        std::mutex m_diffMutex;
+        std::optional<std::vector<BinaryDiff::Edit>> m_pendingEdits;
+        std::vector<BinaryDiff::Edit> m_edits;
+        u64 m_differenceCount = 0;
+
+        // Row every edit starts at when laid out with m_layoutColumnCount bytes per row
+        std::vector<u64> m_rowStarts;
+        u64 m_rowCount = 0;
+        int m_layoutColumnCount = 0;
+        bool m_layoutDifferencesOnly = false;
+        u8 m_addressDigitCount = 0;
+
+        // Strongest kind of difference within every bin of rows, Equal if there is none
+        std::array<BinaryDiff::EditType, MinimapBinCount> m_minimap = { };
+
+        u64 m_firstVisibleRow = 0, m_visibleRowCount = 0;
+        std::optional<u64> m_scrollToRow;
+
+        // Declared last so it's stopped and joined before anything it writes to gets destroyed
+        std::jthread m_diffThread;
     };
 
-}
\ No newline at end of file
+}
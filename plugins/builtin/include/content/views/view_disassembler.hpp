@@ -3,9 +3,16 @@
 #include <hex/views/view.hpp>
 
 #include <hex/helpers/disassembler.hpp>
+#include <hex/helpers/disassembly_index.hpp>
 
+#include <atomic>
 #include <cstdio>
+#include <list>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace hex::plugin::builtin {
@@ -30,7 +37,7 @@ namespace hex::plugin::builtin {
         void drawMenu() override;
 
     private:
-        bool m_disassembling = false;
+        std::atomic<bool> m_disassembling = false;
 
         u64 m_baseAddress = 0;
         u64 m_codeRegion[2] = { 0 };
@@ -45,9 +52,32 @@ namespace hex::plugin::builtin {
 
         bool m_littleEndianMode = true, m_micoMode = false, m_sparcV9Mode = false;
 
-        std::vector<Disassembly> m_disassembly;
+        // Only instruction boundaries are kept for the whole region, rows get decoded and formatted once they become visible
+        DisassemblyIndex m_disassemblyIndex;
+        u64 m_indexRegionStart = 0, m_indexBaseAddress = 0;
+        cs_arch m_indexArchitecture = CS_ARCH_ARM;
+        cs_mode m_indexMode = cs_mode(0);
+
+        // Index built by the disassembler thread, picked up by the UI thread on the next frame
+        std::mutex m_pendingIndexMutex;
+        std::optional<DisassemblyIndex> m_pendingIndex;
+
+        csh m_formatHandle = 0;
+        cs_insn *m_formatInstruction = nullptr;
+
+        constexpr static size_t RowCacheSize = 0x400;
+        std::list<std::pair<size_t, Disassembly>> m_rowCache;
+        std::unordered_map<size_t, std::list<std::pair<size_t, Disassembly>>::iterator> m_rowLookup;
 
         void disassemble();
+        void stopDisassembling();
+        void resetRows();
+
+        [[nodiscard]] cs_mode getMode() const;
+        [[nodiscard]] const Disassembly& getRow(size_t index);
+
+        // Declared last so the disassembler thread is stopped before anything it accesses gets destroyed
+        std::jthread m_disassemblerThread;
     };
 
 }
\ No newline at end of file
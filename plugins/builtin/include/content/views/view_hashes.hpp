@@ -1,9 +1,15 @@
 #pragma once
 
 #include <hex/views/view.hpp>
+#include <hex/helpers/crypto.hpp>
 
 #include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 #include <cstdio>
 
 namespace hex::plugin::builtin {
@@ -19,24 +25,37 @@ namespace hex::plugin::builtin {
         void drawMenu() override;
 
     private:
-        enum class HashFunctions { Crc8, Crc16, Crc32, Md5, Sha1, Sha224, Sha256, Sha384, Sha512 };
-
         bool m_shouldInvalidate = true;
-        int m_currHashFunction = 0;
         u64 m_hashRegion[2] = { 0 };
         bool m_shouldMatchSelection = false;
 
+        std::array<bool, 9> m_enabledHashFunctions = { true };
+        crypt::CrcParameters m_crc8  = { 0x07, 0x00, 0x00, false, false };
+        crypt::CrcParameters m_crc16 = { 0x8005, 0x0000, 0x0000, false, false };
+        crypt::CrcParameters m_crc32 = { 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true, true };
+
+        // Results of the background hashing, pairs of hash function name and digest
+        std::mutex m_resultsMutex;
+        std::vector<std::pair<std::string, std::string>> m_results;
+        std::atomic<bool> m_calculating = false;
+
         static constexpr std::array hashFunctionNames {
-            std::pair{HashFunctions::Crc8,   "CRC8"},
-            std::pair{HashFunctions::Crc16,  "CRC16"},
-            std::pair{HashFunctions::Crc32,  "CRC32"},
-            std::pair{HashFunctions::Md5,    "MD5"},
-            std::pair{HashFunctions::Sha1,   "SHA-1"},
-            std::pair{HashFunctions::Sha224, "SHA-224"},
-            std::pair{HashFunctions::Sha256, "SHA-256"},
-            std::pair{HashFunctions::Sha384, "SHA-384"},
-            std::pair{HashFunctions::Sha512, "SHA-512"},
+            std::pair{crypt::HashFunction::CRC8,   "CRC8"},
+            std::pair{crypt::HashFunction::CRC16,  "CRC16"},
+            std::pair{crypt::HashFunction::CRC32,  "CRC32"},
+            std::pair{crypt::HashFunction::MD5,    "MD5"},
+            std::pair{crypt::HashFunction::SHA1,   "SHA-1"},
+            std::pair{crypt::HashFunction::SHA224, "SHA-224"},
+            std::pair{crypt::HashFunction::SHA256, "SHA-256"},
+            std::pair{crypt::HashFunction::SHA384, "SHA-384"},
+            std::pair{crypt::HashFunction::SHA512, "SHA-512"},
         };
+
+        void startHashing();
+        bool drawCrcSettings(crypt::CrcParameters &parameters);
+
+        // Declared last so the hashing thread is stopped before anything it accesses gets destroyed
+        std::jthread m_hashThread;
     };
 
 }
@@ -2,10 +2,16 @@
 
 #include <hex/views/view.hpp>
 #include <hex/helpers/encoding_file.hpp>
+#include <hex/helpers/search.hpp>
+#include <hex/pattern_language/pattern_index.hpp>
 
 #include <imgui_memory_editor.h>
 
+#include <atomic>
 #include <list>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <tuple>
 #include <random>
 #include <vector>
@@ -15,9 +21,6 @@ namespace hex::prv { class Provider; }
 
 namespace hex::plugin::builtin {
 
-
-    using SearchFunction = std::vector<std::pair<u64, u64>> (*)(prv::Provider* &provider, std::string string);
-
     class ViewHexEditor : public View {
     public:
         ViewHexEditor();
@@ -32,13 +35,19 @@ namespace hex::plugin::builtin {
 
         std::vector<char> m_searchStringBuffer;
         std::vector<char> m_searchHexBuffer;
-        SearchFunction m_searchFunction = nullptr;
-        std::vector<std::pair<u64, u64>> *m_lastSearchBuffer;
+        bool m_searchCaseSensitive = true;
+        SearchPattern::Encoding m_searchEncoding = SearchPattern::Encoding::ASCII;
+        std::vector<std::pair<u64, u64>> *m_lastSearchBuffer = nullptr;
 
         s64 m_lastSearchIndex = 0;
         std::vector<std::pair<u64, u64>> m_lastStringSearch;
         std::vector<std::pair<u64, u64>> m_lastHexSearch;
 
+        std::mutex m_searchMutex;
+        std::atomic<bool> m_searching = false;
+        bool m_searchJumpPending = false;
+        std::jthread m_searchThread;
+
         s64 m_gotoAddress = 0;
 
         char m_baseAddressBuffer[0x20] = { 0 };
@@ -47,6 +56,15 @@ namespace hex::plugin::builtin {
         std::vector<u8> m_dataToSave;
         std::set<pl::PatternData*> m_highlightedPatterns;
 
+        // Built on the evaluator's thread whenever the patterns change and swapped in on the next frame
+        pl::PatternIndex m_patternIndex;
+        std::optional<pl::PatternIndex> m_pendingPatternIndex;
+        std::mutex m_patternIndexMutex;
+
+        // Regions other views asked to be highlighted in bulk, e.g. YARA matches
+        pl::PatternIndex m_highlightIndex;
+        std::optional<pl::PatternIndex> m_pendingHighlightIndex;
+
         std::string m_loaderScriptScriptPath;
         std::string m_loaderScriptFilePath;
 
@@ -57,6 +75,8 @@ namespace hex::plugin::builtin {
         bool m_advancedDecodingEnabled = false;
 
         void drawSearchPopup();
+        void startSearch(const std::optional<SearchPattern> &pattern);
+        void gotoSearchResult(s64 index);
         void drawGotoPopup();
         void drawEditPopup();
 
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <hex/views/view.hpp>
+#include <hex/helpers/byte_analysis.hpp>
 
 #include <array>
 #include <atomic>
 #include <cstdio>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -30,7 +33,13 @@ namespace hex::plugin::builtin {
         double m_entropyHandlePosition;
 
         std::array<ImU64, 256> m_valueCounts = { 0 };
-        bool m_analyzing = false;
+        std::atomic<bool> m_analyzing = false;
+
+        // Finished analysis, handed over to the UI thread by the analysis thread
+        std::mutex m_analysisMutex;
+        std::shared_ptr<const ByteAnalyzer::Result> m_pendingAnalysis;
+        std::shared_ptr<const ByteAnalyzer::Result> m_analysis;
+        bool m_analysisOutdated = false;
 
         std::pair<u64, u64> m_analyzedRegion = { 0, 0 };
 
@@ -38,6 +47,8 @@ namespace hex::plugin::builtin {
         std::string m_mimeType;
 
         void analyze();
+        void updateAnalysis();
+        void applyAnalysis(const std::shared_ptr<const ByteAnalyzer::Result> &analysis);
     };
 
 }
\ No newline at end of file
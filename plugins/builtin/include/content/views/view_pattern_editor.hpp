@@ -5,8 +5,10 @@
 #include <hex/pattern_language/log_console.hpp>
 #include <hex/providers/provider.hpp>
 
+#include <atomic>
 #include <cstring>
 #include <filesystem>
+#include <optional>
 #include <string_view>
 #include <thread>
 #include <vector>
@@ -31,9 +33,19 @@ namespace hex::plugin::builtin {
         u32 m_selectedPatternFile = 0;
         bool m_runAutomatically = false;
 
-        bool m_evaluatorRunning = false;
+        std::atomic<bool> m_evaluatorRunning = false;
+        std::atomic<bool> m_hasEvaluationResult = false;
+        std::string m_evaluatedCode;
+        prv::Provider *m_evaluatedProvider = nullptr;
         bool m_parserRunning = false;
 
+        // Requested while the previous evaluation was still running, started once that one stopped
+        struct PendingEvaluation {
+            std::string code;
+            bool reuseResult;
+        };
+        std::optional<PendingEvaluation> m_pendingEvaluation;
+
         bool m_hasUnevaluatedChanges = false;
 
         bool m_acceptPatternWindowOpen = false;
@@ -81,7 +93,11 @@ namespace hex::plugin::builtin {
         void clearPatternData();
 
         void parsePattern(const std::string &code);
-        void evaluatePattern(const std::string &code);
+        void evaluatePattern(const std::string &code, bool reuseResult = false);
+        void cancelEvaluation();
+        void resetEvaluation();
+
+        std::jthread m_evaluatorThread;
     };
 
 }
\ No newline at end of file
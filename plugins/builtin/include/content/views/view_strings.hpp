@@ -1,9 +1,15 @@
 #pragma once
 
 #include <hex/views/view.hpp>
+#include <hex/helpers/string_extractor.hpp>
+#include <hex/helpers/string_table.hpp>
 
+#include <atomic>
 #include <cstdio>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 
 namespace hex::plugin::builtin {
 
@@ -23,20 +29,43 @@ namespace hex::plugin::builtin {
         void drawMenu() override;
 
     private:
-        bool m_searching = false;
+        std::atomic<bool> m_searching = false;
         bool m_regex = false;
         bool m_pattern_parsed = false;
 
         std::vector<FoundString> m_foundStrings;
+        StringTable m_strings;
         std::vector<size_t> m_filterIndices;
         int m_minimumLength = 5;
         std::string m_filter;
 
+        StringExtractor::Encoding m_encoding = StringExtractor::Encoding::ASCII;
+        EncodingFile m_encodingFile;
+
+        // Results of the background extraction, picked up by the UI thread on the next frame
+        std::mutex m_pendingStringsMutex;
+        std::vector<FoundString> m_pendingStrings;
+        StringTable m_pendingStringTable;
+        std::atomic<bool> m_pendingStringsReady = false;
+
+        // Filter that produced the current filter indices, used to only look at those again when the filter gets narrower
+        StringFilter m_activeFilter;
+        std::mutex m_filterMutex;
+        std::optional<std::pair<StringFilter, std::vector<size_t>>> m_pendingFilterResult;
+        std::atomic<bool> m_filtering = false;
+        bool m_sortRequired = false;
+
         std::string m_selectedString;
         std::string m_demangledName;
 
         void searchStrings();
-        void createStringContextMenu(const FoundString &foundString);
+        void clearStrings();
+        void startFilter();
+        void createStringContextMenu(size_t index);
+
+        // Declared last so the extraction and filter threads are stopped before anything they access gets destroyed
+        std::jthread m_searchThread;
+        std::jthread m_filterThread;
     };
 
 }
\ No newline at end of file
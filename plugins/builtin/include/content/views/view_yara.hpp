@@ -5,6 +5,14 @@
 #include <imgui.h>
 #include <hex/views/view.hpp>
 
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct YR_RULES;
+
 namespace hex::plugin::builtin {
 
     class ViewYara : public View {
@@ -15,23 +23,52 @@ namespace hex::plugin::builtin {
         void drawContent() override;
         void drawMenu() override;
 
-    private:
         struct YaraMatch {
             std::string identifier;
             std::string variable;
             s64 address;
             s32 size;
             bool wholeDataMatch;
+
+            auto operator<=>(const YaraMatch&) const = default;
+        };
+
+    private:
+        /*
+         * Compiling rule files can take a lot longer than scanning small files with them. Compiled rules are kept
+         * in memory and in the cache folder until one of the rule files or any file they include changes
+         */
+        struct CompiledRules {
+            std::string hash;
+            std::vector<std::pair<fs::path, std::string>> includes;
+            YR_RULES *rules;
+        };
+
+        // Rule files to compile together, each one in its own namespace if it has one
+        struct RuleFile {
+            std::string ruleNamespace;
+            fs::path path;
         };
 
+        std::map<std::vector<fs::path>, CompiledRules> m_compiledRules;
+        std::mutex m_compiledRulesMutex;
+
         std::vector<std::pair<std::string, std::string>> m_rules;
         std::vector<YaraMatch> m_matches;
         u32 m_selectedRule = 0;
+        bool m_scanAllRules = false;
         bool m_matching = false;
         std::vector<char> m_errorMessage;
 
         void reloadRules();
         void applyRules();
+
+        void highlightMatches();
+
+        [[nodiscard]] YR_RULES* getCompiledRules(const std::vector<RuleFile> &ruleFiles);
+        [[nodiscard]] YR_RULES* loadCachedRules(const fs::path &cachePath, const std::string &hash, std::vector<std::pair<fs::path, std::string>> &includes);
+        void saveCachedRules(const fs::path &cachePath, const std::string &hash, YR_RULES *rules, const std::vector<std::pair<fs::path, std::string>> &includes);
+        void clearCompiledRules();
     };
 
 }
\ No newline at end of file
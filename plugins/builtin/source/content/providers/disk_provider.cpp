@@ -1,20 +1,26 @@
 #include "content/providers/disk_provider.hpp"
 
 #include <hex/helpers/fmt.hpp>
+#include <hex/helpers/logger.hpp>
+#include <hex/helpers/utils.hpp>
 
 #include <bitset>
+#include <cerrno>
+#include <cstring>
 #include <filesystem>
 
 #if defined (OS_LINUX)
     #include <fcntl.h>
     #include <unistd.h>
+    #include <linux/fs.h>
+    #include <sys/ioctl.h>
     #include <sys/stat.h>
     #include <sys/types.h>
-
-    #define lseek lseek64
 #elif defined (OS_MACOS)
     #include <fcntl.h>
     #include <unistd.h>
+    #include <sys/disk.h>
+    #include <sys/ioctl.h>
     #include <sys/stat.h>
     #include <sys/types.h>
 #endif
@@ -22,6 +28,10 @@
 namespace hex::plugin::builtin::prv {
 
     DiskProvider::DiskProvider() : Provider() {
+        this->m_readCache.setPageSize(CachePageSize);
+        this->m_readCache.setPageCount(CachePageCount);
+        this->m_readCache.setReadAhead(CacheReadAhead);
+
         this->reloadDrives();
     }
 
@@ -66,9 +76,10 @@ namespace hex::plugin::builtin::prv {
 
             const auto &path = this->m_path.native();
 
-            this->m_diskHandle = reinterpret_cast<HANDLE>(CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+            // All transfers are sector aligned so the system cache can be bypassed, scanning a whole disk would only thrash it
+            this->m_diskHandle = reinterpret_cast<HANDLE>(CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING, nullptr));
             if (this->m_diskHandle == INVALID_HANDLE_VALUE) {
-                this->m_diskHandle = reinterpret_cast<HANDLE>(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr));
+                this->m_diskHandle = reinterpret_cast<HANDLE>(CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_NO_BUFFERING, nullptr));
                 this->m_writable = false;
 
                 if (this->m_diskHandle == INVALID_HANDLE_VALUE)
@@ -88,7 +99,6 @@ namespace hex::plugin::builtin::prv {
                 {
                     this->m_diskSize = diskGeometry.DiskSize.QuadPart;
                     this->m_sectorSize = diskGeometry.Geometry.BytesPerSector;
-                    this->m_sectorBuffer.resize(this->m_sectorSize);
                 }
             }
 
@@ -105,12 +115,6 @@ namespace hex::plugin::builtin::prv {
         #else
             const auto &path = this->m_path.native();
 
-            struct stat driveStat;
-
-            ::stat(path.c_str(), &driveStat) == 0;
-            this->m_diskSize = driveStat.st_size;
-            this->m_sectorSize = 0;
-
             this->m_diskHandle = ::open(path.c_str(), O_RDWR);
             if (this->m_diskHandle == -1) {
                 this->m_diskHandle = ::open(path.c_str(), O_RDONLY);
@@ -122,8 +126,56 @@ namespace hex::plugin::builtin::prv {
                 return false;
             }
 
+            struct stat driveStat = { };
+            if (::fstat(this->m_diskHandle, &driveStat) != 0) {
+                this->close();
+                this->m_readable = false;
+                return false;
+            }
+
+            // Regular files, e.g. disk images, go through the same code path as devices but keep using the page cache
+            this->m_diskSize   = driveStat.st_size;
+            this->m_sectorSize = driveStat.st_blksize;
+
+            #if defined (OS_LINUX)
+                if (S_ISBLK(driveStat.st_mode)) {
+                    u64 diskSize = 0;
+                    int sectorSize = 0;
+
+                    if (::ioctl(this->m_diskHandle, BLKGETSIZE64, &diskSize) == 0)
+                        this->m_diskSize = diskSize;
+                    if (::ioctl(this->m_diskHandle, BLKSSZGET, &sectorSize) == 0 && sectorSize > 0)
+                        this->m_sectorSize = sectorSize;
+
+                    // Bypass the page cache, reading a whole device would otherwise evict everything else from it
+                    ::fcntl(this->m_diskHandle, F_SETFL, ::fcntl(this->m_diskHandle, F_GETFL) | O_DIRECT);
+                }
+            #elif defined (OS_MACOS)
+                if (S_ISBLK(driveStat.st_mode) || S_ISCHR(driveStat.st_mode)) {
+                    u32 sectorSize = 0;
+                    u64 sectorCount = 0;
+
+                    if (::ioctl(this->m_diskHandle, DKIOCGETBLOCKSIZE, &sectorSize) == 0 && sectorSize > 0)
+                        this->m_sectorSize = sectorSize;
+                    if (::ioctl(this->m_diskHandle, DKIOCGETBLOCKCOUNT, &sectorCount) == 0)
+                        this->m_diskSize = sectorCount * this->m_sectorSize;
+
+                    ::fcntl(this->m_diskHandle, F_NOCACHE, 1);
+                }
+            #endif
+
         #endif
 
+        if (this->m_sectorSize == 0)
+            this->m_sectorSize = DefaultSectorSize;
+
+        {
+            std::scoped_lock lock(this->m_bufferPoolMutex);
+            this->m_bufferPool.clear();
+        }
+
+        this->m_readCache.setPageSize(std::max(CachePageSize, this->alignUp(CachePageSize)));
+
         return true;
     }
 
@@ -141,97 +193,145 @@ namespace hex::plugin::builtin::prv {
         #endif
     }
 
-    void DiskProvider::readRaw(u64 offset, void *buffer, size_t size) {
-        #if defined (OS_WINDOWS)
-            DWORD bytesRead = 0;
+    DiskProvider::AlignedBuffer DiskProvider::acquireBuffer() {
+        {
+            std::scoped_lock lock(this->m_bufferPoolMutex);
 
-            u64 startOffset = offset;
+            if (!this->m_bufferPool.empty()) {
+                auto buffer = std::move(this->m_bufferPool.back());
+                this->m_bufferPool.pop_back();
 
-            while (size > 0) {
-                LARGE_INTEGER seekPosition;
-                seekPosition.LowPart = (offset & 0xFFFF'FFFF) - (offset % this->m_sectorSize);
-                seekPosition.HighPart = offset >> 32;
+                return buffer;
+            }
+        }
 
-                if (this->m_sectorBufferAddress != seekPosition.QuadPart) {
-                    ::SetFilePointer(this->m_diskHandle, seekPosition.LowPart, &seekPosition.HighPart, FILE_BEGIN);
-                    ::ReadFile(this->m_diskHandle, this->m_sectorBuffer.data(), this->m_sectorBuffer.size(), &bytesRead, nullptr);
-                    this->m_sectorBufferAddress = seekPosition.QuadPart;
-                }
+        const size_t alignment = std::max(MinimumAlignment, this->m_sectorSize);
+        return AlignedBuffer(new (std::align_val_t(alignment)) u8[this->alignUp(BulkTransferSize)], AlignedDeleter { alignment });
+    }
 
-                std::memcpy(reinterpret_cast<u8*>(buffer) + (offset - startOffset), this->m_sectorBuffer.data() + (offset & (this->m_sectorSize - 1)), std::min(this->m_sectorSize, size));
+    void DiskProvider::releaseBuffer(AlignedBuffer &&buffer) {
+        std::scoped_lock lock(this->m_bufferPoolMutex);
 
-                size = std::max<ssize_t>(static_cast<ssize_t>(size) - this->m_sectorSize, 0);
-                offset += this->m_sectorSize;
-            }
-        #else
-            u64 startOffset = offset;
+        // Buffers allocated for a previously opened disk might not be aligned well enough anymore
+        if (this->m_bufferPool.size() < MaxPooledBuffers && buffer.get_deleter().alignment >= this->m_sectorSize)
+            this->m_bufferPool.push_back(std::move(buffer));
+    }
 
-            while (size > 0) {
-                u64 seekPosition = offset - (offset % this->m_sectorSize);
+    void DiskProvider::readSectors(u64 offset, u8 *buffer, size_t size) {
+        size_t bytesRead = 0;
 
-                if (this->m_sectorBufferAddress != seekPosition) {
-                    ::lseek(this->m_diskHandle, seekPosition, SEEK_SET);
-                    ::read(this->m_diskHandle, buffer, size);
-                    this->m_sectorBufferAddress = seekPosition;
-                }
+        #if defined (OS_WINDOWS)
+            while (bytesRead < size) {
+                OVERLAPPED overlapped = { };
+                overlapped.Offset     = (offset + bytesRead) & 0xFFFF'FFFF;
+                overlapped.OffsetHigh = (offset + bytesRead) >> 32;
 
-                std::memcpy(reinterpret_cast<u8*>(buffer) + (offset - startOffset), this->m_sectorBuffer.data() + (offset & (this->m_sectorSize - 1)), std::min(this->m_sectorSize, size));
+                DWORD transferred = 0;
+                if (!::ReadFile(this->m_diskHandle, buffer + bytesRead, std::min(size - bytesRead, BulkTransferSize), &transferred, &overlapped) || transferred == 0)
+                    break;
 
-                size = std::max<ssize_t>(static_cast<ssize_t>(size) - this->m_sectorSize, 0);
-                offset += this->m_sectorSize;
+                bytesRead += transferred;
+            }
+        #else
+            while (bytesRead < size) {
+                auto transferred = ::pread(this->m_diskHandle, buffer + bytesRead, std::min(size - bytesRead, BulkTransferSize), offset + bytesRead);
+                if (transferred < 0 && errno == EINTR)
+                    continue;
+                if (transferred <= 0)
+                    break;
+
+                bytesRead += transferred;
             }
         #endif
-    }
-
-    void DiskProvider::writeRaw(u64 offset, const void *buffer, size_t size) {
-        #if defined (OS_WINDOWS)
-            DWORD bytesWritten = 0;
 
-            u64 startOffset = offset;
+        // Sectors past the end of the disk or ones that couldn't be read show up as zeros instead of stale data
+        std::memset(buffer + bytesRead, 0x00, size - bytesRead);
+    }
 
-            std::vector<u8> modifiedSectorBuffer;
-            modifiedSectorBuffer.resize(this->m_sectorSize);
+    void DiskProvider::writeSectors(u64 offset, const u8 *buffer, size_t size) {
+        size_t bytesWritten = 0;
 
-            while (size > 0) {
-                u64 sectorBase = offset - (offset % this->m_sectorSize);
-                size_t currSize = std::min(size, this->m_sectorSize);
+        #if defined (OS_WINDOWS)
+            while (bytesWritten < size) {
+                OVERLAPPED overlapped = { };
+                overlapped.Offset     = (offset + bytesWritten) & 0xFFFF'FFFF;
+                overlapped.OffsetHigh = (offset + bytesWritten) >> 32;
 
-                this->readRaw(sectorBase, modifiedSectorBuffer.data(), modifiedSectorBuffer.size());
-                std::memcpy(modifiedSectorBuffer.data() + ((offset - sectorBase) % this->m_sectorSize), reinterpret_cast<const u8*>(buffer) + (startOffset - offset), currSize);
+                DWORD transferred = 0;
+                if (!::WriteFile(this->m_diskHandle, buffer + bytesWritten, std::min(size - bytesWritten, BulkTransferSize), &transferred, &overlapped) || transferred == 0)
+                    break;
 
-                LARGE_INTEGER seekPosition;
-                seekPosition.LowPart = (offset & 0xFFFF'FFFF) - (offset % this->m_sectorSize);
-                seekPosition.HighPart = offset >> 32;
+                bytesWritten += transferred;
+            }
+        #else
+            while (bytesWritten < size) {
+                auto transferred = ::pwrite(this->m_diskHandle, buffer + bytesWritten, std::min(size - bytesWritten, BulkTransferSize), offset + bytesWritten);
+                if (transferred < 0 && errno == EINTR)
+                    continue;
+                if (transferred <= 0)
+                    break;
+
+                bytesWritten += transferred;
+            }
+        #endif
 
-                ::SetFilePointer(this->m_diskHandle, seekPosition.LowPart, &seekPosition.HighPart, FILE_BEGIN);
-                ::WriteFile(this->m_diskHandle, modifiedSectorBuffer.data(), modifiedSectorBuffer.size(), &bytesWritten, nullptr);
+        if (bytesWritten != size)
+            log::error("Failed to write {} bytes to disk at offset 0x{:X}", size - bytesWritten, offset + bytesWritten);
+    }
 
-                offset += currSize;
-                size -= currSize;
-            }
+    void DiskProvider::readRaw(u64 offset, void *buffer, size_t size) {
+        if (!this->isAvailable() || buffer == nullptr || size == 0)
+            return;
+
+        auto bytes = static_cast<u8*>(buffer);
+
+        // Requests that are already aligned, like the read cache's page fetches usually are, don't need an extra copy
+        if (this->isAligned(offset) && this->isAligned(size) && this->isAligned(reinterpret_cast<uintptr_t>(bytes))) {
+            this->readSectors(offset, bytes, size);
+            return;
+        }
+
+        auto bounceBuffer = this->acquireBuffer();
+        ON_SCOPE_EXIT { this->releaseBuffer(std::move(bounceBuffer)); };
+
+        const u64 endOffset = offset + size;
+        const u64 alignedEndOffset = this->alignUp(endOffset);
+        for (u64 transferOffset = this->alignDown(offset); transferOffset < endOffset; transferOffset += BulkTransferSize) {
+            const size_t transferSize = std::min<u64>(BulkTransferSize, alignedEndOffset - transferOffset);
+            this->readSectors(transferOffset, bounceBuffer.get(), transferSize);
+
+            const u64 copyStart = std::max(transferOffset, offset);
+            const u64 copyEnd   = std::min(transferOffset + transferSize, endOffset);
+            std::memcpy(bytes + (copyStart - offset), bounceBuffer.get() + (copyStart - transferOffset), copyEnd - copyStart);
+        }
+    }
 
-        #else
+    void DiskProvider::writeRaw(u64 offset, const void *buffer, size_t size) {
+        if (!this->isAvailable() || buffer == nullptr || size == 0)
+            return;
 
-            u64 startOffset = offset;
+        auto bytes = static_cast<const u8*>(buffer);
 
-            std::vector<u8> modifiedSectorBuffer;
-            modifiedSectorBuffer.resize(this->m_sectorSize);
+        auto bounceBuffer = this->acquireBuffer();
+        ON_SCOPE_EXIT { this->releaseBuffer(std::move(bounceBuffer)); };
 
-            while (size > 0) {
-                u64 sectorBase = offset - (offset % this->m_sectorSize);
-                size_t currSize = std::min(size, this->m_sectorSize);
+        const u64 endOffset = offset + size;
+        const u64 alignedEndOffset = this->alignUp(endOffset);
+        for (u64 transferOffset = this->alignDown(offset); transferOffset < endOffset; transferOffset += BulkTransferSize) {
+            const size_t transferSize = std::min<u64>(BulkTransferSize, alignedEndOffset - transferOffset);
 
-                this->readRaw(sectorBase, modifiedSectorBuffer.data(), modifiedSectorBuffer.size());
-                std::memcpy(modifiedSectorBuffer.data() + ((offset - sectorBase) % this->m_sectorSize), reinterpret_cast<const u8*>(buffer) + (startOffset - offset), currSize);
+            const u64 copyStart = std::max(transferOffset, offset);
+            const u64 copyEnd   = std::min(transferOffset + transferSize, endOffset);
 
-                ::lseek(this->m_diskHandle, sectorBase, SEEK_SET);
-                ::write(this->m_diskHandle, modifiedSectorBuffer.data(), modifiedSectorBuffer.size());
+            // Only the sectors at the edges of the written region are partially overwritten and need their old contents
+            if (copyStart != transferOffset || copyEnd != transferOffset + transferSize)
+                this->readSectors(transferOffset, bounceBuffer.get(), transferSize);
 
-                offset += currSize;
-                size -= currSize;
-            }
+            std::memcpy(bounceBuffer.get() + (copyStart - transferOffset), bytes + (copyStart - offset), copyEnd - copyStart);
 
-        #endif
+            // Never grow image files, the last sector of those doesn't have to be complete
+            this->writeSectors(transferOffset, bounceBuffer.get(), std::min<u64>(transferSize, this->m_diskSize - transferOffset));
+        }
     }
 
     size_t DiskProvider::getActualSize() const {
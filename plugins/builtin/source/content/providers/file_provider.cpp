@@ -49,9 +49,7 @@ namespace hex::plugin::builtin::prv {
 
         this->readRaw(offset - this->getBaseAddress(), buffer, size);
 
-        for (u64 i = 0; i < size; i++)
-            if (getPatches().contains(offset + i))
-                reinterpret_cast<u8*>(buffer)[i] = getPatches()[offset + PageSize * this->m_currPage + i];
+        getPatches().apply(offset, buffer, size);
 
         if (overlays)
             this->applyOverlays(offset, buffer, size);
@@ -61,7 +59,7 @@ namespace hex::plugin::builtin::prv {
         if ((offset - this->getBaseAddress()) > (this->getActualSize() - size) || buffer == nullptr || size == 0)
             return;
 
-        addPatch(offset, buffer, size);
+        addPatch(offset, buffer, size, true);
     }
 
     void FileProvider::readRaw(u64 offset, void *buffer, size_t size) {
@@ -78,6 +76,13 @@ namespace hex::plugin::builtin::prv {
         std::memcpy(reinterpret_cast<u8*>(this->m_mappedFile) + offset, buffer, size);
     }
 
+    std::optional<std::span<const u8>> FileProvider::getRawSpan(u64 offset, size_t size) const {
+        if (!this->isAvailable() || (offset + size) > this->getActualSize())
+            return std::nullopt;
+
+        return std::span(reinterpret_cast<const u8*>(this->m_mappedFile) + offset, size);
+    }
+
     void FileProvider::save() {
         this->applyPatches();
     }
@@ -112,6 +117,8 @@ namespace hex::plugin::builtin::prv {
         }
 
         this->open();
+
+        Provider::resize(newSize);
     }
 
     void FileProvider::insert(u64 offset, size_t size) {
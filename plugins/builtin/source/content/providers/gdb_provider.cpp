@@ -1,11 +1,13 @@
 #include "content/providers/gdb_provider.hpp"
 
+#include <cstdlib>
 #include <cstring>
 #include <thread>
 #include <chrono>
 
 #include <hex/helpers/fmt.hpp>
 #include <hex/helpers/crypto.hpp>
+#include <hex/helpers/utils.hpp>
 
 namespace hex::plugin::builtin::prv {
 
@@ -53,24 +55,59 @@ namespace hex::plugin::builtin::prv {
             socket.writeString("+");
         }
 
+        std::optional<std::string> receivePacket(Socket &socket) {
+            std::string buffer;
+
+            // Large replies arrive split over multiple reads, keep reading until the checksum after the end marker is there
+            while (socket.isConnected()) {
+                auto received = socket.readString(0x1000);
+                if (received.empty())
+                    return std::nullopt;
+
+                buffer += received;
+
+                auto start = buffer.find('$');
+                if (start == std::string::npos)
+                    continue;
+
+                auto end = buffer.find('#', start);
+                if (end != std::string::npos && buffer.length() >= end + 3)
+                    return parsePacket(buffer.substr(start, end + 3 - start));
+            }
+
+            return std::nullopt;
+        }
+
+        std::string decodeRunLength(const std::string &data) {
+            std::string result;
+            result.reserve(data.length());
+
+            // A '*' followed by a count character repeats the previous character, the count is offset by 29
+            for (size_t i = 0; i < data.length(); i++) {
+                if (data[i] == '*' && i + 1 < data.length() && !result.empty()) {
+                    result.append(data[i + 1] - 29, result.back());
+                    i++;
+                } else {
+                    result.push_back(data[i]);
+                }
+            }
+
+            return result;
+        }
+
         std::vector<u8> readMemory(Socket &socket, u64 address, size_t size) {
             std::string packet = createPacket(hex::format("m{:X},{:X}", address, size));
 
             socket.writeString(packet);
 
-            auto receivedPacket = socket.readString(size * 2 + 4);
-
-            if (receivedPacket.empty())
-                return { };
-
-            auto receivedData = parsePacket(receivedPacket);
+            auto receivedData = receivePacket(socket);
             if (!receivedData.has_value())
                 return { };
 
             if (receivedData->size() == 3 && receivedData->starts_with("E"))
                 return { };
 
-            auto data = crypt::decode16(receivedData.value());
+            auto data = crypt::decode16(decodeRunLength(receivedData.value()));
 
             data.resize(size);
 
@@ -87,7 +124,31 @@ namespace hex::plugin::builtin::prv {
 
             socket.writeString(packet);
 
-            auto receivedPacket = socket.readString(3);
+            auto receivedPacket = receivePacket(socket);
+        }
+
+        std::optional<size_t> queryPacketSize(Socket &socket) {
+            socket.writeString(createPacket("qSupported"));
+
+            auto receivedData = receivePacket(socket);
+            if (!receivedData.has_value())
+                return std::nullopt;
+
+            for (const auto &feature : hex::splitString(*receivedData, ";")) {
+                if (feature.starts_with("PacketSize=")) {
+                    auto packetSize = std::strtoull(feature.c_str() + std::strlen("PacketSize="), nullptr, 16);
+                    if (packetSize > 0)
+                        return packetSize;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        std::optional<std::string> queryStopReason(Socket &socket) {
+            socket.writeString(createPacket("?"));
+
+            return receivePacket(socket);
         }
 
         bool enableNoAckMode(Socket &socket) {
@@ -113,7 +174,8 @@ namespace hex::plugin::builtin::prv {
     }
 
     GDBProvider::GDBProvider() : Provider(), m_size(0xFFFF'FFFF) {
-
+        this->m_readCache.setPageSize(CacheLineSize);
+        this->m_readCache.setReadAhead(CacheReadAhead);
     }
 
     GDBProvider::~GDBProvider() {
@@ -142,71 +204,44 @@ namespace hex::plugin::builtin::prv {
     }
 
 
-    void GDBProvider::read(u64 offset, void *buffer, size_t size, bool overlays) {
+    void GDBProvider::write(u64 offset, const void *buffer, size_t size) {
         if ((offset - this->getBaseAddress()) > (this->getActualSize() - size) || buffer == nullptr || size == 0)
             return;
 
         offset -= this->getBaseAddress();
 
-        u64 alignedOffset = offset - (offset % CacheLineSize);
-
-        if (size <= CacheLineSize) {
-            std::scoped_lock lock(this->m_cacheLock);
-
-            const auto &cacheLine = std::find_if(this->m_cache.begin(), this->m_cache.end(), [&](auto &line){
-                return line.address == alignedOffset;
-            });
-
-            if (cacheLine != this->m_cache.end()) {
-                // Cache hit
-
-            } else {
-                // Cache miss
-
-                this->m_cache.push_back({ alignedOffset, { 0 } });
-            }
-
-            if (cacheLine != this->m_cache.end())
-                std::memcpy(buffer, &cacheLine->data[0] + (offset % CacheLineSize), size);
-        } else {
-            while (size > 0) {
-                size_t readSize = std::min(size, CacheLineSize);
-                this->readRaw(offset, buffer, readSize);
-
-                size -= readSize;
-                offset += readSize;
-            }
+        {
+            std::scoped_lock lock(this->m_socketMutex);
+            gdb::writeMemory(this->m_socket, offset, buffer, size);
         }
 
-        for (u64 i = 0; i < size; i++)
-            if (getPatches().contains(offset + i))
-                reinterpret_cast<u8*>(buffer)[i] = getPatches()[offset + PageSize * this->m_currPage + i];
-
-        if (overlays)
-            this->applyOverlays(offset, buffer, size);
+        this->m_readCache.invalidate(offset, size);
+        this->updateRevision(true);
     }
 
-    void GDBProvider::write(u64 offset, const void *buffer, size_t size) {
-        if ((offset - this->getBaseAddress()) > (this->getActualSize() - size) || buffer == nullptr || size == 0)
+    void GDBProvider::readRaw(u64 offset, void *buffer, size_t size) {
+        if (offset > (this->getActualSize() - size) || buffer == nullptr || size == 0)
             return;
 
-        offset -= this->getBaseAddress();
+        std::scoped_lock lock(this->m_socketMutex);
 
-        gdb::writeMemory(this->m_socket, offset, buffer, size);
-    }
+        // Read-ahead requests many pages at once, fetch them with as few packets as the server allows
+        auto bytes = static_cast<u8*>(buffer);
+        for (u64 curr = 0; curr < size; curr += this->m_maxReadSize) {
+            const size_t readSize = std::min<u64>(size - curr, this->m_maxReadSize);
+            auto data = gdb::readMemory(this->m_socket, offset + curr, readSize);
 
-    void GDBProvider::readRaw(u64 offset, void *buffer, size_t size) {
-        if ((offset - this->getBaseAddress()) > (this->getActualSize() - size) || buffer == nullptr || size == 0)
-            return;
-
-        auto data = gdb::readMemory(this->m_socket, offset, size);
-        std::memcpy(buffer, &data[0], data.size());
+            // Memory the target can't read shows up as zeros instead of leftovers from a previous read
+            std::memset(bytes + curr, 0x00, readSize);
+            std::memcpy(bytes + curr, data.data(), std::min(data.size(), readSize));
+        }
     }
 
     void GDBProvider::writeRaw(u64 offset, const void *buffer, size_t size) {
-        if ((offset - this->getBaseAddress()) > (this->getActualSize() - size) || buffer == nullptr || size == 0)
+        if (offset > (this->getActualSize() - size) || buffer == nullptr || size == 0)
             return;
 
+        std::scoped_lock lock(this->m_socketMutex);
         gdb::writeMemory(this->m_socket, offset, buffer, size);
     }
 
@@ -250,27 +285,39 @@ namespace hex::plugin::builtin::prv {
         }
 
         if (this->m_socket.isConnected()) {
+            // Every reply contains two characters per byte and four characters of framing
+            if (auto packetSize = gdb::queryPacketSize(this->m_socket); packetSize.has_value() && *packetSize > 4)
+                this->m_maxReadSize = std::max<size_t>((*packetSize - 4) / 2, 1);
+            else
+                this->m_maxReadSize = CacheLineSize;
+
+            this->m_readCache.setPageCount(std::max<u64>(this->m_cacheSize / CacheLineSize, 1));
+            this->m_readCache.invalidate();
+
+            this->m_lastStopReason = gdb::queryStopReason(this->m_socket).value_or("");
+
             this->m_cacheUpdateThread = std::thread([this]() {
-                auto cacheLine = this->m_cache.begin();
-                while (this->isConnected()) {
-                    {
-                        std::scoped_lock lock(this->m_cacheLock);
+                auto lastCheck = std::chrono::steady_clock::now();
 
-                        if (cacheLine != this->m_cache.end()) {
-                            auto data = gdb::readMemory(this->m_socket, cacheLine->address, 0x1000);
+                // Memory only changes while the target runs, so cached data is kept until the target reports a different stop state
+                while (this->isConnected()) {
+                    if (std::chrono::steady_clock::now() - lastCheck >= StopStateCheckInterval) {
+                        std::optional<std::string> stopReason;
+                        {
+                            std::scoped_lock lock(this->m_socketMutex);
+                            stopReason = gdb::queryStopReason(this->m_socket);
+                        }
 
-                            while (this->m_cache.size() > 10) {
-                                this->m_cache.pop_front();
-                                cacheLine = this->m_cache.begin();
-                            }
+                        if (stopReason.has_value() && *stopReason != this->m_lastStopReason) {
+                            this->m_lastStopReason = *stopReason;
 
-                            std::memcpy(cacheLine->data.data(), data.data(), data.size());
+                            this->m_readCache.invalidate();
+                            this->updateRevision(true);
                         }
 
-                        cacheLine++;
-                        if (cacheLine == this->m_cache.end())
-                            cacheLine = this->m_cache.begin();
+                        lastCheck = std::chrono::steady_clock::now();
                     }
+
                     std::this_thread::sleep_for(100ms);
                 }
             });
@@ -305,6 +352,10 @@ namespace hex::plugin::builtin::prv {
         ImGui::SameLine();
         ImGui::InputScalar("hex.common.size"_lang, ImGuiDataType_U64, &this->m_size, nullptr, nullptr, "%llx", ImGuiInputTextFlags_CharsHexadecimal);
 
+        ImGui::TextUnformatted("0x");
+        ImGui::SameLine();
+        ImGui::InputScalar("hex.builtin.provider.gdb.cache_size"_lang, ImGuiDataType_U64, &this->m_cacheSize, nullptr, nullptr, "%llx", ImGuiInputTextFlags_CharsHexadecimal);
+
         if (this->m_port < 0)
             this->m_port = 0;
         else if (this->m_port > 0xFFFF)
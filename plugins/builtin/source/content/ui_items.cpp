@@ -44,6 +44,9 @@ namespace hex::plugin::builtin {
                 if (taskCount > 0) {
                     taskProgress = SharedData::runningTasks.front()->getProgress();
                     taskName = SharedData::runningTasks.front()->getName();
+
+                    if (const auto &status = SharedData::runningTasks.front()->getStatus(); !status.empty())
+                        taskName += hex::format(" ({})", status);
                 }
             }
 
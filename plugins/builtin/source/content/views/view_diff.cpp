@@ -4,10 +4,13 @@
 #include <hex/providers/provider.hpp>
 
 #include <hex/helpers/fmt.hpp>
+#include <hex/helpers/utils.hpp>
 
 #include <hex/api/content_registry.hpp>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+
 namespace hex::plugin::builtin {
 
     ViewDiff::ViewDiff() : View("hex.builtin.view.diff.name") {
@@ -17,7 +20,7 @@ namespace hex::plugin::builtin {
                 auto columnCount = ContentRegistry::Settings::getSetting("hex.builtin.setting.hex_editor", "hex.builtin.setting.hex_editor.column_count");
 
                 if (columnCount.is_number())
-                    this->m_columnCount = static_cast<int>(columnCount);
+                    this->m_columnCount = std::clamp(static_cast<int>(columnCount), 1, MaxColumnCount);
             }
 
             {
@@ -34,11 +37,20 @@ namespace hex::plugin::builtin {
                     this->m_upperCaseHex = static_cast<int>(upperCaseHex);
             }
         });
-        
+
+        EventManager::subscribe<EventFileUnloaded>(this, [this]{
+            this->resetDiff();
+        });
+
+        EventManager::subscribe<EventProviderDeleted>(this, [this](hex::prv::Provider*){
+            this->resetDiff();
+        });
     }
 
     ViewDiff::~ViewDiff() {
         EventManager::unsubscribe<EventSettingsChanged>(this);
+        EventManager::unsubscribe<EventFileUnloaded>(this);
+        EventManager::unsubscribe<EventProviderDeleted>(this);
     }
 
     static void drawProviderSelector(int &provider) {
@@ -65,46 +77,191 @@ namespace hex::plugin::builtin {
         return (color & 0x00FFFFFF) | 0x40000000;
     }
 
-    enum class DiffResult { Same, Changed, Added, Removed };
+    static u32 getEditColor(BinaryDiff::EditType type) {
+        switch (type) {
+            case BinaryDiff::EditType::Insert:
+                return ImGui::GetCustomColorU32(ImGuiCustomCol_ToolbarGreen);
+            case BinaryDiff::EditType::Delete:
+                return ImGui::GetCustomColorU32(ImGuiCustomCol_ToolbarRed);
+            case BinaryDiff::EditType::Replace:
+                return ImGui::GetCustomColorU32(ImGuiCustomCol_ToolbarYellow);
+            default:
+                return 0x00;
+        }
+    }
+
     struct LineInfo {
-        std::vector<u8> bytes;
+        u64 address = 0;
+        std::array<u8, ViewDiff::MaxColumnCount> bytes;
         s64 validBytes = 0;
     };
 
-    static DiffResult diffBytes(u8 index, const LineInfo &a, const LineInfo &b) {
-        /* Very simple binary diff. Only detects additions and changes */
-        if (a.validBytes > index) {
-            if (b.validBytes <= index)
-                return DiffResult::Added;
-            else if (a.bytes[index] != b.bytes[index])
-                return DiffResult::Changed;
+    void ViewDiff::startDiff() {
+        auto &providers = ImHexApi::Provider::getProviders();
+        auto providerA = providers[this->m_providerA], providerB = providers[this->m_providerB];
+
+        // Results of other providers are meaningless, outdated ones of the same providers are kept until the new ones are ready
+        if (this->m_diffedProviders != std::array { this->m_providerA, this->m_providerB } || this->m_diffedAligned != this->m_alignData) {
+            this->m_edits.clear();
+            this->m_layoutColumnCount = 0;
         }
 
-        return DiffResult::Same;
+        this->m_diffedProviders = { this->m_providerA, this->m_providerB };
+        this->m_diffedRevisions = { providerA->getRevision(), providerB->getRevision() };
+        this->m_diffedAligned = this->m_alignData;
+
+        // Stop a diff that's still running for outdated data before its results can be mistaken for the new ones
+        this->m_diffThread = std::jthread();
+        this->m_diffing = true;
+        {
+            std::scoped_lock lock(this->m_diffMutex);
+            this->m_pendingEdits.reset();
+        }
+
+        this->m_diffThread = std::jthread([this, providerA, providerB, aligned = this->m_alignData](const std::stop_token &stopToken) {
+            ON_SCOPE_EXIT { this->m_diffing = false; };
+
+            auto task = ImHexApi::Tasks::createTask("hex.builtin.view.diff.diffing", providerA->getSize() + providerB->getSize());
+
+            const auto progress = [&task](u64 processedSize) {
+                task.update(processedSize);
+            };
+
+            auto edits = aligned ? BinaryDiff::diff(providerA, providerB, progress, stopToken) : BinaryDiff::compare(providerA, providerB, progress, stopToken);
+
+            if (!edits.has_value())
+                return;
+
+            {
+                std::scoped_lock lock(this->m_diffMutex);
+                this->m_pendingEdits = std::move(edits);
+            }
+        });
     }
 
-    void ViewDiff::drawDiffLine(const std::array<int, 2> &providerIds, u64 row) const {
+    void ViewDiff::resetDiff() {
+        // The diff thread reads from the providers directly and provider indices shift when one gets removed
+        this->m_diffThread = std::jthread();
 
-        std::array<LineInfo, 2> lineInfo;
+        {
+            std::scoped_lock lock(this->m_diffMutex);
+            this->m_pendingEdits.reset();
+        }
 
-        u8 addressDigitCount = 0;
-        for (u8 i = 0; i < 2; i++) {
-            int id = providerIds[i];
-            if (id < 0) continue;
+        this->m_providerA = -1;
+        this->m_providerB = -1;
+        this->m_diffedProviders = { -1, -1 };
+        this->m_edits.clear();
+        this->m_layoutColumnCount = 0;
+    }
+
+    void ViewDiff::updateRowLayout() {
+        this->m_layoutColumnCount = this->m_columnCount;
+        this->m_layoutDifferencesOnly = this->m_differencesOnly;
+
+        this->m_rowStarts.clear();
+        this->m_rowStarts.reserve(this->m_edits.size());
+        this->m_rowCount = 0;
+        this->m_differenceCount = 0;
 
-            auto &provider = ImHexApi::Provider::getProviders()[id];
+        for (const auto &edit : this->m_edits) {
+            this->m_rowStarts.push_back(this->m_rowCount);
 
-            // Read one line of each provider
-            lineInfo[i].bytes.resize(this->m_columnCount);
-            provider->read(row * this->m_columnCount, lineInfo[i].bytes.data(), lineInfo[i].bytes.size());
-            lineInfo[i].validBytes = std::min<s64>(this->m_columnCount, provider->getSize() - row * this->m_columnCount);
+            // Identical ranges collapse into a single row that only shows their size
+            if (edit.type == BinaryDiff::EditType::Equal && this->m_differencesOnly)
+                this->m_rowCount += 1;
+            else
+                this->m_rowCount += (std::max(edit.sizeA, edit.sizeB) + this->m_columnCount - 1) / this->m_columnCount;
+
+            if (edit.type != BinaryDiff::EditType::Equal)
+                this->m_differenceCount++;
+        }
+
+        // Both sides show their own addresses, so the address width has to fit the larger provider
+        auto &providers = ImHexApi::Provider::getProviders();
+
+        this->m_addressDigitCount = 0;
+        for (int id : this->m_diffedProviders) {
+            if (id < 0 || id >= int(providers.size()))
+                continue;
 
-            // Calculate address width
             u8 addressDigits = 0;
-            for (size_t n = provider->getSize() - 1; n > 0; n >>= 4)
+            for (size_t n = providers[id]->getBaseAddress() + providers[id]->getSize() - 1; n > 0; n >>= 4)
                 addressDigits++;
 
-            addressDigitCount = std::max(addressDigits, addressDigitCount);
+            this->m_addressDigitCount = std::max(addressDigits, this->m_addressDigitCount);
+        }
+
+        this->m_minimap.fill(BinaryDiff::EditType::Equal);
+        for (size_t i = 0; i < this->m_edits.size(); i++) {
+            const auto type = this->m_edits[i].type;
+            if (type == BinaryDiff::EditType::Equal)
+                continue;
+
+            const u64 endRow = i + 1 < this->m_rowStarts.size() ? this->m_rowStarts[i + 1] : this->m_rowCount;
+            const u64 firstBin = this->m_rowStarts[i] * MinimapBinCount / this->m_rowCount;
+            const u64 lastBin  = (endRow - 1) * MinimapBinCount / this->m_rowCount;
+
+            // Bins containing different kinds of differences are shown as replaced
+            for (u64 bin = firstBin; bin <= lastBin; bin++) {
+                auto &binType = this->m_minimap[bin];
+                binType = binType == BinaryDiff::EditType::Equal || binType == type ? type : BinaryDiff::EditType::Replace;
+            }
+        }
+    }
+
+    void ViewDiff::jumpToDifference(bool forward) {
+        if (this->m_edits.empty())
+            return;
+
+        // Edits alternate between equal and different ranges, the next difference is at most two edits away
+        const size_t currEdit = std::upper_bound(this->m_rowStarts.begin(), this->m_rowStarts.end(), this->m_firstVisibleRow) - this->m_rowStarts.begin() - 1;
+
+        if (forward) {
+            for (size_t i = currEdit + 1; i < this->m_edits.size(); i++) {
+                if (this->m_edits[i].type != BinaryDiff::EditType::Equal) {
+                    this->m_scrollToRow = this->m_rowStarts[i];
+                    return;
+                }
+            }
+        } else {
+            for (size_t i = currEdit; i > 0; i--) {
+                const auto &edit = this->m_edits[i - 1];
+                if (edit.type != BinaryDiff::EditType::Equal) {
+                    this->m_scrollToRow = this->m_rowStarts[i - 1];
+                    return;
+                }
+            }
+        }
+    }
+
+    void ViewDiff::drawDiffLine(u64 row) const {
+        const size_t editIndex = std::upper_bound(this->m_rowStarts.begin(), this->m_rowStarts.end(), row) - this->m_rowStarts.begin() - 1;
+        const auto &edit = this->m_edits[editIndex];
+        const u64 rowOffset = (row - this->m_rowStarts[editIndex]) * this->m_columnCount;
+
+        if (edit.type == BinaryDiff::EditType::Equal && this->m_layoutDifferencesOnly) {
+            const auto text = hex::format("hex.builtin.view.diff.identical"_lang, edit.sizeA);
+
+            for (u8 i = 0; i < 2; i++) {
+                ImGui::TableSetColumnIndex(i * 2 + 1);
+                ImGui::TextFormattedColored(ImGui::GetColorU32(ImGuiCol_TextDisabled), "{}", text);
+            }
+
+            return;
+        }
+
+        std::array<LineInfo, 2> lineInfo;
+        for (u8 i = 0; i < 2; i++) {
+            auto &provider = ImHexApi::Provider::getProviders()[this->m_diffedProviders[i]];
+
+            const u64 offset = i == 0 ? edit.offsetA : edit.offsetB;
+            const u64 size   = i == 0 ? edit.sizeA   : edit.sizeB;
+
+            // Read this edit's part of the line of each provider
+            lineInfo[i].address = provider->getBaseAddress() + offset + rowOffset;
+            lineInfo[i].validBytes = size > rowOffset ? std::min<s64>(this->m_columnCount, size - rowOffset) : 0;
+            provider->read(lineInfo[i].address, lineInfo[i].bytes.data(), lineInfo[i].validBytes);
         }
 
         ImDrawList* drawList = ImGui::GetWindowDrawList();
@@ -114,39 +271,28 @@ namespace hex::plugin::builtin {
 
         auto startY = ImGui::GetCursorPosY();
 
-        ImGui::TextFormatted(this->m_upperCaseHex ? "{:0{}X}:" : "{:0{}x}:", row * this->m_columnCount, addressDigitCount);
-        ImGui::SetCursorPosY(startY);
-        ImGui::TableNextColumn();
-
         const ImColor colorText = ImGui::GetColorU32(ImGuiCol_Text);
         const ImColor colorDisabled = this->m_greyedOutZeros ? ImGui::GetColorU32(ImGuiCol_TextDisabled) : static_cast<u32>(colorText);
 
+        const auto highlightColor = getDiffColor(getEditColor(edit.type));
 
         for (s8 curr = 0; curr < 2; curr++) {
             auto other = !curr;
 
+            if (lineInfo[curr].validBytes > 0)
+                ImGui::TextFormatted(this->m_upperCaseHex ? "{:0{}X}:" : "{:0{}x}:", lineInfo[curr].address, this->m_addressDigitCount);
+            ImGui::SetCursorPosY(startY);
+            ImGui::TableNextColumn();
+
             std::optional<ImVec2> lastHighlightEnd;
 
             for (s64 col = 0; col < lineInfo[curr].validBytes; col++) {
                 auto pos = ImGui::GetCursorScreenPos();
 
-                // Diff bytes
-                std::optional<u32> highlightColor;
-                switch (diffBytes(col, lineInfo[curr], lineInfo[other])) {
-                    default:
-                    case DiffResult::Same:
-                        /* No highlight */
-                        break;
-                    case DiffResult::Changed:
-                        highlightColor = getDiffColor(ImGui::GetCustomColorU32(ImGuiCustomCol_ToolbarYellow));
-                        break;
-                    case DiffResult::Added:
-                        highlightColor = getDiffColor(ImGui::GetCustomColorU32(ImGuiCustomCol_ToolbarGreen));
-                        break;
-                    case DiffResult::Removed:
-                        highlightColor = getDiffColor(ImGui::GetCustomColorU32(ImGuiCustomCol_ToolbarRed));
-                        break;
-                }
+                // Replaced ranges only highlight the bytes that actually differ from the other side
+                bool highlight = edit.type != BinaryDiff::EditType::Equal;
+                if (edit.type == BinaryDiff::EditType::Replace && col < lineInfo[other].validBytes)
+                    highlight = lineInfo[curr].bytes[col] != lineInfo[other].bytes[col];
 
                 // Draw byte
                 u8 byte = lineInfo[curr].bytes[col];
@@ -156,19 +302,85 @@ namespace hex::plugin::builtin {
                 ImGui::SetCursorPosY(startY);
 
                 // Draw highlighting
-                if (highlightColor.has_value()) {
-                    drawList->AddRectFilled(lastHighlightEnd.value_or(pos), pos + highlightSize, highlightColor.value());
+                if (highlight) {
+                    drawList->AddRectFilled(lastHighlightEnd.value_or(pos), pos + highlightSize, highlightColor);
                     lastHighlightEnd = pos + ImVec2((glyphWidth - 1) * 2, 0);
                 } else {
                     lastHighlightEnd.reset();
                 }
             }
-            ImGui::TableNextColumn();
+
+            if (curr == 0)
+                ImGui::TableNextColumn();
+        }
+
+    }
+
+    void ViewDiff::drawMinimap(float height) {
+        const auto size = ImVec2(MinimapWidth * SharedData::globalScale, height);
+        const auto start = ImGui::GetCursorScreenPos();
+
+        ImGui::InvisibleButton("##minimap", size);
+
+        // Clicking or dragging centers the view on that part of the diff
+        if (ImGui::IsItemActive() && this->m_rowCount > 0) {
+            const float position = std::clamp((ImGui::GetMousePos().y - start.y) / size.y, 0.0F, 1.0F);
+            const u64 row = position * this->m_rowCount;
+
+            this->m_scrollToRow = row > this->m_visibleRowCount / 2 ? row - this->m_visibleRowCount / 2 : 0;
+        }
+
+        auto drawList = ImGui::GetWindowDrawList();
+        drawList->AddRectFilled(start, start + size, ImGui::GetColorU32(ImGuiCol_FrameBg));
+
+        if (this->m_rowCount == 0)
+            return;
+
+        const float binHeight = size.y / MinimapBinCount;
+        for (size_t bin = 0; bin < MinimapBinCount;) {
+            const auto type = this->m_minimap[bin];
+
+            size_t end = bin + 1;
+            while (end < MinimapBinCount && this->m_minimap[end] == type)
+                end++;
+
+            if (type != BinaryDiff::EditType::Equal)
+                drawList->AddRectFilled(start + ImVec2(0, bin * binHeight), start + ImVec2(size.x, end * binHeight), getEditColor(type));
+
+            bin = end;
         }
 
+        // Visible part of the diff
+        const float visibleStart = float(this->m_firstVisibleRow) / this->m_rowCount;
+        const float visibleEnd   = float(this->m_firstVisibleRow + this->m_visibleRowCount) / this->m_rowCount;
+        drawList->AddRect(start + ImVec2(0, visibleStart * size.y), start + ImVec2(size.x, std::min(visibleEnd, 1.0F) * size.y), ImGui::GetColorU32(ImGuiCol_Text));
     }
 
     void ViewDiff::drawContent() {
+        {
+            std::scoped_lock lock(this->m_diffMutex);
+            if (this->m_pendingEdits.has_value()) {
+                this->m_edits = std::move(*this->m_pendingEdits);
+                this->m_pendingEdits.reset();
+                this->m_layoutColumnCount = 0;
+            }
+        }
+
+        auto &providers = ImHexApi::Provider::getProviders();
+        if (this->m_providerA >= int(providers.size()))
+            this->m_providerA = -1;
+        if (this->m_providerB >= int(providers.size()))
+            this->m_providerB = -1;
+
+        const bool providersSelected = this->m_providerA >= 0 && this->m_providerB >= 0;
+        if (providersSelected) {
+            if (this->m_diffedProviders != std::array { this->m_providerA, this->m_providerB } || this->m_diffedAligned != this->m_alignData || this->m_diffedRevisions != std::array { providers[this->m_providerA]->getRevision(), providers[this->m_providerB]->getRevision() })
+                this->startDiff();
+        }
+
+        if (this->m_layoutColumnCount != this->m_columnCount || this->m_layoutDifferencesOnly != this->m_differencesOnly)
+            this->updateRowLayout();
+
         if (ImGui::Begin(View::toWindowName("hex.builtin.view.diff.name").c_str(), &this->getWindowOpenState(), ImGuiWindowFlags_NoCollapse)) {
 
             ImGui::SameLine();
@@ -185,39 +397,73 @@ namespace hex::plugin::builtin {
             ImGui::PushID(2);
             drawProviderSelector(this->m_providerB);
             ImGui::PopID();
+
+            ImGui::SameLine();
+            ImGui::Spacing();
+            ImGui::SameLine();
+            if (ImGui::ArrowButton("prevDiff", ImGuiDir_Up))
+                this->jumpToDifference(false);
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("%s", static_cast<const char*>("hex.builtin.view.diff.previous"_lang));
+            ImGui::SameLine();
+            if (ImGui::ArrowButton("nextDiff", ImGuiDir_Down))
+                this->jumpToDifference(true);
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("%s", static_cast<const char*>("hex.builtin.view.diff.next"_lang));
+
+            ImGui::SameLine();
+            ImGui::Checkbox("hex.builtin.view.diff.align"_lang, &this->m_alignData);
+            ImGui::SameLine();
+            ImGui::Checkbox("hex.builtin.view.diff.differences_only"_lang, &this->m_differencesOnly);
+
+            ImGui::SameLine();
+            if (this->m_diffing)
+                ImGui::TextSpinner("hex.builtin.view.diff.diffing"_lang);
+            else if (providersSelected)
+                ImGui::TextFormatted("hex.builtin.view.diff.differences"_lang, this->m_differenceCount);
+
             ImGui::Separator();
 
+            const auto tableSize = ImGui::GetContentRegionAvail() - ImVec2(MinimapWidth * SharedData::globalScale + ImGui::GetStyle().ItemSpacing.x, 0);
+
             ImGui::PushStyleVar(ImGuiStyleVar_CellPadding, ImVec2(20, 0));
-            if (ImGui::BeginTable("diff", 3, ImGuiTableFlags_ScrollY | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingFixedFit)) {
+            if (ImGui::BeginTable("diff", 4, ImGuiTableFlags_ScrollY | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingFixedFit, tableSize)) {
                 ImGui::TableSetupScrollFreeze(0, 1);
 
                 ImGui::TableNextRow();
-                ImGui::TableNextColumn();
 
 
                 // Draw header line
                 {
                     auto glyphWidth = ImGui::CalcTextSize("0").x + 1;
                     for (u8 i = 0; i < 2; i++) {
+                        ImGui::TableSetColumnIndex(i * 2 + 1);
                         for (u32 col = 0; col < this->m_columnCount; col++) {
                             ImGui::TextFormatted(this->m_upperCaseHex ? "{:02X}" : "{:02x}", col);
                             ImGui::SameLine(0.0F, col % 8 == 7 ? glyphWidth * 1.5F : glyphWidth * 0.75F);
                         }
-                        ImGui::TableNextColumn();
                     }
                 }
 
-                if (this->m_providerA >= 0 && this->m_providerB >= 0) {
-                    auto &providers = ImHexApi::Provider::getProviders();
+                const auto rowHeight = ImGui::GetTextLineHeight();
+                if (this->m_scrollToRow.has_value()) {
+                    ImGui::SetScrollY(*this->m_scrollToRow * rowHeight);
+                    this->m_scrollToRow.reset();
+                }
+
+                this->m_firstVisibleRow = ImGui::GetScrollY() / rowHeight;
+                this->m_visibleRowCount = ImGui::GetWindowHeight() / rowHeight;
+
+                if (providersSelected && this->m_diffedProviders == std::array { this->m_providerA, this->m_providerB } && !this->m_edits.empty()) {
                     ImGuiListClipper clipper;
-                    clipper.Begin(std::max(providers[this->m_providerA]->getSize() / this->m_columnCount, providers[this->m_providerB]->getSize() / this->m_columnCount) + 1, ImGui::GetTextLineHeight());
+                    clipper.Begin(this->m_rowCount, rowHeight);
 
                     // Draw diff lines
                     while (clipper.Step()) {
                         for (u64 row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
                             ImGui::TableNextRow();
                             ImGui::TableNextColumn();
-                            drawDiffLine({this->m_providerA, this->m_providerB}, row);
+                            drawDiffLine(row);
                         }
                     }
                 }
@@ -225,6 +471,9 @@ namespace hex::plugin::builtin {
             }
             ImGui::PopStyleVar();
 
+            ImGui::SameLine();
+            this->drawMinimap(tableSize.y);
+
         }
         ImGui::End();
     }
@@ -233,4 +482,4 @@ namespace hex::plugin::builtin {
 
     }
 
-}
\ No newline at end of file
+}
@@ -2,8 +2,10 @@
 
 #include <hex/providers/provider.hpp>
 #include <hex/helpers/fmt.hpp>
+#include <hex/helpers/utils.hpp>
 
 #include <cstring>
+#include <memory>
 #include <thread>
 
 using namespace std::literals::string_literals;
@@ -27,7 +29,9 @@ namespace hex::plugin::builtin {
         });
 
         EventManager::subscribe<EventFileUnloaded>(this, [this]{
-            this->m_disassembly.clear();
+            this->stopDisassembling();
+            this->m_disassemblyIndex = { };
+            this->resetRows();
         });
     }
 
@@ -35,82 +39,171 @@ namespace hex::plugin::builtin {
         EventManager::unsubscribe<EventDataChanged>(this);
         EventManager::unsubscribe<EventRegionSelected>(this);
         EventManager::unsubscribe<EventFileUnloaded>(this);
+
+        this->resetRows();
     }
 
-    void ViewDisassembler::disassemble() {
-        this->m_disassembly.clear();
-        this->m_disassembling = true;
+    cs_mode ViewDisassembler::getMode() const {
+        cs_mode mode = cs_mode(this->m_modeBasicARM | this->m_modeExtraARM | this->m_modeBasicMIPS | this->m_modeBasicX86 | this->m_modeBasicPPC);
+
+        if (this->m_littleEndianMode)
+            mode = cs_mode(mode | CS_MODE_LITTLE_ENDIAN);
+        else
+            mode = cs_mode(mode | CS_MODE_BIG_ENDIAN);
+
+        if (this->m_micoMode)
+            mode = cs_mode(mode | CS_MODE_MICRO);
+
+        if (this->m_sparcV9Mode)
+            mode = cs_mode(mode | CS_MODE_V9);
+
+        return mode;
+    }
+
+    void ViewDisassembler::resetRows() {
+        this->m_rowCache.clear();
+        this->m_rowLookup.clear();
+
+        if (this->m_formatInstruction != nullptr) {
+            cs_free(this->m_formatInstruction, 1);
+            this->m_formatInstruction = nullptr;
+        }
+
+        if (this->m_formatHandle != 0) {
+            cs_close(&this->m_formatHandle);
+            this->m_formatHandle = 0;
+        }
+    }
+
+    const Disassembly& ViewDisassembler::getRow(size_t index) {
+        if (auto iter = this->m_rowLookup.find(index); iter != this->m_rowLookup.end()) {
+            this->m_rowCache.splice(this->m_rowCache.begin(), this->m_rowCache, iter->second);
+            return this->m_rowCache.front().second;
+        }
+
+        if (this->m_rowCache.size() >= RowCacheSize) {
+            this->m_rowLookup.erase(this->m_rowCache.back().first);
+            this->m_rowCache.pop_back();
+        }
 
-        std::thread([this] {
-            csh capstoneHandle;
-            cs_insn *instructions = nullptr;
+        const auto [offset, size] = this->m_disassemblyIndex.getInstruction(index);
 
-            cs_mode mode = cs_mode(this->m_modeBasicARM | this->m_modeExtraARM | this->m_modeBasicMIPS | this->m_modeBasicX86 | this->m_modeBasicPPC);
+        Disassembly row = { };
+        row.address = this->m_indexBaseAddress + offset;
+        row.offset  = this->m_indexRegionStart + offset;
+        row.size    = size;
 
-            if (this->m_littleEndianMode)
-                mode = cs_mode(mode | CS_MODE_LITTLE_ENDIAN);
-            else
-                mode = cs_mode(mode | CS_MODE_BIG_ENDIAN);
+        std::vector<u8> bytes(size);
+        ImHexApi::Provider::get()->read(row.offset, bytes.data(), bytes.size());
 
-            if (this->m_micoMode)
-                mode = cs_mode(mode | CS_MODE_MICRO);
+        for (u8 byte : bytes)
+            row.bytes += hex::format("{0:02X} ", byte);
+        if (!row.bytes.empty())
+            row.bytes.pop_back();
 
-            if (this->m_sparcV9Mode)
-                mode = cs_mode(mode | CS_MODE_V9);
+        if (this->m_formatHandle == 0 && cs_open(this->m_indexArchitecture, this->m_indexMode, &this->m_formatHandle) == CS_ERR_OK) {
+            cs_option(this->m_formatHandle, CS_OPT_SKIPDATA, CS_OPT_ON);
+            this->m_formatInstruction = cs_malloc(this->m_formatHandle);
+        }
 
-            if (cs_open(Disassembler::toCapstoneArchictecture(this->m_architecture), mode, &capstoneHandle) == CS_ERR_OK) {
+        const u8 *code = bytes.data();
+        size_t codeSize = bytes.size();
+        u64 address = row.address;
+        if (this->m_formatInstruction != nullptr && cs_disasm_iter(this->m_formatHandle, &code, &codeSize, &address, this->m_formatInstruction)) {
+            row.mnemonic  = this->m_formatInstruction->mnemonic;
+            row.operators = this->m_formatInstruction->op_str;
+        } else {
+            row.mnemonic = ".byte";
+        }
 
-                cs_option(capstoneHandle, CS_OPT_SKIPDATA, CS_OPT_ON);
+        this->m_rowCache.emplace_front(index, std::move(row));
+        this->m_rowLookup[index] = this->m_rowCache.begin();
 
-                auto provider = ImHexApi::Provider::get();
-                std::vector<u8> buffer(2048, 0x00);
-                size_t size = (this->m_codeRegion[1] - this->m_codeRegion[0] + 1);
+        return this->m_rowCache.front().second;
+    }
 
-                auto task = ImHexApi::Tasks::createTask("hex.builtin.view.disassembler.disassembling", size);
-                for (u64 address = 0; address < size; address += 2048) {
-                    task.update(address);
+    void ViewDisassembler::stopDisassembling() {
+        // Replacing the thread stops and joins the previous one
+        this->m_disassemblerThread = std::jthread();
 
-                    size_t bufferSize = std::min(u64(2048), (this->m_codeRegion[1] - this->m_codeRegion[0] + 1) - address);
-                    provider->read(this->m_codeRegion[0] + address, buffer.data(), bufferSize);
+        std::scoped_lock lock(this->m_pendingIndexMutex);
+        this->m_pendingIndex.reset();
+    }
 
-                    size_t instructionCount = cs_disasm(capstoneHandle, buffer.data(), bufferSize, this->m_baseAddress + address, 0, &instructions);
+    void ViewDisassembler::disassemble() {
+        this->stopDisassembling();
+        this->m_disassemblyIndex = { };
+        this->resetRows();
+        this->m_disassembling = true;
 
-                    if (instructionCount == 0)
-                        break;
+        this->m_indexArchitecture = Disassembler::toCapstoneArchictecture(this->m_architecture);
+        this->m_indexMode         = this->getMode();
+        this->m_indexRegionStart  = this->m_codeRegion[0];
+        this->m_indexBaseAddress  = this->m_baseAddress;
 
-                    u64 usedBytes = 0;
-                    for (u32 instr = 0; instr < instructionCount; instr++) {
-                        Disassembly disassembly = { 0 };
-                        disassembly.address = instructions[instr].address;
-                        disassembly.offset = this->m_codeRegion[0] + address + usedBytes;
-                        disassembly.size = instructions[instr].size;
-                        disassembly.mnemonic = instructions[instr].mnemonic;
-                        disassembly.operators = instructions[instr].op_str;
+        this->m_disassemblerThread = std::jthread([this, architecture = this->m_indexArchitecture, mode = this->m_indexMode, regionStart = this->m_codeRegion[0], regionEnd = this->m_codeRegion[1], baseAddress = this->m_baseAddress](const std::stop_token &stopToken) {
+            ON_SCOPE_EXIT { this->m_disassembling = false; };
 
-                        for (u16 i = 0; i < instructions[instr].size; i++)
-                            disassembly.bytes += hex::format("{0:02X} ", instructions[instr].bytes[i]);
-                        disassembly.bytes.pop_back();
+            if (!ImHexApi::Provider::isValid() || regionEnd < regionStart)
+                return;
 
-                        this->m_disassembly.push_back(disassembly);
+            // Capstone handles can't be shared between threads, every worker gets its own
+            auto decoderFactory = [architecture, mode]() -> DisassemblyIndex::DecodeFunction {
+                struct Decoder {
+                    csh handle = 0;
+                    cs_insn *instruction = nullptr;
 
-                        usedBytes += instructions[instr].size;
+                    ~Decoder() {
+                        if (this->instruction != nullptr)
+                            cs_free(this->instruction, 1);
+                        if (this->handle != 0)
+                            cs_close(&this->handle);
                     }
+                };
 
-                    if (instructionCount < bufferSize)
-                        address -= (bufferSize - usedBytes);
+                auto decoder = std::make_shared<Decoder>();
+                if (cs_open(architecture, mode, &decoder->handle) != CS_ERR_OK)
+                    return [](u64, std::span<const u8>) -> size_t { return 0; };
 
-                    cs_free(instructions, instructionCount);
-                }
+                cs_option(decoder->handle, CS_OPT_SKIPDATA, CS_OPT_ON);
+                decoder->instruction = cs_malloc(decoder->handle);
 
-                cs_close(&capstoneHandle);
-            }
+                return [decoder](u64 address, std::span<const u8> code) -> size_t {
+                    const u8 *data = code.data();
+                    size_t size = code.size();
 
-            this->m_disassembling = false;
-        }).detach();
+                    if (!cs_disasm_iter(decoder->handle, &data, &size, &address, decoder->instruction))
+                        return 0;
 
+                    return decoder->instruction->size;
+                };
+            };
+
+            auto provider = ImHexApi::Provider::get();
+            const size_t size = regionEnd - regionStart + 1;
+
+            auto task = ImHexApi::Tasks::createTask("hex.builtin.view.disassembler.disassembling", size);
+            auto index = DisassemblyIndex::build(provider, regionStart, size, baseAddress, decoderFactory, [&task](u64 processedSize) {
+                task.update(processedSize);
+            }, 0, stopToken);
+
+            if (stopToken.stop_requested())
+                return;
+
+            std::scoped_lock lock(this->m_pendingIndexMutex);
+            this->m_pendingIndex = std::move(index);
+        });
     }
 
     void ViewDisassembler::drawContent() {
+        {
+            std::scoped_lock lock(this->m_pendingIndexMutex);
+            if (this->m_pendingIndex.has_value()) {
+                this->m_disassemblyIndex = std::move(this->m_pendingIndex.value());
+                this->m_pendingIndex.reset();
+                this->resetRows();
+            }
+        }
 
         if (ImGui::Begin(View::toWindowName("hex.builtin.view.disassembler.name").c_str(), &this->getWindowOpenState(), ImGuiWindowFlags_NoCollapse)) {
 
@@ -283,12 +376,12 @@ namespace hex::plugin::builtin {
 
                     if (!this->m_disassembling) {
                         ImGuiListClipper clipper;
-                        clipper.Begin(this->m_disassembly.size());
+                        clipper.Begin(this->m_disassemblyIndex.size());
 
                         ImGui::TableHeadersRow();
                         while (clipper.Step()) {
                             for (u64 i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
-                                const auto &instruction = this->m_disassembly[i];
+                                const auto &instruction = this->getRow(i);
                                 ImGui::TableNextRow();
                                 ImGui::TableNextColumn();
                                 if (ImGui::Selectable(("##DisassemblyLine"s + std::to_string(i)).c_str(), false, ImGuiSelectableFlags_SpanAllColumns)) {
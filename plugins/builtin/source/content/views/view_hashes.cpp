@@ -2,6 +2,7 @@
 
 #include <hex/providers/provider.hpp>
 #include <hex/helpers/crypto.hpp>
+#include <hex/helpers/utils.hpp>
 
 #include <vector>
 
@@ -31,11 +32,79 @@ namespace hex::plugin::builtin {
         EventManager::unsubscribe<EventRegionSelected>(this);
     }
 
+    void ViewHashes::startHashing() {
+        std::vector<crypt::HashRequest> requests;
+        std::vector<std::string> names;
+        for (size_t i = 0; i < hashFunctionNames.size(); i++) {
+            if (!this->m_enabledHashFunctions[i])
+                continue;
+
+            const auto &[function, name] = hashFunctionNames[i];
+
+            crypt::HashRequest request = { function };
+            switch (function) {
+                case crypt::HashFunction::CRC8:  request.crc = this->m_crc8;  break;
+                case crypt::HashFunction::CRC16: request.crc = this->m_crc16; break;
+                case crypt::HashFunction::CRC32: request.crc = this->m_crc32; break;
+                default: break;
+            }
+
+            requests.push_back(request);
+            names.emplace_back(name);
+        }
+
+        // Replacing the thread stops a calculation that's still running for outdated settings. It has to be gone before the new one starts so it can't reset the state of that one
+        this->m_hashThread = std::jthread();
+        this->m_calculating = true;
+
+        this->m_hashThread = std::jthread([this, requests = std::move(requests), names = std::move(names), offset = this->m_hashRegion[0], size = this->m_hashRegion[1]](const std::stop_token &stopToken) {
+            ON_SCOPE_EXIT { this->m_calculating = false; };
+
+            auto provider = ImHexApi::Provider::get();
+
+            auto task = ImHexApi::Tasks::createTask("hex.builtin.view.hashes.calculating", size);
+
+            auto digests = crypt::hash(provider, offset, size, requests, [&task](u64 processedSize) {
+                task.update(processedSize);
+            }, stopToken);
+
+            if (!digests.has_value())
+                return;
+
+            std::vector<std::pair<std::string, std::string>> results;
+            for (size_t i = 0; i < digests->size(); i++)
+                results.emplace_back(names[i], crypt::encode16((*digests)[i]));
+
+            {
+                std::scoped_lock lock(this->m_resultsMutex);
+                this->m_results = std::move(results);
+            }
+        });
+    }
+
+    bool ViewHashes::drawCrcSettings(crypt::CrcParameters &parameters) {
+        bool edited = false;
+
+        ImGui::Indent();
+
+        ImGui::InputScalar("hex.builtin.view.hashes.iv"_lang, ImGuiDataType_U32, &parameters.init, nullptr, nullptr, "%X", ImGuiInputTextFlags_CharsHexadecimal);
+        edited = ImGui::IsItemEdited() || edited;
+
+        ImGui::InputScalar("hex.builtin.view.hashes.xorout"_lang, ImGuiDataType_U32, &parameters.xorout, nullptr, nullptr, "%X", ImGuiInputTextFlags_CharsHexadecimal);
+        edited = ImGui::IsItemEdited() || edited;
+
+        ImGui::Checkbox("hex.common.reflectIn"_lang, &parameters.reflectIn);
+        edited = ImGui::IsItemEdited() || edited;
+
+        ImGui::Checkbox("hex.common.reflectOut"_lang, &parameters.reflectOut);
+        edited = ImGui::IsItemEdited() || edited;
+
+        ImGui::InputScalar("hex.builtin.view.hashes.poly"_lang, ImGuiDataType_U32, &parameters.polynomial, nullptr, nullptr, "%X", ImGuiInputTextFlags_CharsHexadecimal);
+        edited = ImGui::IsItemEdited() || edited;
+
+        ImGui::Unindent();
 
-    template<size_t Size>
-    static void formatBigHexInt(std::array<u8, Size> dataArray, char *buffer, size_t bufferSize) {
-        for (int i = 0; i < dataArray.size(); i++)
-            snprintf(buffer + 2 * i, bufferSize - 2 * i, "%02X", dataArray[i]);
+        return edited;
     }
 
     void ViewHashes::drawContent() {
@@ -63,237 +132,52 @@ namespace hex::plugin::builtin {
                     ImGui::TextUnformatted("hex.builtin.view.hashes.settings"_lang);
                     ImGui::Separator();
 
-                    if (ImGui::BeginCombo("hex.builtin.view.hashes.function"_lang, hashFunctionNames[this->m_currHashFunction].second, 0))
-                    {
-                        for (int i = 0; i < hashFunctionNames.size(); i++)
-                        {
-                            bool is_selected = (this->m_currHashFunction == i);
-                            if (ImGui::Selectable(hashFunctionNames[i].second, is_selected))
-                                this->m_currHashFunction = i;
-                            if (is_selected)
-                                ImGui::SetItemDefaultFocus();   // Set the initial focus when opening the combo (scrolling + for keyboard navigation support in the upcoming navigation branch)
-                        }
-                        ImGui::EndCombo();
-                        this->m_shouldInvalidate = true;
-                    }
-
-                    size_t dataSize = provider->getSize();
-                    if (this->m_hashRegion[1] >= provider->getBaseAddress() + dataSize)
-                        this->m_hashRegion[1] = provider->getBaseAddress() + dataSize;
-
-
-                    switch (hashFunctionNames[this->m_currHashFunction].first) {
-                        case HashFunctions::Crc8:
-                        {
-                            static int polynomial = 0x07, init = 0x0000, xorout = 0x0000;
-                            static bool reflectIn = false, reflectOut = false;
-
-                            ImGui::InputInt("hex.builtin.view.hashes.iv"_lang, &init, 0, 0, ImGuiInputTextFlags_CharsHexadecimal);
-                            if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
-
-                            ImGui::InputInt("hex.builtin.view.hashes.xorout"_lang, &xorout, 0, 0, ImGuiInputTextFlags_CharsHexadecimal);
-                            if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
-
-                            ImGui::Checkbox("hex.common.reflectIn"_lang, &reflectIn);
-                            if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
-
-                            ImGui::Checkbox("hex.common.reflectOut"_lang, &reflectOut);
-                            if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
-
-                            ImGui::InputInt("hex.builtin.view.hashes.poly"_lang, &polynomial, 0, 0, ImGuiInputTextFlags_CharsHexadecimal);
-                            if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
-
-                            ImGui::NewLine();
-
-                            static u8 result = 0;
-
-                            if (this->m_shouldInvalidate)
-                                result = crypt::crc8(provider, this->m_hashRegion[0], this->m_hashRegion[1],
-                                                      polynomial, init, xorout, reflectIn, reflectOut);
-
-                            char buffer[sizeof(result) * 2 + 1];
-                            snprintf(buffer, sizeof(buffer), "%02X", result);
-
-                            ImGui::TextUnformatted("hex.builtin.view.hashes.result"_lang);
-                            ImGui::Separator();
-                            ImGui::InputText("##nolabel", buffer, ImGuiInputTextFlags_ReadOnly);
-                        }
-                            break;
-                        case HashFunctions::Crc16:
-                        {
-                            static int polynomial = 0x8005, init = 0x0000, xorout = 0x0000;
-                            static bool reflectIn = false, reflectOut = false;
-
-                            ImGui::InputInt("hex.builtin.view.hashes.iv"_lang, &init, 0, 0, ImGuiInputTextFlags_CharsHexadecimal);
-                            if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
-
-                            ImGui::InputInt("hex.builtin.view.hashes.xorout"_lang, &xorout, 0, 0, ImGuiInputTextFlags_CharsHexadecimal);
-                            if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
+                    ImGui::TextUnformatted("hex.builtin.view.hashes.function"_lang);
+                    for (size_t i = 0; i < hashFunctionNames.size(); i++) {
+                        const auto &[function, name] = hashFunctionNames[i];
 
-                            ImGui::Checkbox("hex.common.reflectIn"_lang, &reflectIn);
-                            if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
+                        ImGui::PushID(i);
 
-                            ImGui::Checkbox("hex.common.reflectOut"_lang, &reflectOut);
-                            if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
+                        ImGui::Checkbox(name, &this->m_enabledHashFunctions[i]);
+                        if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
 
-                            ImGui::InputInt("hex.builtin.view.hashes.poly"_lang, &polynomial, 0, 0, ImGuiInputTextFlags_CharsHexadecimal);
-                            if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
+                        if (this->m_enabledHashFunctions[i]) {
+                            bool edited = false;
+                            switch (function) {
+                                case crypt::HashFunction::CRC8:  edited = this->drawCrcSettings(this->m_crc8);  break;
+                                case crypt::HashFunction::CRC16: edited = this->drawCrcSettings(this->m_crc16); break;
+                                case crypt::HashFunction::CRC32: edited = this->drawCrcSettings(this->m_crc32); break;
+                                default: break;
+                            }
 
-                            ImGui::NewLine();
-
-                            static u16 result = 0;
-
-                            if (this->m_shouldInvalidate)
-                                result = crypt::crc16(provider, this->m_hashRegion[0], this->m_hashRegion[1],
-                                                      polynomial, init, xorout, reflectIn, reflectOut);
-
-                            char buffer[sizeof(result) * 2 + 1];
-                            snprintf(buffer, sizeof(buffer), "%04X", result);
-
-                            ImGui::TextUnformatted("hex.builtin.view.hashes.result"_lang);
-                            ImGui::Separator();
-                            ImGui::InputText("##nolabel", buffer, ImGuiInputTextFlags_ReadOnly);
-                        }
-                            break;
-                        case HashFunctions::Crc32:
-                        {
-                            static int polynomial = 0x04C11DB7, init = 0xFFFFFFFF, xorout = 0xFFFFFFFF;
-                            static bool reflectIn = true, reflectOut = true;
-
-
-
-                            ImGui::InputInt("hex.builtin.view.hashes.iv"_lang, &init, 0, 0, ImGuiInputTextFlags_CharsHexadecimal);
-                            if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
-
-                            ImGui::InputInt("hex.builtin.view.hashes.xorout"_lang, &xorout, 0, 0, ImGuiInputTextFlags_CharsHexadecimal);
-                            if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
-
-                            ImGui::Checkbox("hex.common.reflectIn"_lang, &reflectIn);
-                            if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
-
-                            ImGui::Checkbox("hex.common.reflectOut"_lang, &reflectOut);
-                            if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
-
-                            ImGui::InputInt("hex.builtin.view.hashes.poly"_lang, &polynomial, 0, 0, ImGuiInputTextFlags_CharsHexadecimal);
-                            if (ImGui::IsItemEdited()) this->m_shouldInvalidate = true;
-
-                            ImGui::NewLine();
-
-                            static u32 result = 0;
-
-                            if (this->m_shouldInvalidate)
-                                result = crypt::crc32(provider, this->m_hashRegion[0], this->m_hashRegion[1],
-                                                      polynomial, init, xorout, reflectIn, reflectOut);
-
-                            char buffer[sizeof(result) * 2 + 1];
-                            snprintf(buffer, sizeof(buffer), "%08X", result);
-
-                            ImGui::TextUnformatted("hex.builtin.view.hashes.result"_lang);
-                            ImGui::Separator();
-                            ImGui::InputText("##nolabel", buffer, ImGuiInputTextFlags_ReadOnly);
-                        }
-                            break;
-                        case HashFunctions::Md5:
-                        {
-                            static std::array<u8, 16> result = { 0 };
-
-                            if (this->m_shouldInvalidate)
-                                result = crypt::md5(provider, this->m_hashRegion[0], this->m_hashRegion[1]);
-
-                            char buffer[sizeof(result) * 2 + 1];
-                            formatBigHexInt(result, buffer, sizeof(buffer));
-
-                            ImGui::NewLine();
-                            ImGui::TextUnformatted("hex.builtin.view.hashes.result"_lang);
-                            ImGui::Separator();
-                            ImGui::InputText("##nolabel", buffer, ImGuiInputTextFlags_ReadOnly);
-                        }
-                            break;
-                        case HashFunctions::Sha1:
-                        {
-                            static std::array<u8, 20> result = { 0 };
-
-                            if (this->m_shouldInvalidate)
-                                result = crypt::sha1(provider, this->m_hashRegion[0], this->m_hashRegion[1]);
-
-                            char buffer[sizeof(result) * 2 + 1];
-                            formatBigHexInt(result, buffer, sizeof(buffer));
-
-                            ImGui::NewLine();
-                            ImGui::TextUnformatted("hex.builtin.view.hashes.result"_lang);
-                            ImGui::Separator();
-                            ImGui::InputText("##nolabel", buffer, ImGuiInputTextFlags_ReadOnly);
-                        }
-                            break;
-                        case HashFunctions::Sha224:
-                        {
-                            static std::array<u8, 28> result = { 0 };
-
-                            if (this->m_shouldInvalidate)
-                                result = crypt::sha224(provider, this->m_hashRegion[0], this->m_hashRegion[1]);
-
-                            char buffer[sizeof(result) * 2 + 1];
-                            formatBigHexInt(result, buffer, sizeof(buffer));
-
-                            ImGui::NewLine();
-                            ImGui::TextUnformatted("hex.builtin.view.hashes.result"_lang);
-                            ImGui::Separator();
-                            ImGui::InputText("##nolabel", buffer, ImGuiInputTextFlags_ReadOnly);
-                        }
-                            break;
-                        case HashFunctions::Sha256:
-                        {
-                            static std::array<u8, 32> result;
-
-                            if (this->m_shouldInvalidate)
-                                result = crypt::sha256(provider, this->m_hashRegion[0], this->m_hashRegion[1]);
-
-                            char buffer[sizeof(result) * 2 + 1];
-                            formatBigHexInt(result, buffer, sizeof(buffer));
-
-                            ImGui::NewLine();
-                            ImGui::TextUnformatted("hex.builtin.view.hashes.result"_lang);
-                            ImGui::Separator();
-                            ImGui::InputText("##nolabel", buffer, ImGuiInputTextFlags_ReadOnly);
+                            if (edited) this->m_shouldInvalidate = true;
                         }
-                            break;
-                        case HashFunctions::Sha384:
-                        {
-                            static std::array<u8, 48> result;
 
-                            if (this->m_shouldInvalidate)
-                                result = crypt::sha384(provider, this->m_hashRegion[0], this->m_hashRegion[1]);
+                        ImGui::PopID();
+                    }
 
-                            char buffer[sizeof(result) * 2 + 1];
-                            formatBigHexInt(result, buffer, sizeof(buffer));
+                    size_t dataSize = provider->getSize();
+                    if (this->m_hashRegion[1] >= provider->getBaseAddress() + dataSize)
+                        this->m_hashRegion[1] = provider->getBaseAddress() + dataSize;
 
-                            ImGui::NewLine();
-                            ImGui::TextUnformatted("hex.builtin.view.hashes.result"_lang);
-                            ImGui::Separator();
-                            ImGui::InputText("##nolabel", buffer, ImGuiInputTextFlags_ReadOnly);
-                        }
-                            break;
-                        case HashFunctions::Sha512:
-                        {
-                            static std::array<u8, 64> result;
+                    if (this->m_shouldInvalidate) {
+                        this->startHashing();
+                        this->m_shouldInvalidate = false;
+                    }
 
-                            if (this->m_shouldInvalidate)
-                                result = crypt::sha512(provider, this->m_hashRegion[0], this->m_hashRegion[1]);
+                    ImGui::NewLine();
+                    ImGui::TextUnformatted("hex.builtin.view.hashes.result"_lang);
+                    ImGui::Separator();
 
-                            char buffer[sizeof(result) * 2 + 1];
-                            formatBigHexInt(result, buffer, sizeof(buffer));
+                    if (this->m_calculating) {
+                        ImGui::TextSpinner("hex.builtin.view.hashes.calculating"_lang);
+                    } else {
+                        std::scoped_lock lock(this->m_resultsMutex);
 
-                            ImGui::NewLine();
-                            ImGui::TextUnformatted("hex.builtin.view.hashes.result"_lang);
-                            ImGui::Separator();
-                            ImGui::InputText("##nolabel", buffer, ImGuiInputTextFlags_ReadOnly);
-                        }
-                            break;
+                        for (auto &[name, digest] : this->m_results)
+                            ImGui::InputText(name.c_str(), digest.data(), digest.size() + 1, ImGuiInputTextFlags_ReadOnly);
                     }
-
                 }
-
-                this->m_shouldInvalidate = false;
             }
             ImGui::EndChild();
         }
@@ -76,24 +76,24 @@ namespace hex::plugin::builtin {
                     prevColor = (color & 0x00FFFFFF) | alpha;
             }
 
-            {
-                for (const auto &pattern : SharedData::patternData) {
-                    auto child = pattern->getPattern(off);
-                    if (child != nullptr) {
-                        auto color = (child->getColor() & 0x00FFFFFF) | alpha;
-                        currColor = currColor.has_value() ? ImAlphaBlendColors(color, currColor.value()) : color;
-                        break;
-                    }
-                }
+            if (auto patternColor = _this->m_patternIndex.getColor(off); patternColor.has_value()) {
+                auto color = (patternColor.value() & 0x00FFFFFF) | alpha;
+                currColor = currColor.has_value() ? ImAlphaBlendColors(color, currColor.value()) : color;
+            }
 
-                for (const auto &pattern : SharedData::patternData) {
-                    auto child = pattern->getPattern(off - 1);
-                    if (child != nullptr) {
-                        auto color = (child->getColor() & 0x00FFFFFF) | alpha;
-                        prevColor = prevColor.has_value() ? ImAlphaBlendColors(color, currColor.value()) : color;
-                        break;
-                    }
-                }
+            if (auto patternColor = _this->m_patternIndex.getColor(off - 1); patternColor.has_value()) {
+                auto color = (patternColor.value() & 0x00FFFFFF) | alpha;
+                prevColor = prevColor.has_value() ? ImAlphaBlendColors(color, prevColor.value()) : color;
+            }
+
+            if (auto highlightColor = _this->m_highlightIndex.getColor(off); highlightColor.has_value()) {
+                auto color = (highlightColor.value() & 0x00FFFFFF) | alpha;
+                currColor = currColor.has_value() ? ImAlphaBlendColors(color, currColor.value()) : color;
+            }
+
+            if (auto highlightColor = _this->m_highlightIndex.getColor(off - 1); highlightColor.has_value()) {
+                auto color = (highlightColor.value() & 0x00FFFFFF) | alpha;
+                prevColor = prevColor.has_value() ? ImAlphaBlendColors(color, prevColor.value()) : color;
             }
 
             if (next && prevColor != currColor) {
@@ -139,10 +139,10 @@ namespace hex::plugin::builtin {
             auto provider = ImHexApi::Provider::get();
             size_t size = std::min<size_t>(_this->m_currEncodingFile.getLongestSequence(), provider->getActualSize() - addr);
 
-            std::vector<u8> buffer(size);
+            std::array<u8, EncodingFile::MaxSequenceLength> buffer;
             provider->read(addr + provider->getBaseAddress() + provider->getCurrentPageAddress(), buffer.data(), size);
 
-            auto [decoded, advance] = _this->m_currEncodingFile.getEncodingFor(buffer);
+            auto [decoded, advance] = _this->m_currEncodingFile.getEncodingFor({ buffer.data(), size });
 
             ImColor color;
             if (decoded.length() == 1 && std::isalnum(decoded[0])) color = 0xFFFF8000;
@@ -165,11 +165,25 @@ namespace hex::plugin::builtin {
         EventManager::unsubscribe<EventWindowClosing>(this);
         EventManager::unsubscribe<RequestOpenWindow>(this);
         EventManager::unsubscribe<EventSettingsChanged>(this);
+        EventManager::unsubscribe<EventPatternChanged>(this);
+        EventManager::unsubscribe<RequestHighlightRegions>(this);
     }
 
     void ViewHexEditor::drawContent() {
         auto provider = ImHexApi::Provider::get();
 
+        {
+            std::scoped_lock lock(this->m_patternIndexMutex);
+            if (this->m_pendingPatternIndex.has_value()) {
+                this->m_patternIndex = std::move(this->m_pendingPatternIndex.value());
+                this->m_pendingPatternIndex.reset();
+            }
+            if (this->m_pendingHighlightIndex.has_value()) {
+                this->m_highlightIndex = std::move(this->m_pendingHighlightIndex.value());
+                this->m_pendingHighlightIndex.reset();
+            }
+        }
+
         size_t dataSize = (!ImHexApi::Provider::isValid() || !provider->isReadable()) ? 0x00 : provider->getSize();
 
         this->m_memoryEditor.DrawWindow(View::toWindowName("hex.builtin.view.hexeditor.name").c_str(), &this->getWindowOpenState(), this, dataSize, dataSize == 0 ? 0x00 : provider->getBaseAddress() + provider->getCurrentPageAddress());
@@ -491,9 +505,9 @@ namespace hex::plugin::builtin {
                            auto provider = ImHexApi::Provider::get();
 
                            u64 progress = 0;
-                           for (auto &[address, value] : patch) {
-                               provider->addPatch(address, &value, 1);
-                               progress++;
+                           for (auto &[address, data] : patch) {
+                               provider->addPatch(address, data.data(), data.size());
+                               progress += data.size();
                                task.update(progress);
                            }
 
@@ -521,9 +535,9 @@ namespace hex::plugin::builtin {
                             auto provider = ImHexApi::Provider::get();
 
                             u64 progress = 0;
-                            for (auto &[address, value] : patch) {
-                                provider->addPatch(address, &value, 1);
-                                progress++;
+                            for (auto &[address, data] : patch) {
+                                provider->addPatch(address, data.data(), data.size());
+                                progress += data.size();
                                 task.update(progress);
                             }
 
@@ -550,7 +564,7 @@ namespace hex::plugin::builtin {
                     if (!patches.contains(0x00454F45) && patches.contains(0x00454F46)) {
                         u8 value = 0;
                         provider->read(0x00454F45, &value, sizeof(u8));
-                        patches[0x00454F45] = value;
+                        patches.add(0x00454F45, value);
                     }
 
                     this->m_processingImportExport = true;
@@ -575,10 +589,10 @@ namespace hex::plugin::builtin {
                 }
                 if (ImGui::MenuItem("hex.builtin.view.hexeditor.menu.file.export.ips32"_lang, nullptr, false, !this->m_processingImportExport)) {
                     Patches patches = provider->getPatches();
-                    if (!patches.contains(0x00454F45) && patches.contains(0x45454F46)) {
+                    if (!patches.contains(0x45454F45) && patches.contains(0x45454F46)) {
                         u8 value = 0;
                         provider->read(0x45454F45, &value, sizeof(u8));
-                        patches[0x45454F45] = value;
+                        patches.add(0x45454F45, value);
                     }
 
                     this->m_processingImportExport = true;
@@ -745,140 +759,114 @@ namespace hex::plugin::builtin {
         ImGui::SetClipboardText(buffer.c_str());
     }
 
-    static std::vector<std::pair<u64, u64>> findString(hex::prv::Provider* &provider, std::string string) {
-        std::vector<std::pair<u64, u64>> results;
-
-        u32 foundCharacters = 0;
-
-        std::vector<u8> buffer(1024, 0x00);
-        size_t dataSize = provider->getSize();
-        for (u64 offset = 0; offset < dataSize; offset += 1024) {
-            size_t usedBufferSize = std::min(u64(buffer.size()), dataSize - offset);
-            provider->read(offset + provider->getBaseAddress() + provider->getCurrentPageAddress(), buffer.data(), usedBufferSize);
-
-            for (u64 i = 0; i < usedBufferSize; i++) {
-                if (buffer[i] == string[foundCharacters])
-                    foundCharacters++;
-                else
-                    foundCharacters = 0;
+    void ViewHexEditor::startSearch(const std::optional<SearchPattern> &pattern) {
+        // Replacing the thread stops a search that's still running and waits for it to finish
+        this->m_searchThread = std::jthread();
 
-                if (foundCharacters == string.size()) {
-                    results.emplace_back(offset + i - foundCharacters + 1, offset + i);
-                    foundCharacters = 0;
-                }
-            }
+        {
+            std::scoped_lock lock(this->m_searchMutex);
+            this->m_lastSearchBuffer->clear();
+            this->m_lastSearchIndex = 0;
         }
 
-        return results;
-    }
-
-    static std::vector<std::pair<u64, u64>> findHex(hex::prv::Provider* &provider, std::string string) {
-        std::vector<std::pair<u64, u64>> results;
+        if (!pattern.has_value() || !ImHexApi::Provider::isValid())
+            return;
 
-        if ((string.size() % 2) == 1)
-            string = "0" + string;
+        this->m_searching = true;
+        this->m_searchJumpPending = true;
 
-        std::vector<u8> hex;
-        hex.reserve(string.size() / 2);
+        this->m_searchThread = std::jthread([this, pattern = *pattern, results = this->m_lastSearchBuffer](const std::stop_token &stopToken) {
+            auto provider = ImHexApi::Provider::get();
+            auto task = ImHexApi::Tasks::createTask("hex.builtin.view.hexeditor.search.searching", provider->getActualSize());
+
+            pattern.search(provider, provider->getBaseAddress(), provider->getActualSize(), [&](u64 address) {
+                std::scoped_lock lock(this->m_searchMutex);
+                results->emplace_back(address, address + pattern.size() - 1);
+            }, [&](u64 searchedSize) {
+                task.update(searchedSize);
+                return !stopToken.stop_requested();
+            });
 
-        for (u32 i = 0; i < string.size(); i += 2) {
-            char byte[3] = { string[i], string[i + 1], 0 };
-            hex.push_back(strtoul(byte, nullptr, 16));
-        }
+            this->m_searching = false;
+        });
+    }
 
-        u32 foundCharacters = 0;
+    void ViewHexEditor::gotoSearchResult(s64 index) {
+        std::scoped_lock lock(this->m_searchMutex);
 
-        std::vector<u8> buffer(1024, 0x00);
-        size_t dataSize = provider->getSize();
-        for (u64 offset = 0; offset < dataSize; offset += 1024) {
-            size_t usedBufferSize = std::min(u64(buffer.size()), dataSize - offset);
-            provider->read(offset + provider->getBaseAddress() + provider->getCurrentPageAddress(), buffer.data(), usedBufferSize);
+        auto &results = *this->m_lastSearchBuffer;
+        if (results.empty())
+            return;
 
-            for (u64 i = 0; i < usedBufferSize; i++) {
-                if (buffer[i] == hex[foundCharacters])
-                    foundCharacters++;
-                else
-                    foundCharacters = 0;
+        if (index < 0)
+            index = results.size() - 1;
 
-                if (foundCharacters == hex.size()) {
-                    results.emplace_back(offset + i - foundCharacters + 1, offset + i);
-                    foundCharacters = 0;
-                }
-            }
-        }
+        this->m_lastSearchIndex = index % results.size();
 
-        return results;
+        // Results can be on any page, the selection request switches to the right one
+        const auto &[start, end] = results[this->m_lastSearchIndex];
+        EventManager::post<RequestSelectionChange>(Region { start, (end - start) + 1 });
     }
 
-
     void ViewHexEditor::drawSearchPopup() {
-        static auto InputCallback = [](ImGuiInputTextCallbackData* data) -> int {
-            auto _this = static_cast<ViewHexEditor*>(data->UserData);
-            auto provider = ImHexApi::Provider::get();
-
-            *_this->m_lastSearchBuffer = _this->m_searchFunction(provider, data->Buf);
-            _this->m_lastSearchIndex = 0;
-
-            if (!_this->m_lastSearchBuffer->empty())
-                _this->m_memoryEditor.GotoAddrAndSelect((*_this->m_lastSearchBuffer)[0].first, (*_this->m_lastSearchBuffer)[0].second);
-
-            return 0;
-        };
-
         static auto Find = [this](char *buffer) {
-            auto provider = ImHexApi::Provider::get();
+            if (this->m_lastSearchBuffer == &this->m_lastStringSearch)
+                this->startSearch(this->m_searchEncoding == SearchPattern::Encoding::Custom ? SearchPattern::fromString(buffer, this->m_currEncodingFile) : SearchPattern::fromString(buffer, this->m_searchCaseSensitive, this->m_searchEncoding));
+            else
+                this->startSearch(SearchPattern::fromHexString(buffer));
+        };
 
-            *this->m_lastSearchBuffer = this->m_searchFunction(provider, buffer);
-            this->m_lastSearchIndex = 0;
+        static auto InputCallback = [](ImGuiInputTextCallbackData* data) -> int {
+            Find(data->Buf);
 
-            if (!this->m_lastSearchBuffer->empty())
-                this->m_memoryEditor.GotoAddrAndSelect((*this->m_lastSearchBuffer)[0].first, (*this->m_lastSearchBuffer)[0].second);
+            return 0;
         };
 
-        static auto FindNext = [this]() {
-            if (!this->m_lastSearchBuffer->empty()) {
-                ++this->m_lastSearchIndex %= this->m_lastSearchBuffer->size();
-                this->m_memoryEditor.GotoAddrAndSelect((*this->m_lastSearchBuffer)[this->m_lastSearchIndex].first,
-                                                          (*this->m_lastSearchBuffer)[this->m_lastSearchIndex].second);
+        // Jump to the first result as soon as the background search found it
+        if (this->m_searchJumpPending && this->m_lastSearchBuffer != nullptr) {
+            bool hasResults;
+            {
+                std::scoped_lock lock(this->m_searchMutex);
+                hasResults = !this->m_lastSearchBuffer->empty();
             }
-        };
-
-        static auto FindPrevious = [this]() {
-            if (!this->m_lastSearchBuffer->empty()) {
-                this->m_lastSearchIndex--;
-
-                if (this->m_lastSearchIndex < 0)
-                    this->m_lastSearchIndex = this->m_lastSearchBuffer->size() - 1;
 
-                this->m_lastSearchIndex %= this->m_lastSearchBuffer->size();
-
-                this->m_memoryEditor.GotoAddrAndSelect((*this->m_lastSearchBuffer)[this->m_lastSearchIndex].first,
-                                                          (*this->m_lastSearchBuffer)[this->m_lastSearchIndex].second);
+            if (hasResults) {
+                this->gotoSearchResult(0);
+                this->m_searchJumpPending = false;
+            } else if (!this->m_searching) {
+                this->m_searchJumpPending = false;
             }
-        };
-
+        }
 
         ImGui::SetNextWindowPos(ImGui::GetWindowPos() + ImGui::GetWindowContentRegionMin() - ImGui::GetStyle().WindowPadding);
         if (ImGui::BeginPopup("hex.builtin.view.hexeditor.menu.file.search"_lang)) {
             if (ImGui::BeginTabBar("searchTabs")) {
                 std::vector<char> *currBuffer = nullptr;
                 if (ImGui::BeginTabItem("hex.builtin.view.hexeditor.search.string"_lang)) {
-                    this->m_searchFunction = findString;
                     this->m_lastSearchBuffer = &this->m_lastStringSearch;
                     currBuffer = &this->m_searchStringBuffer;
 
                     ImGui::InputText("##nolabel", currBuffer->data(), currBuffer->size(), ImGuiInputTextFlags_CallbackCompletion,
                                      InputCallback, this);
+
+                    ImGui::Checkbox("hex.builtin.view.hexeditor.search.case_sensitive"_lang, &this->m_searchCaseSensitive);
+
+                    // Strings can only be searched for in the custom encoding while an encoding file is loaded
+                    if (!this->m_currEncodingFile.valid() && this->m_searchEncoding == SearchPattern::Encoding::Custom)
+                        this->m_searchEncoding = SearchPattern::Encoding::ASCII;
+
+                    const char *encodings[] = { "ASCII", "UTF-16LE", "UTF-16BE", "hex.builtin.view.hexeditor.search.encoding.custom"_lang };
+                    int selectedEncoding = static_cast<int>(this->m_searchEncoding);
+                    if (ImGui::Combo("hex.builtin.view.hexeditor.search.encoding"_lang, &selectedEncoding, encodings, IM_ARRAYSIZE(encodings) - (this->m_currEncodingFile.valid() ? 0 : 1)))
+                        this->m_searchEncoding = static_cast<SearchPattern::Encoding>(selectedEncoding);
                     ImGui::EndTabItem();
                 }
 
                 if (ImGui::BeginTabItem("hex.builtin.view.hexeditor.search.hex"_lang)) {
-                    this->m_searchFunction = findHex;
                     this->m_lastSearchBuffer = &this->m_lastHexSearch;
                     currBuffer = &this->m_searchHexBuffer;
 
-                    ImGui::InputText("##nolabel", currBuffer->data(), currBuffer->size(),
-                                     ImGuiInputTextFlags_CharsHexadecimal | ImGuiInputTextFlags_CallbackCompletion,
+                    ImGui::InputText("##nolabel", currBuffer->data(), currBuffer->size(), ImGuiInputTextFlags_CallbackCompletion,
                                      InputCallback, this);
                     ImGui::EndTabItem();
                 }
@@ -887,15 +875,28 @@ namespace hex::plugin::builtin {
                     if (ImGui::Button("hex.builtin.view.hexeditor.search.find"_lang))
                         Find(currBuffer->data());
 
-                    if (!this->m_lastSearchBuffer->empty()) {
+                    size_t resultCount;
+                    {
+                        std::scoped_lock lock(this->m_searchMutex);
+                        resultCount = this->m_lastSearchBuffer->size();
+                    }
+
+                    if (resultCount > 0) {
                         if ((ImGui::Button("hex.builtin.view.hexeditor.search.find_next"_lang)))
-                            FindNext();
+                            this->gotoSearchResult(this->m_lastSearchIndex + 1);
 
                         ImGui::SameLine();
 
                         if ((ImGui::Button("hex.builtin.view.hexeditor.search.find_prev"_lang)))
-                            FindPrevious();
+                            this->gotoSearchResult(this->m_lastSearchIndex - 1);
                     }
+
+                    if (this->m_searching)
+                        ImGui::TextSpinner("hex.builtin.view.hexeditor.search.searching"_lang);
+                    else
+                        ImGui::NewLine();
+
+                    ImGui::TextFormatted("hex.builtin.view.hexeditor.search.results"_lang, resultCount);
                 }
 
                 ImGui::EndTabBar();
@@ -1162,6 +1163,20 @@ namespace hex::plugin::builtin {
             }
         });
 
+        EventManager::subscribe<EventPatternChanged>(this, [this](auto &patterns) {
+            pl::PatternIndex patternIndex(patterns);
+
+            std::scoped_lock lock(this->m_patternIndexMutex);
+            this->m_pendingPatternIndex = std::move(patternIndex);
+        });
+
+        EventManager::subscribe<RequestHighlightRegions>(this, [this](const auto &regions) {
+            pl::PatternIndex highlightIndex(regions);
+
+            std::scoped_lock lock(this->m_patternIndexMutex);
+            this->m_pendingHighlightIndex = std::move(highlightIndex);
+        });
+
         EventManager::subscribe<QuerySelection>(this, [this](auto &region) {
             u64 address = std::min(this->m_memoryEditor.DataPreviewAddr, this->m_memoryEditor.DataPreviewAddrEnd);
             size_t size = std::abs(s64(this->m_memoryEditor.DataPreviewAddrEnd) - s64(this->m_memoryEditor.DataPreviewAddr)) + 1;
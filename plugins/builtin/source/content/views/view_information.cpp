@@ -5,12 +5,12 @@
 #include <hex/helpers/fmt.hpp>
 #include <hex/helpers/literals.hpp>
 
-#include <cstring>
+#include <algorithm>
 #include <cmath>
 #include <filesystem>
 #include <numeric>
-#include <span>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include <hex/helpers/magic.hpp>
@@ -23,6 +23,13 @@ namespace hex::plugin::builtin {
 
     ViewInformation::ViewInformation() : View("hex.builtin.view.information.name") {
         EventManager::subscribe<EventDataChanged>(this, [this]() {
+            // Changed patches or overlays only require the blocks containing them to be recalculated
+            if (this->m_analysis != nullptr && ImHexApi::Provider::isValid() && ImHexApi::Provider::get()->getDataRevision() == this->m_analysis->dataRevision) {
+                this->m_analysisOutdated = true;
+                return;
+            }
+
+            this->m_analysisOutdated = false;
             this->m_dataValid = false;
             this->m_highestBlockEntropy = 0;
             this->m_blockEntropy.clear();
@@ -32,6 +39,7 @@ namespace hex::plugin::builtin {
             this->m_mimeType = "";
             this->m_fileDescription = "";
             this->m_analyzedRegion = { 0, 0 };
+            this->m_analysis = nullptr;
         });
 
         EventManager::subscribe<EventRegionSelected>(this, [this](Region region) {
@@ -62,20 +70,6 @@ namespace hex::plugin::builtin {
         EventManager::unsubscribe<EventFileUnloaded>(this);
     }
 
-    static float calculateEntropy(std::array<ImU64, 256> &valueCounts, size_t blockSize) {
-        float entropy = 0;
-
-        for (auto count : valueCounts) {
-            if (count == 0) continue;
-
-            float probability = static_cast<float>(count) / blockSize;
-
-            entropy += probability * std::log2(probability);
-        }
-
-        return (-entropy) / 8; // log2(256) = 8
-    }
-
     void ViewInformation::analyze() {
         this->m_analyzing = true;
 
@@ -93,37 +87,75 @@ namespace hex::plugin::builtin {
                 this->m_mimeType = magic::getMIMEType(provider);
             }
 
-            this->m_dataValid = true;
-
             {
-                this->m_blockSize = std::max<u32>(std::ceil(provider->getSize() / 2048.0F), 256);
-                std::vector<u8> buffer(this->m_blockSize, 0x00);
-                std::memset(this->m_valueCounts.data(), 0x00, this->m_valueCounts.size() * sizeof(u32));
-                this->m_blockEntropy.clear();
-                this->m_valueCounts.fill(0);
-
-                for (u64 i = 0; i < provider->getSize(); i += this->m_blockSize) {
-                    std::array<ImU64, 256> blockValueCounts = { 0 };
-                    provider->read(i + provider->getBaseAddress(), buffer.data(), std::min(u64(this->m_blockSize), provider->getSize() - i));
-
-                    for (size_t j = 0; j < this->m_blockSize; j++) {
-                        blockValueCounts[buffer[j]]++;
-                        this->m_valueCounts[buffer[j]]++;
-                    }
+                const u32 blockSize = std::max<u32>(std::ceil(provider->getSize() / 2048.0F), 256);
 
-                    this->m_blockEntropy.push_back(calculateEntropy(blockValueCounts, this->m_blockSize));
-                    task.update(i);
-                }
+                auto analysis = ByteAnalyzer::analyze(provider, provider->getBaseAddress(), provider->getSize(), blockSize, [&task](u64 processedSize) {
+                    task.update(processedSize);
+                });
+
+                std::scoped_lock lock(this->m_analysisMutex);
+                this->m_pendingAnalysis = std::move(analysis);
+            }
+
+            this->m_analyzing = false;
+        }).detach();
+    }
 
-                this->m_averageEntropy = calculateEntropy(this->m_valueCounts, provider->getSize());
-                this->m_highestBlockEntropy = *std::max_element(this->m_blockEntropy.begin(), this->m_blockEntropy.end());
+    void ViewInformation::updateAnalysis() {
+        this->m_analyzing = true;
+        this->m_analysisOutdated = false;
+
+        std::thread([this, previous = this->m_analysis]{
+            auto analysis = ByteAnalyzer::update(ImHexApi::Provider::get(), previous);
+
+            {
+                std::scoped_lock lock(this->m_analysisMutex);
+                this->m_pendingAnalysis = std::move(analysis);
             }
 
             this->m_analyzing = false;
         }).detach();
     }
 
+    void ViewInformation::applyAnalysis(const std::shared_ptr<const ByteAnalyzer::Result> &analysis) {
+        this->m_analysis = analysis;
+        this->m_blockSize = analysis->blockSize;
+
+        this->m_blockEntropy.clear();
+        this->m_blockEntropy.reserve(analysis->blockStatistics.size());
+        for (const auto &statistics : analysis->blockStatistics)
+            this->m_blockEntropy.push_back(statistics.entropy);
+
+        std::copy(analysis->histogram.begin(), analysis->histogram.end(), this->m_valueCounts.begin());
+
+        this->m_averageEntropy = analysis->statistics.entropy;
+        this->m_highestBlockEntropy = this->m_blockEntropy.empty() ? 0 : *std::max_element(this->m_blockEntropy.begin(), this->m_blockEntropy.end());
+
+        this->m_dataValid = true;
+
+        // Data changed while the analysis was running isn't part of its result yet
+        if (ImHexApi::Provider::isValid() && ImHexApi::Provider::get()->getRevision() != analysis->revision)
+            this->m_analysisOutdated = true;
+    }
+
     void ViewInformation::drawContent() {
+        {
+            std::scoped_lock lock(this->m_analysisMutex);
+            if (this->m_pendingAnalysis != nullptr)
+                this->applyAnalysis(std::exchange(this->m_pendingAnalysis, nullptr));
+        }
+
+        if (this->m_analysisOutdated && !this->m_analyzing && this->m_analysis != nullptr && ImHexApi::Provider::isValid()) {
+            // Only patches and overlays can be updated incrementally, everything else has to be analyzed again
+            if (ImHexApi::Provider::get()->getDataRevision() == this->m_analysis->dataRevision) {
+                this->updateAnalysis();
+            } else {
+                this->m_analysisOutdated = false;
+                this->analyze();
+            }
+        }
+
         if (ImGui::Begin(View::toWindowName("hex.builtin.view.information.name").c_str(), &this->getWindowOpenState(), ImGuiWindowFlags_NoCollapse)) {
             if (ImGui::BeginChild("##scrolling", ImVec2(0, 0), false, ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoNav)) {
 
@@ -152,7 +184,12 @@ namespace hex::plugin::builtin {
                         ImGui::LabelText(name.c_str(), "%s", value.c_str());
                     }
 
-                    if (this->m_dataValid) {
+                    if (const auto &cache = provider->getReadCache(); cache.getHitCount() + cache.getMissCount() > 0) {
+                        ImGui::LabelText("hex.builtin.view.information.read_cache"_lang, "%s", hex::format("hex.builtin.view.information.read_cache.desc"_lang, cache.getHitCount(), cache.getMissCount(), hex::toByteString(cache.getPageSize())).c_str());
+                    }
+
+                    if (this->m_dataValid && this->m_analysis != nullptr) {
+                        const auto &statistics = this->m_analysis->statistics;
 
                         ImGui::LabelText("hex.builtin.view.information.region"_lang, "0x%llx - 0x%llx", this->m_analyzedRegion.first, this->m_analyzedRegion.second);
 
@@ -219,6 +256,11 @@ namespace hex::plugin::builtin {
                         ImGui::LabelText("hex.builtin.view.information.block_size"_lang, "%s", hex::format("hex.builtin.view.information.block_size.desc"_lang, this->m_blockEntropy.size(), this->m_blockSize).c_str());
                         ImGui::LabelText("hex.builtin.view.information.file_entropy"_lang, "%.8f", this->m_averageEntropy);
                         ImGui::LabelText("hex.builtin.view.information.highest_entropy"_lang, "%.8f", this->m_highestBlockEntropy);
+                        ImGui::LabelText("hex.builtin.view.information.chi_square"_lang, "%.2f", statistics.chiSquare);
+                        ImGui::LabelText("hex.builtin.view.information.mean"_lang, "%.4f", statistics.mean);
+                        ImGui::LabelText("hex.builtin.view.information.printable"_lang, "%.2f%%", statistics.printableRatio * 100);
+                        ImGui::LabelText("hex.builtin.view.information.zero"_lang, "%.2f%%", statistics.zeroRatio * 100);
+                        ImGui::LabelText("hex.builtin.view.information.high_bit"_lang, "%.2f%%", statistics.highBitRatio * 100);
 
                         if (this->m_averageEntropy > 0.83 && this->m_highestBlockEntropy > 0.9) {
                             ImGui::NewLine();
@@ -35,6 +35,8 @@ namespace hex::plugin::builtin {
 
             if (ImHexApi::Provider::isValid() && provider->isReadable()) {
 
+                ImGui::TextFormatted("hex.builtin.view.patches.undo_history"_lang, provider->getUndoStepCount(), hex::toByteString(provider->getUndoHistorySize()));
+
                 if (ImGui::BeginTable("##patchesTable", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_Sortable |
                                                         ImGuiTableFlags_Reorderable | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
                     ImGui::TableSetupScrollFreeze(0, 1);
@@ -51,11 +53,15 @@ namespace hex::plugin::builtin {
 
                     while (clipper.Step()) {
                         auto iter = patches.begin();
-                        for (auto i = 0; i < clipper.DisplayStart; i++)
+                        u64 extentOffset = clipper.DisplayStart;
+                        while (iter != patches.end() && extentOffset >= iter->second.size()) {
+                            extentOffset -= iter->second.size();
                             iter++;
+                        }
 
-                        for (auto i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
-                            const auto &[address, patch] = *iter;
+                        for (auto i = clipper.DisplayStart; i < clipper.DisplayEnd && iter != patches.end(); i++) {
+                            const u64 address = iter->first + extentOffset;
+                            const u8 patch = iter->second[extentOffset];
 
                             ImGui::TableNextRow();
                             ImGui::TableNextColumn();
@@ -79,13 +85,17 @@ namespace hex::plugin::builtin {
                             ImGui::TextFormatted("0x{0:02X}", patch);
                             index += 1;
 
-                            iter++;
+                            extentOffset++;
+                            if (extentOffset >= iter->second.size()) {
+                                extentOffset = 0;
+                                iter++;
+                            }
                         }
                     }
 
                     if (ImGui::BeginPopup("PatchContextMenu")) {
                         if (ImGui::MenuItem("hex.builtin.view.patches.remove"_lang)) {
-                            patches.erase(this->m_selectedPatch);
+                            patches.remove(this->m_selectedPatch);
                             ProjectFile::markDirty();
                         }
                         ImGui::EndPopup();
@@ -13,6 +13,8 @@
 
 #include <nlohmann/json.hpp>
 
+#include <chrono>
+
 namespace hex::plugin::builtin {
 
     using namespace hex::literals;
@@ -159,9 +161,23 @@ namespace hex::plugin::builtin {
             }
         });
 
+        EventManager::subscribe<EventDataChanged>(this, [this]{
+            // Only the top-level declarations that read modified data get evaluated again so this is cheap enough to do on every edit
+            if (this->m_evaluatedProvider != ImHexApi::Provider::get())
+                return;
+
+            if (this->m_hasEvaluationResult || this->m_evaluatorRunning)
+                this->evaluatePattern(this->m_evaluatedCode, true);
+        });
+
         EventManager::subscribe<EventFileUnloaded>(this, [this]{
             this->m_textEditor.SetText("");
-            this->m_evaluatorRuntime->abort();
+            this->resetEvaluation();
+        });
+
+        EventManager::subscribe<EventProviderDeleted>(this, [this](hex::prv::Provider *provider){
+            if (provider == this->m_evaluatedProvider)
+                this->resetEvaluation();
         });
 
         /* Settings */
@@ -197,6 +213,8 @@ namespace hex::plugin::builtin {
     }
 
     ViewPatternEditor::~ViewPatternEditor() {
+        this->cancelEvaluation();
+
         delete this->m_evaluatorRuntime;
         delete this->m_parserRuntime;
 
@@ -206,6 +224,8 @@ namespace hex::plugin::builtin {
         EventManager::unsubscribe<EventFileLoaded>(this);
         EventManager::unsubscribe<RequestChangeTheme>(this);
         EventManager::unsubscribe<EventFileUnloaded>(this);
+        EventManager::unsubscribe<EventDataChanged>(this);
+        EventManager::unsubscribe<EventProviderDeleted>(this);
     }
 
     void ViewPatternEditor::drawMenu() {
@@ -276,8 +296,10 @@ namespace hex::plugin::builtin {
                 ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 1);
 
                 if (this->m_evaluatorRunning) {
-                    if (ImGui::IconButton(ICON_VS_DEBUG_STOP, ImGui::GetCustomColorVec4(ImGuiCustomCol_ToolbarRed)))
+                    if (ImGui::IconButton(ICON_VS_DEBUG_STOP, ImGui::GetCustomColorVec4(ImGuiCustomCol_ToolbarRed))) {
+                        this->m_pendingEvaluation.reset();
                         this->m_evaluatorRuntime->abort();
+                    }
                 } else {
                     if (ImGui::IconButton(ICON_VS_DEBUG_START, ImGui::GetCustomColorVec4(ImGuiCustomCol_ToolbarGreen)))
                         this->evaluatePattern(this->m_textEditor.GetText());
@@ -294,17 +316,16 @@ namespace hex::plugin::builtin {
                         if (this->m_runAutomatically)
                             this->m_hasUnevaluatedChanges = true;
                     }
+                }
 
-                    ImGui::SameLine();
-                    ImGui::SeparatorEx(ImGuiSeparatorFlags_Vertical);
-                    ImGui::SameLine();
-
-                    ImGui::TextFormatted("{} / {}",
-                        this->m_evaluatorRuntime->getCreatedPatternCount(),
-                        this->m_evaluatorRuntime->getMaximumPatternCount()
-                    );
+                ImGui::SameLine();
+                ImGui::SeparatorEx(ImGuiSeparatorFlags_Vertical);
+                ImGui::SameLine();
 
-                }
+                ImGui::TextFormatted("{} / {}",
+                    this->m_evaluatorRuntime->getCreatedPatternCount(),
+                    this->m_evaluatorRuntime->getMaximumPatternCount()
+                );
 
                 if (this->m_textEditor.IsTextChanged()) {
                     ProjectFile::markDirty();
@@ -522,6 +543,17 @@ namespace hex::plugin::builtin {
     }
 
     void ViewPatternEditor::drawAlwaysVisible() {
+        // Patterns placed in another provider don't mean anything in the one that's selected now
+        if (this->m_evaluatedProvider != nullptr && this->m_evaluatedProvider != ImHexApi::Provider::get())
+            this->resetEvaluation();
+
+        // Evaluations requested while the previous one was running start once it stopped. An aborted or failed run didn't leave anything behind that could be reused
+        if (this->m_pendingEvaluation.has_value() && !this->m_evaluatorRunning) {
+            auto [code, reuseResult] = std::move(this->m_pendingEvaluation.value());
+            this->m_pendingEvaluation.reset();
+
+            this->evaluatePattern(code, reuseResult && this->m_hasEvaluationResult);
+        }
 
         ImGui::SetNextWindowPos(ImGui::GetMainViewport()->GetCenter(), ImGuiCond_Appearing, ImVec2(0.5F, 0.5F));
         if (ImGui::BeginPopupModal("hex.builtin.view.pattern_editor.accept_pattern"_lang, &this->m_acceptPatternWindowOpen, ImGuiWindowFlags_AlwaysAutoResize)) {
@@ -608,11 +640,15 @@ namespace hex::plugin::builtin {
     }
 
     void ViewPatternEditor::clearPatternData() {
+        std::scoped_lock lock(SharedData::patternDataMutex);
+
         for (auto &data : SharedData::patternData)
             delete data;
 
         SharedData::patternData.clear();
         pl::PatternData::resetPalette();
+
+        this->m_hasEvaluationResult = false;
     }
 
 
@@ -651,30 +687,117 @@ namespace hex::plugin::builtin {
         }).detach();
     }
 
-    void ViewPatternEditor::evaluatePattern(const std::string &code) {
-        this->m_evaluatorRunning = true;
+    void ViewPatternEditor::cancelEvaluation() {
+        if (!this->m_evaluatorThread.joinable())
+            return;
 
-        this->m_textEditor.SetErrorMarkers({ });
-        this->m_console.clear();
+        this->m_evaluatorRuntime->abort();
+        this->m_evaluatorThread.join();
+    }
+
+    void ViewPatternEditor::resetEvaluation() {
+        this->m_pendingEvaluation.reset();
+        this->cancelEvaluation();
         this->clearPatternData();
 
-        {
+        std::vector<pl::PatternData*> patterns;
+        EventManager::post<EventPatternChanged>(patterns);
+
+        this->m_evaluatedCode.clear();
+        this->m_evaluatedProvider = nullptr;
+    }
+
+    void ViewPatternEditor::evaluatePattern(const std::string &code, bool reuseResult) {
+        auto provider = ImHexApi::Provider::get();
+
+        // The last result can only be updated incrementally for the provider it was placed in
+        if (provider != this->m_evaluatedProvider)
+            reuseResult = false;
+
+        // Only one evaluation may run at a time. Waiting for it here would block the UI, so new code aborts it and the latest request starts once it stopped
+        if (this->m_evaluatorRunning) {
+            if (!reuseResult)
+                this->m_evaluatorRuntime->abort();
+
+            // Reusing a result also picks up the changed data, so a pending full run covers it already
+            if (!reuseResult || !this->m_pendingEvaluation.has_value())
+                this->m_pendingEvaluation = PendingEvaluation { code, reuseResult };
+
+            return;
+        }
+
+        // The previous evaluation already finished and released all of its patterns
+        if (this->m_evaluatorThread.joinable())
+            this->m_evaluatorThread.join();
+        this->m_evaluatorRuntime->resetAbort();
+
+        this->m_evaluatorRunning = true;
+        this->m_evaluatedCode = code;
+        this->m_evaluatedProvider = provider;
+
+        // When reusing the last result, the runtime takes back the current patterns and replaces them itself
+        if (!reuseResult) {
+            this->m_textEditor.SetErrorMarkers({ });
+            this->m_console.clear();
+            this->clearPatternData();
+
             std::vector<pl::PatternData*> patterns;
             EventManager::post<EventPatternChanged>(patterns);
         }
 
-        std::thread([this, code] {
-            std::map<std::string, pl::Token::Literal> envVars;
-            for (const auto &[id, name, value, type] : this->m_envVarEntries)
-                envVars.insert({ name, value });
+        {
+            // Displayed patterns run their formatters on the runtime while they're drawn. That has to stop before the worker touches any of its state
+            std::scoped_lock lock(SharedData::patternDataMutex);
+            this->m_evaluatorRuntime->setBusy(true);
+        }
 
-            std::map<std::string, pl::Token::Literal> inVariables;
-            for (auto &[name, variable] : this->m_patternVariables) {
-                if (variable.inVariable)
-                    inVariables[name] = variable.value;
-            }
+        std::map<std::string, pl::Token::Literal> envVars;
+        for (const auto &[id, name, value, type] : this->m_envVarEntries)
+            envVars.insert({ name, value });
 
-            auto result = this->m_evaluatorRuntime->executeString(ImHexApi::Provider::get(), code, envVars, inVariables);
+        std::map<std::string, pl::Token::Literal> inVariables;
+        for (auto &[name, variable] : this->m_patternVariables) {
+            if (variable.inVariable)
+                inVariables[name] = variable.value;
+        }
+
+        this->m_evaluatorThread = std::jthread([this, provider, code, reuseResult, envVars = std::move(envVars), inVariables = std::move(inVariables)] {
+            auto task = ImHexApi::Tasks::createTask("hex.builtin.view.pattern_editor.evaluating", provider != nullptr ? provider->getActualSize() : 0);
+
+            // Patterns are shown as soon as the first top-level declaration finished, after that updates are throttled so large formats don't rebuild the views constantly
+            constexpr static auto PartialResultInterval = std::chrono::milliseconds(100);
+            std::chrono::steady_clock::time_point lastPartialResult;
+            size_t lastPartialResultSize = 0;
+
+            this->m_evaluatorRuntime->setPartialResultCallback([&](const std::vector<pl::PatternData*> &patterns) {
+                // Lists that drop patterns have to be applied right away since those are about to be destroyed
+                const auto now = std::chrono::steady_clock::now();
+                if (patterns.size() > lastPartialResultSize && now - lastPartialResult < PartialResultInterval)
+                    return;
+                lastPartialResult = now;
+                lastPartialResultSize = patterns.size();
+
+                std::vector<pl::PatternData*> placedPatterns;
+                u64 bytesCovered = 0;
+                for (auto pattern : patterns) {
+                    if (pattern->isLocal())
+                        continue;
+
+                    placedPatterns.push_back(pattern);
+                    bytesCovered = std::max(bytesCovered, pattern->getOffset() + pattern->getSize());
+                }
+                task.update(bytesCovered);
+                task.setStatus(hex::format("{} / {}", this->m_evaluatorRuntime->getCreatedPatternCount(), this->m_evaluatorRuntime->getMaximumPatternCount()));
+
+                // Views only draw patterns while holding the lock so the evaluator can safely destroy them after they've been removed here
+                std::scoped_lock lock(SharedData::patternDataMutex);
+                SharedData::patternData = std::move(placedPatterns);
+                EventManager::post<EventPatternChanged>(SharedData::patternData);
+            });
+
+            auto result = reuseResult ? this->m_evaluatorRuntime->reexecuteString(provider, code, envVars, inVariables)
+                                      : this->m_evaluatorRuntime->executeString(provider, code, envVars, inVariables);
+            this->m_evaluatorRuntime->setPartialResultCallback(nullptr);
 
             auto error = this->m_evaluatorRuntime->getError();
             if (error.has_value()) {
@@ -689,14 +812,20 @@ namespace hex::plugin::builtin {
                     variable.value = outVariables.at(name);
             }
 
-            if (result.has_value()) {
-                SharedData::patternData = std::move(result.value());
-                EventManager::post<EventPatternChanged>(SharedData::patternData);
+            {
+                std::scoped_lock lock(SharedData::patternDataMutex);
+                if (result.has_value()) {
+                    SharedData::patternData = std::move(result.value());
+                    EventManager::post<EventPatternChanged>(SharedData::patternData);
+                }
+
+                this->m_evaluatorRuntime->setBusy(false);
             }
 
-            this->m_evaluatorRunning = false;
-        }).detach();
+            this->m_hasEvaluationResult = result.has_value();
 
+            this->m_evaluatorRunning = false;
+        });
     }
 
 }
@@ -2,10 +2,12 @@
 
 #include <hex/providers/provider.hpp>
 #include <hex/helpers/fmt.hpp>
+#include <hex/helpers/utils.hpp>
 
 #include <cstring>
+#include <numeric>
+#include <span>
 #include <thread>
-#include <regex>
 
 #include <llvm/Demangle/Demangle.h>
 #include <hex/ui/imgui_imhex_extensions.h>
@@ -16,14 +18,14 @@ namespace hex::plugin::builtin {
 
     ViewStrings::ViewStrings() : View("hex.builtin.view.strings.name") {
         EventManager::subscribe<EventDataChanged>(this, [this]() {
-            this->m_foundStrings.clear();
+            this->clearStrings();
         });
 
         this->m_filter.reserve(0xFFFF);
         std::memset(this->m_filter.data(), 0x00, this->m_filter.capacity());
 
         EventManager::subscribe<EventFileUnloaded>(this, [this]{
-            this->m_foundStrings.clear();
+            this->clearStrings();
         });
     }
 
@@ -32,17 +34,59 @@ namespace hex::plugin::builtin {
         EventManager::unsubscribe<EventFileUnloaded>(this);
     }
 
-    std::string readString(const FoundString &foundString) {
-        std::string string(foundString.size + 1, '\0');
-        ImHexApi::Provider::get()->read(foundString.offset, string.data(), foundString.size);
+    void ViewStrings::clearStrings() {
+        this->m_searchThread = std::jthread();
+        this->m_searching = false;
 
-        return string;
+        {
+            std::scoped_lock lock(this->m_pendingStringsMutex);
+            this->m_pendingStringsReady = false;
+            this->m_pendingStrings.clear();
+            this->m_pendingStringTable.clear();
+        }
+
+        this->m_filterThread = std::jthread();
+        this->m_filtering = false;
+
+        {
+            std::scoped_lock lock(this->m_filterMutex);
+            this->m_pendingFilterResult.reset();
+        }
+
+        this->m_foundStrings.clear();
+        this->m_strings.clear();
+        this->m_filterIndices.clear();
+        this->m_activeFilter = StringFilter();
+    }
+
+    void ViewStrings::startFilter() {
+        auto filter = StringFilter::create(this->m_filter, this->m_regex);
+        this->m_pattern_parsed = filter.has_value();
+        if (!filter.has_value())
+            return;
+
+        // When the filter only got more specific, strings that didn't match before can't match now either
+        std::optional<std::vector<size_t>> candidates;
+        if (filter->narrows(this->m_activeFilter) && this->m_filterIndices.size() != this->m_foundStrings.size())
+            candidates = this->m_filterIndices;
+
+        // Replacing the thread stops and joins the previous one
+        this->m_filtering = true;
+        this->m_filterThread = std::jthread([this, filter = std::move(*filter), candidates = std::move(candidates)](const std::stop_token &stopToken) {
+            auto indices = filter.apply(this->m_strings, candidates, stopToken);
+            if (!indices.has_value())
+                return;
+
+            std::scoped_lock lock(this->m_filterMutex);
+            this->m_pendingFilterResult = { filter, std::move(*indices) };
+            this->m_filtering = false;
+        });
     }
 
-    void ViewStrings::createStringContextMenu(const FoundString &foundString) {
+    void ViewStrings::createStringContextMenu(size_t index) {
         if (ImGui::TableGetColumnFlags(2) == ImGuiTableColumnFlags_IsHovered && ImGui::IsMouseReleased(1) && ImGui::IsItemHovered()) {
             ImGui::OpenPopup("StringContextMenu");
-            this->m_selectedString = readString(foundString);
+            this->m_selectedString = this->m_strings.get(index);
         }
         if (ImGui::BeginPopup("StringContextMenu")) {
             if (ImGui::MenuItem("hex.builtin.view.strings.copy"_lang)) {
@@ -59,80 +103,116 @@ namespace hex::plugin::builtin {
     }
 
     void ViewStrings::searchStrings() {
-        this->m_foundStrings.clear();
-        this->m_filterIndices.clear();
+        this->clearStrings();
         this->m_searching = true;
 
-        std::thread([this] {
+        this->m_searchThread = std::jthread([this, extractor = StringExtractor(this->m_encoding, this->m_minimumLength, this->m_encodingFile)](const std::stop_token &stopToken) {
+            ON_SCOPE_EXIT { this->m_searching = false; };
+
             auto provider = ImHexApi::Provider::get();
             auto task = ImHexApi::Tasks::createTask("hex.builtin.view.strings.searching", provider->getActualSize());
 
-            std::vector<u8> buffer(1024, 0x00);
-            u32 foundCharacters = 0;
-
-            for (u64 offset = 0; offset < provider->getActualSize(); offset += buffer.size()) {
-                task.update(offset);
+            auto results = extractor.extract(provider, provider->getBaseAddress(), provider->getActualSize(), [&task](u64 processedSize) {
+                task.update(processedSize);
+            }, 0, stopToken);
 
-                size_t readSize = std::min(u64(buffer.size()), provider->getActualSize() - offset);
-                provider->read(offset + provider->getBaseAddress(),  buffer.data(), readSize);
+            // Decode everything once so filtering, sorting and drawing never have to touch the provider again
+            std::vector<FoundString> foundStrings;
+            StringTable strings;
+            std::vector<u8> buffer;
 
-                for (u32 i = 0; i < readSize; i++) {
-                    if (buffer[i] >= ' ' && buffer[i] <= '~' && offset < provider->getActualSize() - 1)
-                        foundCharacters++;
-                    else {
-                        if (foundCharacters >= this->m_minimumLength) {
-                            FoundString foundString = {
-                                offset + i - foundCharacters + provider->getBaseAddress(),
-                                foundCharacters
-                            };
+            foundStrings.reserve(results.size());
+            for (const auto &[address, size] : results) {
+                if (stopToken.stop_requested())
+                    return;
 
-                            this->m_foundStrings.push_back(foundString);
-                            this->m_filterIndices.push_back(this->m_foundStrings.size() - 1);
-                        }
+                buffer.resize(size);
+                provider->read(address, buffer.data(), buffer.size());
 
-                        foundCharacters = 0;
-                    }
-                }
+                foundStrings.push_back({ address, size });
+                strings.add(extractor.decode(buffer));
             }
 
-            this->m_searching = false;
-        }).detach();
+            {
+                std::scoped_lock lock(this->m_pendingStringsMutex);
 
+                this->m_pendingStrings = std::move(foundStrings);
+                this->m_pendingStringTable = std::move(strings);
+            }
+
+            this->m_pendingStringsReady = true;
+        });
     }
 
     void ViewStrings::drawContent() {
         auto provider = ImHexApi::Provider::get();
 
+        if (this->m_pendingStringsReady.exchange(false)) {
+            std::vector<FoundString> foundStrings;
+            StringTable strings;
+            {
+                std::scoped_lock lock(this->m_pendingStringsMutex);
+                std::swap(foundStrings, this->m_pendingStrings);
+                std::swap(strings, this->m_pendingStringTable);
+            }
+
+            this->clearStrings();
+            this->m_foundStrings = std::move(foundStrings);
+            this->m_strings = std::move(strings);
+
+            this->m_filterIndices.resize(this->m_foundStrings.size());
+            std::iota(this->m_filterIndices.begin(), this->m_filterIndices.end(), 0);
+            this->m_sortRequired = true;
+
+            if (!this->m_filter.empty())
+                this->startFilter();
+        }
+
+        {
+            std::scoped_lock lock(this->m_filterMutex);
+
+            if (this->m_pendingFilterResult.has_value()) {
+                std::tie(this->m_activeFilter, this->m_filterIndices) = std::move(*this->m_pendingFilterResult);
+                this->m_pendingFilterResult.reset();
+                this->m_sortRequired = true;
+            }
+        }
+
         if (ImGui::Begin(View::toWindowName("hex.builtin.view.strings.name").c_str(), &this->getWindowOpenState(), ImGuiWindowFlags_NoCollapse)) {
             if (ImHexApi::Provider::isValid() && provider->isReadable()) {
                 ImGui::Disabled([this]{
                     if (ImGui::InputInt("hex.builtin.view.strings.min_length"_lang, &this->m_minimumLength, 1, 0))
-                        this->m_foundStrings.clear();
+                        this->clearStrings();
+
+                    const char *encodings[] = { "ASCII", "UTF-8", "UTF-16LE", "UTF-16BE", "hex.builtin.view.strings.encoding.custom"_lang };
+                    int selectedEncoding = static_cast<int>(this->m_encoding);
+                    if (ImGui::Combo("hex.builtin.view.strings.encoding"_lang, &selectedEncoding, encodings, IM_ARRAYSIZE(encodings))) {
+                        this->m_encoding = static_cast<StringExtractor::Encoding>(selectedEncoding);
+                        this->clearStrings();
+                    }
 
-                    ImGui::Checkbox("Regex", &this->m_regex);
+                    if (this->m_encoding == StringExtractor::Encoding::Custom) {
+                        if (ImGui::Button("hex.builtin.view.strings.encoding.load"_lang)) {
+                            hex::openFileBrowser("hex.builtin.view.strings.encoding.load"_lang, DialogMode::Open, { { "Thingy Table File", "tbl" } }, [this](const auto &path) {
+                                this->m_encodingFile = EncodingFile(EncodingFile::Type::Thingy, path);
+                                this->clearStrings();
+                            });
+                        }
+
+                        if (!this->m_encodingFile.valid()) {
+                            ImGui::SameLine();
+                            ImGui::TextFormattedColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "{}", "hex.builtin.view.strings.encoding.no_file"_lang);
+                        }
+                    }
+
+                    if (ImGui::Checkbox("Regex", &this->m_regex))
+                        this->startFilter();
 
                     ImGui::InputText("hex.builtin.view.strings.filter"_lang, this->m_filter.data(), this->m_filter.capacity(), ImGuiInputTextFlags_CallbackEdit, [](ImGuiInputTextCallbackData *data) {
                         auto &view = *static_cast<ViewStrings*>(data->UserData);
                         view.m_filter.resize(data->BufTextLen);
-                        view.m_filterIndices.clear();
-                        std::regex pattern;
-                        if (view.m_regex) {
-                            try {
-                                pattern = std::regex(data->Buf);
-                                view.m_pattern_parsed = true;
-                            } catch (std::regex_error &e) {
-                                view.m_pattern_parsed = false;
-                            }
-                        } 
-                        for (u64 i = 0; i < view.m_foundStrings.size(); i++) {
-                            if (view.m_regex) {
-                                if(view.m_pattern_parsed && std::regex_search(readString(view.m_foundStrings[i]), pattern))
-                                    view.m_filterIndices.push_back(i);
-                            }
-                            else if (readString(view.m_foundStrings[i]).find(data->Buf) != std::string::npos) {
-                                view.m_filterIndices.push_back(i);
-                            }
-                        }
+                        view.startFilter();
+
                         return 0;
                     }, this);
                     if (this->m_regex && !this->m_pattern_parsed) {
@@ -147,6 +227,10 @@ namespace hex::plugin::builtin {
                     ImGui::SameLine();
                     ImGui::TextSpinner("hex.builtin.view.strings.searching"_lang);
                 }
+                else if (this->m_filtering) {
+                    ImGui::SameLine();
+                    ImGui::TextSpinner("hex.builtin.view.strings.filtering"_lang);
+                }
                 else if (this->m_foundStrings.size() > 0) {
                     ImGui::SameLine();
                     ImGui::TextFormatted("hex.builtin.view.strings.results"_lang, this->m_filterIndices.size());
@@ -166,9 +250,11 @@ namespace hex::plugin::builtin {
 
                     auto sortSpecs = ImGui::TableGetSortSpecs();
 
-                    if (sortSpecs->SpecsDirty) {
-                        std::sort(this->m_foundStrings.begin(), this->m_foundStrings.end(),
-                                  [&sortSpecs](FoundString &left, FoundString &right) -> bool {
+                    if ((sortSpecs->SpecsDirty || this->m_sortRequired) && sortSpecs->SpecsCount > 0) {
+                        std::sort(this->m_filterIndices.begin(), this->m_filterIndices.end(),
+                                  [this, &sortSpecs](size_t leftIndex, size_t rightIndex) -> bool {
+                                      const auto &left = this->m_foundStrings[leftIndex], &right = this->m_foundStrings[rightIndex];
+
                                       if (sortSpecs->Specs->ColumnUserID == ImGui::GetID("offset")) {
                                           if (sortSpecs->Specs->SortDirection == ImGuiSortDirection_Ascending)
                                               return left.offset > right.offset;
@@ -181,15 +267,16 @@ namespace hex::plugin::builtin {
                                               return left.size < right.size;
                                       } else if (sortSpecs->Specs->ColumnUserID == ImGui::GetID("string")) {
                                           if (sortSpecs->Specs->SortDirection == ImGuiSortDirection_Ascending)
-                                              return readString(left) > readString(right);
+                                              return this->m_strings.get(leftIndex) > this->m_strings.get(rightIndex);
                                           else
-                                              return readString(left) < readString(right);
+                                              return this->m_strings.get(leftIndex) < this->m_strings.get(rightIndex);
                                       }
 
                                       return false;
                                   });
 
                         sortSpecs->SpecsDirty = false;
+                        this->m_sortRequired = false;
                     }
 
                     ImGui::TableHeadersRow();
@@ -199,8 +286,9 @@ namespace hex::plugin::builtin {
 
                     while (clipper.Step()) {
                         for (u64 i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
-                            auto &foundString = this->m_foundStrings[this->m_filterIndices[i]];
-                            auto string = readString(foundString);
+                            const auto index = this->m_filterIndices[i];
+                            const auto &foundString = this->m_foundStrings[index];
+                            const auto string = this->m_strings.get(index);
 
                             ImGui::TableNextRow();
                             ImGui::TableNextColumn();
@@ -208,7 +296,7 @@ namespace hex::plugin::builtin {
                                 EventManager::post<RequestSelectionChange>(Region { foundString.offset, foundString.size });
                             }
                             ImGui::PushID(i + 1);
-                            createStringContextMenu(foundString);
+                            createStringContextMenu(index);
                             ImGui::PopID();
                             ImGui::SameLine();
                             ImGui::TextFormatted("0x{0:08X} : 0x{1:08X}", foundString.offset, foundString.offset + foundString.size);
@@ -216,7 +304,7 @@ namespace hex::plugin::builtin {
                             ImGui::TextFormatted("0x{0:04X}", foundString.size);
                             ImGui::TableNextColumn();
 
-                            ImGui::TextUnformatted(string.c_str());
+                            ImGui::TextUnformatted(string.data(), string.data() + string.size());
                         }
                     }
                     clipper.End();
@@ -2,18 +2,142 @@
 
 #include <hex/providers/provider.hpp>
 #include <hex/helpers/utils.hpp>
+#include <hex/helpers/crypto.hpp>
 #include <hex/helpers/file.hpp>
 #include <hex/helpers/paths.hpp>
 #include <hex/helpers/logger.hpp>
 
 #include <yara.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <optional>
 #include <filesystem>
+#include <future>
+#include <map>
 #include <thread>
 
 #include <hex/helpers/paths.hpp>
 
 namespace hex::plugin::builtin {
 
+    namespace {
+
+        // Only this much of the data is held in memory per block at once
+        constexpr size_t ScanBlockSize = 0x100'0000;
+
+        // Regular expressions and hex strings with jumps can match more than their length, YARA stops scanning them after this many bytes
+        constexpr size_t MinimumBlockOverlap = 0x1000;
+
+        struct ScanContext {
+            prv::Provider *provider;
+            u64 dataSize;
+            size_t overlap;
+
+            // Blocks following the current one are read on other threads while it's being scanned
+            size_t readAheadCount;
+            std::map<u64, std::future<std::vector<u8>>> pendingBlocks;
+
+            std::vector<u8> buffer;
+            YR_MEMORY_BLOCK currBlock;
+
+            u64 scannedUntil;
+            Task *task;
+            std::vector<ViewYara::YaraMatch> matches;
+        };
+
+        std::vector<u8> readBlock(prv::Provider *provider, u64 address, size_t size) {
+            std::vector<u8> buffer(size);
+            provider->read(address + provider->getBaseAddress(), buffer.data(), buffer.size());
+
+            return buffer;
+        }
+
+        size_t getBlockSize(const ScanContext &context, u64 address) {
+            // Every block reaches into the next one so matches crossing block borders are still found
+            return std::min<u64>(ScanBlockSize + context.overlap, context.dataSize - address);
+        }
+
+        YR_MEMORY_BLOCK* setCurrentBlock(YR_MEMORY_BLOCK_ITERATOR *iterator, u64 address) {
+            auto &context = *static_cast<ScanContext*>(iterator->context);
+
+            iterator->last_error = ERROR_SUCCESS;
+
+            if (address >= context.dataSize)
+                return nullptr;
+
+            context.currBlock.base = address;
+            context.currBlock.size = getBlockSize(context, address);
+            context.currBlock.context = &context;
+
+            // YARA walks the blocks again to evaluate conditions, only count them once
+            const u64 scannedUntil = std::min<u64>(address + ScanBlockSize, context.dataSize);
+            if (scannedUntil > context.scannedUntil) {
+                context.scannedUntil = scannedUntil;
+                context.task->update(scannedUntil);
+            }
+
+            return &context.currBlock;
+        }
+
+        const u8* fetchBlockData(YR_MEMORY_BLOCK *block) {
+            auto &context = *static_cast<ScanContext*>(block->context);
+
+            if (block->size == 0)
+                return nullptr;
+
+            if (auto pending = context.pendingBlocks.find(block->base); pending != context.pendingBlocks.end()) {
+                context.buffer = pending->second.get();
+                context.pendingBlocks.erase(pending);
+            } else {
+                // Blocks that weren't expected, like the ones walked again for conditions, are read here. Providers may not support being read from multiple threads at once
+                context.pendingBlocks.clear();
+                context.buffer = readBlock(context.provider, block->base, block->size);
+            }
+
+            for (size_t i = 1; i <= context.readAheadCount; i++) {
+                const u64 address = block->base + i * ScanBlockSize;
+                if (address >= context.dataSize)
+                    break;
+
+                if (!context.pendingBlocks.contains(address))
+                    context.pendingBlocks.emplace(address, std::async(std::launch::async, readBlock, context.provider, address, getBlockSize(context, address)));
+            }
+
+            return context.buffer.data();
+        }
+
+        size_t getLongestStringLength(YR_RULES *rules) {
+            size_t longest = 0;
+
+            YR_RULE *rule;
+            yr_rules_foreach(rules, rule) {
+                YR_STRING *string;
+                yr_rule_strings_foreach(rule, string) {
+                    longest = std::max<size_t>(longest, string->length);
+                }
+            }
+
+            return longest;
+        }
+
+        // Unlike std::hash, this stays the same across runs and builds so it can be used to name files in the cache folder
+        std::string hashString(const std::string &string) {
+            const auto digest = crypt::sha256(std::vector<u8>(string.begin(), string.end()));
+
+            return crypt::encode16(std::vector<u8>(digest.begin(), digest.end()));
+        }
+
+        std::string hashFile(const fs::path &path) {
+            File file(path, File::Mode::Read);
+            if (!file.isValid())
+                return "";
+
+            return hashString(file.readString());
+        }
+
+    }
+
     ViewYara::ViewYara() : View("hex.builtin.view.yara.name") {
         yr_initialize();
 
@@ -33,6 +157,7 @@ namespace hex::plugin::builtin {
     }
 
     ViewYara::~ViewYara() {
+        this->clearCompiledRules();
         yr_finalize();
     }
 
@@ -53,20 +178,27 @@ namespace hex::plugin::builtin {
                 if (ImGui::Button("hex.builtin.view.yara.reload"_lang)) this->reloadRules();
             } else {
                 ImGui::Disabled([this]{
-                    if (ImGui::BeginCombo("hex.builtin.view.yara.header.rules"_lang, this->m_rules[this->m_selectedRule].first.c_str())) {
-                        for (u32 i = 0; i < this->m_rules.size(); i++) {
-                            const bool selected = (this->m_selectedRule == i);
-                            if (ImGui::Selectable(this->m_rules[i].first.c_str(), selected))
-                                this->m_selectedRule = i;
-
-                            if (selected)
-                                ImGui::SetItemDefaultFocus();
+                    ImGui::Disabled([this]{
+                        if (ImGui::BeginCombo("hex.builtin.view.yara.header.rules"_lang, this->m_rules[this->m_selectedRule].first.c_str())) {
+                            for (u32 i = 0; i < this->m_rules.size(); i++) {
+                                const bool selected = (this->m_selectedRule == i);
+                                if (ImGui::Selectable(this->m_rules[i].first.c_str(), selected))
+                                    this->m_selectedRule = i;
+
+                                if (selected)
+                                    ImGui::SetItemDefaultFocus();
+                            }
+                            ImGui::EndCombo();
                         }
-                        ImGui::EndCombo();
-                    }
+                    }, this->m_scanAllRules);
                     ImGui::SameLine();
                     if (ImGui::Button("hex.builtin.view.yara.reload"_lang)) this->reloadRules();
+                    ImGui::Checkbox("hex.builtin.view.yara.all_rules"_lang, &this->m_scanAllRules);
                     if (ImGui::Button("hex.builtin.view.yara.match"_lang)) this->applyRules();
+                    ImGui::SameLine();
+                    ImGui::Disabled([this]{
+                        if (ImGui::Button("hex.builtin.view.yara.highlight"_lang)) this->highlightMatches();
+                    }, this->m_matches.empty());
                 }, this->m_matching);
 
                 if (this->m_matching) {
@@ -135,6 +267,7 @@ namespace hex::plugin::builtin {
 
     void ViewYara::reloadRules() {
         this->m_rules.clear();
+        this->m_selectedRule = 0;
 
         for (auto path : hex::getPath(ImHexPath::Yara)) {
             if (!fs::exists(path))
@@ -148,123 +281,266 @@ namespace hex::plugin::builtin {
         }
     }
 
-    void ViewYara::applyRules() {
-        this->m_matches.clear();
-        this->m_errorMessage.clear();
-        this->m_matching = true;
+    YR_RULES* ViewYara::getCompiledRules(const std::vector<RuleFile> &ruleFiles) {
+        std::vector<fs::path> paths;
+        std::vector<std::string> sources;
+        std::string combinedSources;
 
-        std::thread([this] {
-            if (!ImHexApi::Provider::isValid()) return;
+        for (const auto &[ruleNamespace, path] : ruleFiles) {
+            File file(path, File::Mode::Read);
+            if (!file.isValid())
+                continue;
 
-            auto provider = ImHexApi::Provider::get();
-            auto task = ImHexApi::Tasks::createTask("hex.builtin.view.yara.matching", provider->getActualSize());
+            paths.push_back(path);
+            sources.push_back(file.readString());
 
-            YR_COMPILER *compiler = nullptr;
-            yr_compiler_create(&compiler);
-            ON_SCOPE_EXIT {
-                yr_compiler_destroy(compiler);
-                this->m_matching = false;
-            };
+            combinedSources += ruleNamespace;
+            combinedSources += '\0';
+            combinedSources += sources.back();
+            combinedSources += '\0';
+        }
 
-            yr_compiler_set_include_callback(
-                    compiler,
-                    [](const char *includeName, const char *callingRuleFileName, const char *callingRuleNamespace, void *userData) -> const char * {
-                        auto currFilePath = static_cast<const char*>(userData);
+        if (paths.empty())
+            return nullptr;
 
-                        File file((fs::path(currFilePath).parent_path() / includeName).string(), File::Mode::Read);
-                        if (!file.isValid())
-                            return nullptr;
+        const auto hash = hashString(combinedSources);
+        const auto includesUpToDate = [](const auto &includes) {
+            return std::all_of(includes.begin(), includes.end(), [](const auto &include) {
+                return hashFile(include.first) == include.second;
+            });
+        };
 
-                        auto size = file.getSize();
-                        char *buffer = new char[size + 1];
-                        file.readBuffer(reinterpret_cast<u8*>(buffer), size);
-                        buffer[size] = 0x00;
+        std::scoped_lock lock(this->m_compiledRulesMutex);
 
-                        return buffer;
-                    },
-                    [](const char *ptr, void *userData) {
-                        delete[] ptr;
-                    },
-                    this->m_rules[this->m_selectedRule].second.data());
+        if (auto iter = this->m_compiledRules.find(paths); iter != this->m_compiledRules.end()) {
+            auto &[cachedHash, includes, rules] = iter->second;
 
+            if (cachedHash == hash && includesUpToDate(includes))
+                return rules;
 
-            File file(this->m_rules[this->m_selectedRule].second, File::Mode::Read);
-            if (!file.isValid()) return;
+            yr_rules_destroy(rules);
+            this->m_compiledRules.erase(iter);
+        }
 
-            if (yr_compiler_add_file(compiler, file.getHandle(), nullptr, nullptr) != 0) {
-                this->m_errorMessage.resize(0xFFFF);
-                yr_compiler_get_error_message(compiler, this->m_errorMessage.data(), this->m_errorMessage.size());
-                return;
+        std::optional<fs::path> cachePath;
+        for (const auto &path : hex::getPath(ImHexPath::Cache)) {
+            cachePath = path / "yara" / hex::format("{}.yarc", hash);
+            break;
+        }
+
+        if (cachePath.has_value()) {
+            std::vector<std::pair<fs::path, std::string>> includes;
+            if (auto rules = this->loadCachedRules(*cachePath, hash, includes); rules != nullptr) {
+                if (includesUpToDate(includes)) {
+                    this->m_compiledRules[paths] = { hash, std::move(includes), rules };
+                    return rules;
+                }
+
+                yr_rules_destroy(rules);
             }
+        }
 
-            YR_RULES *rules;
-            yr_compiler_get_rules(compiler, &rules);
-            ON_SCOPE_EXIT { yr_rules_destroy(rules); };
+        YR_COMPILER *compiler = nullptr;
+        if (yr_compiler_create(&compiler) != ERROR_SUCCESS)
+            return nullptr;
+        ON_SCOPE_EXIT { yr_compiler_destroy(compiler); };
 
-            std::vector<YaraMatch> newMatches;
+        struct IncludeContext {
+            fs::path basePath;
+            std::vector<std::pair<fs::path, std::string>> includes;
+        };
 
-            YR_MEMORY_BLOCK_ITERATOR iterator;
+        IncludeContext includeContext;
 
-            struct ScanContext {
-                Task *task;
-                std::vector<u8> buffer;
-                YR_MEMORY_BLOCK currBlock;
-            };
+        yr_compiler_set_include_callback(
+                compiler,
+                [](const char *includeName, const char *callingRuleFileName, const char *callingRuleNamespace, void *userData) -> const char * {
+                    auto &context = *static_cast<IncludeContext*>(userData);
 
-            ScanContext context;
-            context.task = &task;
-            context.currBlock.base = 0;
-            context.currBlock.fetch_data = [](auto *block) -> const u8* {
-                auto &context = *static_cast<ScanContext*>(block->context);
+                    auto includePath = context.basePath / includeName;
+                    File file(includePath, File::Mode::Read);
+                    if (!file.isValid())
+                        return nullptr;
 
-                auto provider = ImHexApi::Provider::get();
+                    auto size = file.getSize();
+                    char *buffer = new char[size + 1];
+                    file.readBuffer(reinterpret_cast<u8*>(buffer), size);
+                    buffer[size] = 0x00;
 
-                context.buffer.resize(context.currBlock.size);
+                    context.includes.emplace_back(includePath, hashString(std::string(buffer, size)));
 
-                if (context.buffer.empty()) return nullptr;
+                    return buffer;
+                },
+                [](const char *ptr, void *userData) {
+                    delete[] ptr;
+                },
+                &includeContext);
 
-                block->size = context.currBlock.size;
+        for (size_t i = 0; i < ruleFiles.size(); i++) {
+            const auto &[ruleNamespace, path] = ruleFiles[i];
+            includeContext.basePath = path.parent_path();
 
-                provider->read(context.currBlock.base + provider->getBaseAddress(), context.buffer.data(), context.buffer.size());
+            // The compiler can't be used anymore after an error, a single broken file fails the whole set
+            if (yr_compiler_add_string(compiler, sources[i].c_str(), ruleNamespace.empty() ? nullptr : ruleNamespace.c_str()) != 0) {
+                std::vector<char> errorMessage(0xFFFF);
+                yr_compiler_get_error_message(compiler, errorMessage.data(), errorMessage.size());
 
-                return context.buffer.data();
-            };
-            iterator.file_size = [](auto *iterator) -> u64 {
-                return ImHexApi::Provider::get()->getActualSize();
-            };
+                auto message = hex::format("{}: {}", path.filename().string(), errorMessage.data());
+                this->m_errorMessage.assign(message.begin(), message.end());
+                this->m_errorMessage.push_back(0x00);
 
-            iterator.context = &context;
-            iterator.first = [](YR_MEMORY_BLOCK_ITERATOR* iterator) -> YR_MEMORY_BLOCK* {
-                auto &context = *static_cast<ScanContext*>(iterator->context);
+                return nullptr;
+            }
+        }
 
-                context.currBlock.base = 0;
-                context.currBlock.size = 0;
-                context.buffer.clear();
-                iterator->last_error = ERROR_SUCCESS;
+        YR_RULES *rules = nullptr;
+        if (yr_compiler_get_rules(compiler, &rules) != ERROR_SUCCESS)
+            return nullptr;
 
-                return iterator->next(iterator);
-            };
-            iterator.next = [](YR_MEMORY_BLOCK_ITERATOR* iterator) -> YR_MEMORY_BLOCK* {
-                auto &context = *static_cast<ScanContext*>(iterator->context);
+        if (cachePath.has_value())
+            this->saveCachedRules(*cachePath, hash, rules, includeContext.includes);
+
+        this->m_compiledRules[paths] = { hash, std::move(includeContext.includes), rules };
+
+        return rules;
+    }
+
+    YR_RULES* ViewYara::loadCachedRules(const fs::path &cachePath, const std::string &hash, std::vector<std::pair<fs::path, std::string>> &includes) {
+        // The hash of the rule sources is stored next to the compiled rules, followed by one "<hash> <path>" entry per included file
+        File dependencyFile(fs::path(cachePath).replace_extension(".deps"), File::Mode::Read);
+        if (!dependencyFile.isValid())
+            return nullptr;
+
+        auto lines = hex::splitString(dependencyFile.readString(), "\n");
+        if (lines.empty() || lines.front() != hash)
+            return nullptr;
+
+        for (auto line = lines.begin() + 1; line != lines.end(); line++) {
+            auto separator = line->find(' ');
+            if (separator == std::string::npos)
+                continue;
+
+            includes.emplace_back(fs::path(line->substr(separator + 1)), line->substr(0, separator));
+        }
+
+        YR_RULES *rules = nullptr;
+
+        // Rules saved by a different YARA version fail to load and simply get compiled again
+        if (yr_rules_load(cachePath.string().c_str(), &rules) != ERROR_SUCCESS)
+            return nullptr;
+
+        return rules;
+    }
+
+    void ViewYara::saveCachedRules(const fs::path &cachePath, const std::string &hash, YR_RULES *rules, const std::vector<std::pair<fs::path, std::string>> &includes) {
+        std::error_code error;
+        fs::create_directories(cachePath.parent_path(), error);
+
+        std::string dependencies = hash + '\n';
+        for (const auto &[path, includeHash] : includes)
+            dependencies += hex::format("{} {}\n", includeHash, path.string());
+
+        File dependencyFile(fs::path(cachePath).replace_extension(".deps"), File::Mode::Create);
+        if (!dependencyFile.isValid())
+            return;
 
-                u64 address = context.currBlock.base + context.currBlock.size;
+        dependencyFile.write(dependencies);
 
-                iterator->last_error = ERROR_SUCCESS;
-                context.currBlock.base = address;
-                context.currBlock.size = ImHexApi::Provider::get()->getActualSize() - address;
-                context.currBlock.context = &context;
-                context.task->update(address);
+        if (yr_rules_save(rules, cachePath.string().c_str()) != ERROR_SUCCESS)
+            log::error("Failed to save compiled YARA rules to {}", cachePath.string());
+    }
+
+    void ViewYara::clearCompiledRules() {
+        std::scoped_lock lock(this->m_compiledRulesMutex);
+
+        for (auto &[path, compiledRules] : this->m_compiledRules)
+            yr_rules_destroy(compiledRules.rules);
+
+        this->m_compiledRules.clear();
+    }
+
+    void ViewYara::highlightMatches() {
+        std::vector<std::pair<Region, u32>> regions;
+        regions.reserve(this->m_matches.size());
 
-                if (context.currBlock.size == 0) return nullptr;
+        // Every rule gets its own color so matches of different rules can be told apart
+        for (const auto &match : this->m_matches) {
+            if (match.wholeDataMatch || match.size <= 0)
+                continue;
 
-                return &context.currBlock;
+            const float hue = float(std::hash<std::string>{}(match.identifier) % 360) / 360.0F;
+            regions.push_back({ Region { u64(match.address), size_t(match.size) }, u32(ImColor::HSV(hue, 0.6F, 0.9F)) });
+        }
+
+        EventManager::post<RequestHighlightRegions>(regions);
+    }
+
+    void ViewYara::applyRules() {
+        EventManager::post<RequestHighlightRegions>(std::vector<std::pair<Region, u32>>());
+
+        this->m_matches.clear();
+        this->m_errorMessage.clear();
+        this->m_matching = true;
+
+        // All rule files get compiled into one set with a namespace per file so their rules can't collide
+        std::vector<RuleFile> ruleFiles;
+        if (this->m_scanAllRules) {
+            for (const auto &[name, path] : this->m_rules)
+                ruleFiles.push_back({ name, path });
+        } else {
+            ruleFiles.push_back({ "", this->m_rules[this->m_selectedRule].second });
+        }
+
+        std::thread([this, ruleFiles = std::move(ruleFiles)] {
+            ON_SCOPE_EXIT { this->m_matching = false; };
+
+            if (!ImHexApi::Provider::isValid()) return;
+
+            auto provider = ImHexApi::Provider::get();
+            const u64 dataSize = provider->getActualSize();
+            auto task = ImHexApi::Tasks::createTask("hex.builtin.view.yara.matching", dataSize);
+
+            auto rules = this->getCompiledRules(ruleFiles);
+            if (rules == nullptr) return;
+
+            // Conditions have to see the whole data at once, so a single scanner walks all of it and only reading the blocks is spread over multiple threads
+            ScanContext context;
+            context.provider        = provider;
+            context.dataSize        = dataSize;
+            context.overlap         = std::max(getLongestStringLength(rules), MinimumBlockOverlap);
+            context.scannedUntil    = 0;
+            context.task            = &task;
+
+            // Backends that can't hand out their data directly usually don't support being read from multiple threads either
+            context.readAheadCount  = provider->getRawSpan(0, 1).has_value() ? std::max(std::thread::hardware_concurrency(), 2U) - 1 : 1;
+
+            YR_SCANNER *scanner = nullptr;
+            if (yr_scanner_create(rules, &scanner) != ERROR_SUCCESS)
+                return;
+            ON_SCOPE_EXIT { yr_scanner_destroy(scanner); };
+
+            YR_MEMORY_BLOCK_ITERATOR iterator;
+            iterator.context = &context;
+            iterator.file_size = [](YR_MEMORY_BLOCK_ITERATOR *iterator) -> u64 {
+                return static_cast<ScanContext*>(iterator->context)->dataSize;
+            };
+            iterator.first = [](YR_MEMORY_BLOCK_ITERATOR *iterator) -> YR_MEMORY_BLOCK* {
+                return setCurrentBlock(iterator, 0);
+            };
+            iterator.next = [](YR_MEMORY_BLOCK_ITERATOR *iterator) -> YR_MEMORY_BLOCK* {
+                return setCurrentBlock(iterator, static_cast<ScanContext*>(iterator->context)->currBlock.base + ScanBlockSize);
             };
 
+            context.currBlock.fetch_data = fetchBlockData;
 
-            yr_rules_scan_mem_blocks(rules, &iterator, 0, [](YR_SCAN_CONTEXT* context, int message, void *data, void *userData) -> int {
+            yr_scanner_set_callback(scanner, [](YR_SCAN_CONTEXT *context, int message, void *data, void *userData) -> int {
                 if (message == CALLBACK_MSG_RULE_MATCHING) {
-                    auto &newMatches = *static_cast<std::vector<YaraMatch>*>(userData);
-                    auto rule  = static_cast<YR_RULE*>(data);
+                    auto &matches = static_cast<ScanContext*>(userData)->matches;
+                    auto rule = static_cast<YR_RULE*>(data);
+
+                    std::string identifier = rule->identifier;
+                    if (rule->ns != nullptr && std::strcmp(rule->ns->name, "default") != 0)
+                        identifier = hex::format("{}:{}", rule->ns->name, rule->identifier);
 
                     YR_STRING *string;
                     YR_MATCH *match;
@@ -272,21 +548,31 @@ namespace hex::plugin::builtin {
                     if (rule->strings != nullptr) {
                         yr_rule_strings_foreach(rule, string) {
                             yr_string_matches_foreach(context, string, match) {
-                                newMatches.push_back({ rule->identifier, string->identifier, match->offset, match->match_length, false });
+                                matches.push_back({ identifier, string->identifier, match->base + match->offset, match->match_length, false });
                             }
                         }
                     } else {
-                        newMatches.push_back({ rule->identifier, "", 0, 0, true });
+                        matches.push_back({ identifier, "", 0, 0, true });
                     }
-
                 }
 
                 return CALLBACK_CONTINUE;
-            }, &newMatches, 0);
+            }, &context);
+
+            yr_scanner_scan_mem_blocks(scanner, &iterator);
+            context.pendingBlocks.clear();
+
+            auto newMatches = std::move(context.matches);
+
+            // Matches inside the overlap of two blocks are found by both of them
+            std::sort(newMatches.begin(), newMatches.end(), [](const auto &left, const auto &right) {
+                return std::tie(left.address, left.identifier, left.variable, left.size, left.wholeDataMatch) < std::tie(right.address, right.identifier, right.variable, right.size, right.wholeDataMatch);
+            });
+            newMatches.erase(std::unique(newMatches.begin(), newMatches.end()), newMatches.end());
 
             std::copy(newMatches.begin(), newMatches.end(), std::back_inserter(this->m_matches));
         }).detach();
 
     }
 
-}
\ No newline at end of file
+}
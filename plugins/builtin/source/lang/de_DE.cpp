@@ -155,6 +155,7 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.hashes.iv", "Startwert" },
                     { "hex.builtin.view.hashes.poly", "Polynomial" },
                     { "hex.builtin.view.hashes.result", "Resultat" },
+                    { "hex.builtin.view.hashes.calculating", "Berechnen..." },
 
                 { "hex.builtin.view.help.name", "Hilfe" },
                     { "hex.builtin.view.help.about.name", "Über ImHex" },
@@ -218,6 +219,11 @@ namespace hex::plugin::builtin {
                         { "hex.builtin.view.hexeditor.search.find", "Suchen" },
                         { "hex.builtin.view.hexeditor.search.find_next", "Nächstes" },
                         { "hex.builtin.view.hexeditor.search.find_prev", "Vorheriges" },
+                        { "hex.builtin.view.hexeditor.search.case_sensitive", "Groß-/Kleinschreibung beachten" },
+                        { "hex.builtin.view.hexeditor.search.encoding", "Kodierung" },
+                        { "hex.builtin.view.hexeditor.search.encoding.custom", "Geladene Kodierungstabelle" },
+                        { "hex.builtin.view.hexeditor.search.searching", "Suchen..." },
+                        { "hex.builtin.view.hexeditor.search.results", "{0} Ergebnisse" },
                     { "hex.builtin.view.hexeditor.menu.file.goto", "Sprung" },
                         { "hex.builtin.view.hexeditor.goto.offset.absolute", "Absolut" },
                         { "hex.builtin.view.hexeditor.goto.offset.current", "Momentan" },
@@ -262,14 +268,22 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.information.block_size.desc", "{0} Blöcke min {1} bytes" },
                     { "hex.builtin.view.information.file_entropy", "Dateientropie" },
                     { "hex.builtin.view.information.highest_entropy", "Höchste Blockentropie" },
+                    { "hex.builtin.view.information.chi_square", "Chi-Quadrat" },
+                    { "hex.builtin.view.information.mean", "Durchschnittlicher Bytewert" },
+                    { "hex.builtin.view.information.printable", "Druckbare Bytes" },
+                    { "hex.builtin.view.information.zero", "Null-Bytes" },
+                    { "hex.builtin.view.information.high_bit", "Bytes mit gesetztem höchstem Bit" },
                     { "hex.builtin.view.information.encrypted", "Diese Daten sind vermutlich verschlüsselt oder komprimiert!" },
                     { "hex.builtin.view.information.magic_db_added", "Magic Datenbank hinzugefügt!" },
+                    { "hex.builtin.view.information.read_cache", "Lese-Cache" },
+                    { "hex.builtin.view.information.read_cache.desc", "{0} Treffer, {1} Fehlschläge, {2} Seiten" },
 
                 { "hex.builtin.view.patches.name", "Patches" },
                     { "hex.builtin.view.patches.offset", "Offset" },
                     { "hex.builtin.view.patches.orig", "Originalwert" },
                     { "hex.builtin.view.patches.patch", "Patchwert"},
                     { "hex.builtin.view.patches.remove", "Patch entfernen" },
+                    { "hex.builtin.view.patches.undo_history", "Rückgängig-Verlauf: {0} Schritte, {1}" },
 
                 { "hex.builtin.view.pattern_editor.name", "Pattern Editor" },
                 { "hex.builtin.view.pattern_editor.accept_pattern", "Pattern akzeptieren" },
@@ -301,11 +315,16 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.strings.copy", "String kopieren" },
                     { "hex.builtin.view.strings.demangle", "Demangle" },
                     { "hex.builtin.view.strings.min_length", "Minimallänge" },
+                    { "hex.builtin.view.strings.encoding", "Kodierung" },
+                    { "hex.builtin.view.strings.encoding.custom", "Kodierungsdatei" },
+                    { "hex.builtin.view.strings.encoding.load", "Kodierungsdatei laden" },
+                    { "hex.builtin.view.strings.encoding.no_file", "Keine Kodierungsdatei geladen" },
                     { "hex.builtin.view.strings.filter", "Filter" },
                     { "hex.builtin.view.strings.extract", "Extrahieren" },
                     { "hex.builtin.view.strings.regex_error", "Ungültiges Regex" },
                     { "hex.builtin.view.strings.results", "{0} Ergebnisse" },
                     { "hex.builtin.view.strings.searching", "Suchen..." },
+                    { "hex.builtin.view.strings.filtering", "Filtern..." },
                     { "hex.builtin.view.strings.offset", "Offset" },
                     { "hex.builtin.view.strings.size", "Grösse" },
                     { "hex.builtin.view.strings.string", "String" },
@@ -317,7 +336,9 @@ namespace hex::plugin::builtin {
                 { "hex.builtin.view.yara.name", "Yara Regeln" },
                     { "hex.builtin.view.yara.header.rules", "Regeln" },
                         { "hex.builtin.view.yara.reload", "Neu laden" },
+                        { "hex.builtin.view.yara.all_rules", "Mit allen Regeln scannen" },
                         { "hex.builtin.view.yara.match", "Regeln anwenden" },
+                        { "hex.builtin.view.yara.highlight", "Treffer hervorheben" },
                         { "hex.builtin.view.yara.matching", "Anwenden..." },
                         { "hex.builtin.view.yara.error", "Yara Kompilerfehler: " },
                     { "hex.builtin.view.yara.header.matches", "Funde" },
@@ -348,6 +369,13 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.store.tab.yara", "Yara Rules" },
                     { "hex.builtin.view.store.loading", "Store inhalt wird geladen..." },
                 { "hex.builtin.view.diff.name", "Diffing" },
+                { "hex.builtin.view.diff.diffing", "Vergleiche..." },
+                { "hex.builtin.view.diff.differences", "{} Unterschiede" },
+                { "hex.builtin.view.diff.previous", "Vorheriger Unterschied" },
+                { "hex.builtin.view.diff.next", "Nächster Unterschied" },
+                { "hex.builtin.view.diff.align", "Einfügungen erkennen" },
+                { "hex.builtin.view.diff.differences_only", "Nur Unterschiede" },
+                { "hex.builtin.view.diff.identical", "... {} identische Bytes ..." },
 
                 { "hex.builtin.view.provider_settings.name", "Provider Einstellungen" },
                     { "hex.builtin.view.provider_settings.load_popup", "Provider öffnen" },
@@ -693,6 +721,7 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.provider.gdb.server", "Server" },
                     { "hex.builtin.provider.gdb.ip", "IP Adresse" },
                     { "hex.builtin.provider.gdb.port", "Port" },
+                    { "hex.builtin.provider.gdb.cache_size", "Cachegröße" },
                 { "hex.builtin.provider.disk", "Datenträger Provider" },
                     { "hex.builtin.provider.disk.selected_disk", "Datenträger" },
                     { "hex.builtin.provider.disk.disk_size", "Datenträgergrösse" },
@@ -157,6 +157,7 @@ namespace hex::plugin::builtin {
                     { "hex.common.reflectOut", "Reflect output" },
                     { "hex.builtin.view.hashes.poly", "Polynomial" },
                     { "hex.builtin.view.hashes.result", "Result" },
+                    { "hex.builtin.view.hashes.calculating", "Calculating..." },
 
                 { "hex.builtin.view.help.name", "Help" },
                     { "hex.builtin.view.help.about.name", "About" },
@@ -220,6 +221,11 @@ namespace hex::plugin::builtin {
                         { "hex.builtin.view.hexeditor.search.find", "Find" },
                         { "hex.builtin.view.hexeditor.search.find_next", "Find next" },
                         { "hex.builtin.view.hexeditor.search.find_prev", "Find previous" },
+                        { "hex.builtin.view.hexeditor.search.case_sensitive", "Case sensitive" },
+                        { "hex.builtin.view.hexeditor.search.encoding", "Encoding" },
+                        { "hex.builtin.view.hexeditor.search.encoding.custom", "Loaded encoding table" },
+                        { "hex.builtin.view.hexeditor.search.searching", "Searching..." },
+                        { "hex.builtin.view.hexeditor.search.results", "{0} results" },
                     { "hex.builtin.view.hexeditor.menu.file.goto", "Goto" },
                         { "hex.builtin.view.hexeditor.goto.offset.absolute", "Absolute" },
                         { "hex.builtin.view.hexeditor.goto.offset.current", "Current" },
@@ -264,14 +270,22 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.information.block_size.desc", "{0} blocks of {1} bytes" },
                     { "hex.builtin.view.information.file_entropy", "File entropy" },
                     { "hex.builtin.view.information.highest_entropy", "Highest entropy block" },
+                    { "hex.builtin.view.information.chi_square", "Chi-square" },
+                    { "hex.builtin.view.information.mean", "Mean byte value" },
+                    { "hex.builtin.view.information.printable", "Printable bytes" },
+                    { "hex.builtin.view.information.zero", "Zero bytes" },
+                    { "hex.builtin.view.information.high_bit", "Bytes with high bit set" },
                     { "hex.builtin.view.information.encrypted", "This data is most likely encrypted or compressed!" },
                     { "hex.builtin.view.information.magic_db_added", "Magic database added!" },
+                    { "hex.builtin.view.information.read_cache", "Read cache" },
+                    { "hex.builtin.view.information.read_cache.desc", "{0} hits, {1} misses, {2} pages" },
 
                 { "hex.builtin.view.patches.name", "Patches" },
                     { "hex.builtin.view.patches.offset", "Offset" },
                     { "hex.builtin.view.patches.orig", "Original value" },
                     { "hex.builtin.view.patches.patch", "Patched value"},
                     { "hex.builtin.view.patches.remove", "Remove patch" },
+                    { "hex.builtin.view.patches.undo_history", "Undo history: {0} steps, {1}" },
 
                 { "hex.builtin.view.pattern_editor.name", "Pattern editor" },
                 { "hex.builtin.view.pattern_editor.accept_pattern", "Accept pattern" },
@@ -303,11 +317,16 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.strings.copy", "Copy string" },
                     { "hex.builtin.view.strings.demangle", "Demangle" },
                     { "hex.builtin.view.strings.min_length", "Minimum length" },
+                    { "hex.builtin.view.strings.encoding", "Encoding" },
+                    { "hex.builtin.view.strings.encoding.custom", "Encoding file" },
+                    { "hex.builtin.view.strings.encoding.load", "Load encoding file" },
+                    { "hex.builtin.view.strings.encoding.no_file", "No encoding file loaded" },
                     { "hex.builtin.view.strings.filter", "Filter" },
                     { "hex.builtin.view.strings.extract", "Extract" },
                     { "hex.builtin.view.strings.regex_error", "Invalid regex" },
                     { "hex.builtin.view.strings.results", "Found {0} occurrences" },
                     { "hex.builtin.view.strings.searching", "Searching..." },
+                    { "hex.builtin.view.strings.filtering", "Filtering..." },
                     { "hex.builtin.view.strings.offset", "Offset" },
                     { "hex.builtin.view.strings.size", "Size" },
                     { "hex.builtin.view.strings.string", "String" },
@@ -319,7 +338,9 @@ namespace hex::plugin::builtin {
                 { "hex.builtin.view.yara.name", "Yara Rules" },
                     { "hex.builtin.view.yara.header.rules", "Rules" },
                         { "hex.builtin.view.yara.reload", "Reload" },
+                        { "hex.builtin.view.yara.all_rules", "Scan with all rules" },
                         { "hex.builtin.view.yara.match", "Match Rules" },
+                        { "hex.builtin.view.yara.highlight", "Highlight matches" },
                         { "hex.builtin.view.yara.matching", "Matching..." },
                         { "hex.builtin.view.yara.error", "Yara Compiler error: " },
                     { "hex.builtin.view.yara.header.matches", "Matches" },
@@ -351,6 +372,13 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.store.tab.yara", "Yara Rules" },
                     { "hex.builtin.view.store.loading", "Loading store content..." },
                 { "hex.builtin.view.diff.name", "Diffing" },
+                { "hex.builtin.view.diff.diffing", "Diffing..." },
+                { "hex.builtin.view.diff.differences", "{} differences" },
+                { "hex.builtin.view.diff.previous", "Previous difference" },
+                { "hex.builtin.view.diff.next", "Next difference" },
+                { "hex.builtin.view.diff.align", "Detect insertions" },
+                { "hex.builtin.view.diff.differences_only", "Differences only" },
+                { "hex.builtin.view.diff.identical", "... {} identical bytes ..." },
 
                 { "hex.builtin.view.provider_settings.name", "Provider Settings" },
                     { "hex.builtin.view.provider_settings.load_popup", "Open Provider" },
@@ -696,6 +724,7 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.provider.gdb.server", "Server" },
                     { "hex.builtin.provider.gdb.ip", "IP Address" },
                     { "hex.builtin.provider.gdb.port", "Port" },
+                    { "hex.builtin.provider.gdb.cache_size", "Cache size" },
                 { "hex.builtin.provider.disk", "Raw Disk Provider" },
                     { "hex.builtin.provider.disk.selected_disk", "Disk" },
                     { "hex.builtin.provider.disk.disk_size", "Disk Size" },
@@ -154,6 +154,7 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.hashes.iv", "Valore Iniziale" },
                     { "hex.builtin.view.hashes.poly", "Polinomio" },
                     { "hex.builtin.view.hashes.result", "Risultato" },
+                    //{ "hex.builtin.view.hashes.calculating", "Calculating..." },
 
                 { "hex.builtin.view.help.name", "Aiuto" },
                     { "hex.builtin.view.help.about.name", "Riguardo ImHex" },
@@ -217,6 +218,11 @@ namespace hex::plugin::builtin {
                         { "hex.builtin.view.hexeditor.search.find", "Cerca" },
                         { "hex.builtin.view.hexeditor.search.find_next", "Cerca il prossimo" },
                         { "hex.builtin.view.hexeditor.search.find_prev", "Cerca il precedente" },
+                        //{ "hex.builtin.view.hexeditor.search.case_sensitive", "Case sensitive" },
+                        //{ "hex.builtin.view.hexeditor.search.encoding", "Encoding" },
+                        //{ "hex.builtin.view.hexeditor.search.encoding.custom", "Loaded encoding table" },
+                        //{ "hex.builtin.view.hexeditor.search.searching", "Searching..." },
+                        //{ "hex.builtin.view.hexeditor.search.results", "{0} results" },
                     { "hex.builtin.view.hexeditor.menu.file.goto", "Vai a" },
                         { "hex.builtin.view.hexeditor.goto.offset.absolute", "Assoluto" },
                         { "hex.builtin.view.hexeditor.goto.offset.current", "Corrente" },
@@ -261,8 +267,15 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.information.block_size.desc", "{0} blocchi di {1} bytes" },
                     { "hex.builtin.view.information.file_entropy", "Entropia dei File" },
                     { "hex.builtin.view.information.highest_entropy", "Highest entropy block" },
+                    //{ "hex.builtin.view.information.chi_square", "Chi-square" },
+                    //{ "hex.builtin.view.information.mean", "Mean byte value" },
+                    //{ "hex.builtin.view.information.printable", "Printable bytes" },
+                    //{ "hex.builtin.view.information.zero", "Zero bytes" },
+                    //{ "hex.builtin.view.information.high_bit", "Bytes with high bit set" },
                     { "hex.builtin.view.information.encrypted", "Questi dati sono probabilmente codificati o compressi!" },
                     //{ "hex.builtin.view.information.magic_db_added", "Magic database added!" },
+                    //{ "hex.builtin.view.information.read_cache", "Read cache" },
+                    //{ "hex.builtin.view.information.read_cache.desc", "{0} hits, {1} misses, {2} pages" },
 
 
                 { "hex.builtin.view.patches.name", "Patches" },
@@ -270,6 +283,7 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.patches.orig", "Valore Originale" },
                     { "hex.builtin.view.patches.patch", "Valore patchato"},
                     { "hex.builtin.view.patches.remove", "Rimuovi patch" },
+                    //{ "hex.builtin.view.patches.undo_history", "Undo history: {0} steps, {1}" },
 
                 { "hex.builtin.view.pattern_editor.name", "Editor dei Pattern" },
                 { "hex.builtin.view.pattern_editor.accept_pattern", "Accetta pattern" },
@@ -301,9 +315,14 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.strings.copy", "Copia stringa" },
                     { "hex.builtin.view.strings.demangle", "Demangle" },
                     { "hex.builtin.view.strings.min_length", "Lunghezza minima" },
+                    //{ "hex.builtin.view.strings.encoding", "Encoding" },
+                    //{ "hex.builtin.view.strings.encoding.custom", "Encoding file" },
+                    //{ "hex.builtin.view.strings.encoding.load", "Load encoding file" },
+                    //{ "hex.builtin.view.strings.encoding.no_file", "No encoding file loaded" },
                     { "hex.builtin.view.strings.filter", "Filtro" },
                     { "hex.builtin.view.strings.extract", "Estrai" },
                     { "hex.builtin.view.strings.searching", "Sto cercando..." },
+                    //{ "hex.builtin.view.strings.filtering", "Filtering..." },
                     { "hex.builtin.view.strings.offset", "Offset" },
                     { "hex.builtin.view.strings.size", "Dimensione" },
                     { "hex.builtin.view.strings.string", "Stringa" },
@@ -315,7 +334,9 @@ namespace hex::plugin::builtin {
                 { "hex.builtin.view.yara.name", "Regole di Yara" },
                     { "hex.builtin.view.yara.header.rules", "Regola" },
                         { "hex.builtin.view.yara.reload", "Ricarica" },
+                        { "hex.builtin.view.yara.all_rules", "Scansiona con tutte le regole" },
                         { "hex.builtin.view.yara.match", "Abbina Regole" },
+                        { "hex.builtin.view.yara.highlight", "Evidenzia le corrispondenze" },
                         { "hex.builtin.view.yara.matching", "Abbinamento..." },
                         { "hex.builtin.view.yara.error", "Errore compilazione Yara: " },
                     { "hex.builtin.view.yara.header.matches", "Abbinamenti" },
@@ -345,6 +366,13 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.store.tab.yara", "Regole di Yara" },
                     { "hex.builtin.view.store.loading", "Caricamento del content store..." },
                 //{ "hex.builtin.view.diff.name", "Diffing" },
+                //{ "hex.builtin.view.diff.diffing", "Diffing..." },
+                //{ "hex.builtin.view.diff.differences", "{} differences" },
+                //{ "hex.builtin.view.diff.previous", "Previous difference" },
+                //{ "hex.builtin.view.diff.next", "Next difference" },
+                //{ "hex.builtin.view.diff.align", "Detect insertions" },
+                //{ "hex.builtin.view.diff.differences_only", "Differences only" },
+                //{ "hex.builtin.view.diff.identical", "... {} identical bytes ..." },
 
                 //{ "hex.builtin.view.provider_settings.name", "Provider Settings" },
                     //{ "hex.builtin.view.provider_settings.load_popup", "Open Provider" },
@@ -690,6 +718,7 @@ namespace hex::plugin::builtin {
                     //{ "hex.builtin.provider.gdb.server", "Server" },
                     //{ "hex.builtin.provider.gdb.ip", "IP Address" },
                     //{ "hex.builtin.provider.gdb.port", "Port" },
+                    //{ "hex.builtin.provider.gdb.cache_size", "Cache size" },
                 //{ "hex.builtin.provider.disk", "Raw Disk Provider" },
                     //{ "hex.builtin.provider.disk.selected_disk", "Disk" },
                     //{ "hex.builtin.provider.disk.disk_size", "Disk Size" },
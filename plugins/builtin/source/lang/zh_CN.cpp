@@ -154,6 +154,7 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.hashes.iv", "初始值" },
                     { "hex.builtin.view.hashes.poly", "多项式" },
                     { "hex.builtin.view.hashes.result", "结果" },
+                    //{ "hex.builtin.view.hashes.calculating", "Calculating..." },
 
                 { "hex.builtin.view.help.name", "帮助" },
                     { "hex.builtin.view.help.about.name", "关于" },
@@ -217,6 +218,11 @@ namespace hex::plugin::builtin {
                         { "hex.builtin.view.hexeditor.search.find", "查找" },
                         { "hex.builtin.view.hexeditor.search.find_next", "查找下一个" },
                         { "hex.builtin.view.hexeditor.search.find_prev", "查找上一个" },
+                        //{ "hex.builtin.view.hexeditor.search.case_sensitive", "Case sensitive" },
+                        //{ "hex.builtin.view.hexeditor.search.encoding", "Encoding" },
+                        //{ "hex.builtin.view.hexeditor.search.encoding.custom", "Loaded encoding table" },
+                        //{ "hex.builtin.view.hexeditor.search.searching", "Searching..." },
+                        //{ "hex.builtin.view.hexeditor.search.results", "{0} results" },
                     { "hex.builtin.view.hexeditor.menu.file.goto", "转到" },
                         { "hex.builtin.view.hexeditor.goto.offset.absolute", "绝对" },
                         { "hex.builtin.view.hexeditor.goto.offset.current", "当前" },
@@ -261,14 +267,22 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.information.block_size.desc", "{0} 块 × {1} 字节" },
                     { "hex.builtin.view.information.file_entropy", "文件熵" },
                     { "hex.builtin.view.information.highest_entropy", "最高熵" },
+                    //{ "hex.builtin.view.information.chi_square", "Chi-square" },
+                    //{ "hex.builtin.view.information.mean", "Mean byte value" },
+                    //{ "hex.builtin.view.information.printable", "Printable bytes" },
+                    //{ "hex.builtin.view.information.zero", "Zero bytes" },
+                    //{ "hex.builtin.view.information.high_bit", "Bytes with high bit set" },
                     { "hex.builtin.view.information.encrypted", "此数据似乎经过了加密或压缩！" },
                     { "hex.builtin.view.information.magic_db_added", "魔术数据库已添加！" },
+                    //{ "hex.builtin.view.information.read_cache", "Read cache" },
+                    //{ "hex.builtin.view.information.read_cache.desc", "{0} hits, {1} misses, {2} pages" },
 
                 { "hex.builtin.view.patches.name", "补丁" },
                     { "hex.builtin.view.patches.offset", "偏移" },
                     { "hex.builtin.view.patches.orig", "原始值" },
                     { "hex.builtin.view.patches.patch", "修改值"},
                     { "hex.builtin.view.patches.remove", "移除补丁" },
+                    //{ "hex.builtin.view.patches.undo_history", "Undo history: {0} steps, {1}" },
 
                 { "hex.builtin.view.pattern_editor.name", "模式编辑器" },
                 { "hex.builtin.view.pattern_editor.accept_pattern", "接受模式" },
@@ -300,9 +314,14 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.strings.copy", "复制字符串" },
                     { "hex.builtin.view.strings.demangle", "还原" },
                     { "hex.builtin.view.strings.min_length", "最小长度" },
+                    //{ "hex.builtin.view.strings.encoding", "Encoding" },
+                    //{ "hex.builtin.view.strings.encoding.custom", "Encoding file" },
+                    //{ "hex.builtin.view.strings.encoding.load", "Load encoding file" },
+                    //{ "hex.builtin.view.strings.encoding.no_file", "No encoding file loaded" },
                     { "hex.builtin.view.strings.filter", "过滤" },
                     { "hex.builtin.view.strings.extract", "提取" },
                     { "hex.builtin.view.strings.searching", "搜索中..." },
+                    //{ "hex.builtin.view.strings.filtering", "Filtering..." },
                     { "hex.builtin.view.strings.offset", "偏移" },
                     { "hex.builtin.view.strings.size", "大小" },
                     { "hex.builtin.view.strings.string", "字符串" },
@@ -314,7 +333,9 @@ namespace hex::plugin::builtin {
                 { "hex.builtin.view.yara.name", "Yara规则" },
                     { "hex.builtin.view.yara.header.rules", "规则" },
                         { "hex.builtin.view.yara.reload", "重新加载" },
+                        { "hex.builtin.view.yara.all_rules", "使用所有规则扫描" },
                         { "hex.builtin.view.yara.match", "匹配规则" },
+                        { "hex.builtin.view.yara.highlight", "高亮匹配项" },
                         { "hex.builtin.view.yara.matching", "匹配中..." },
                         { "hex.builtin.view.yara.error", "Yara编译器错误: " },
                     { "hex.builtin.view.yara.header.matches", "匹配" },
@@ -345,6 +366,13 @@ namespace hex::plugin::builtin {
                     { "hex.builtin.view.store.tab.yara", "Yara规则" },
                 { "hex.builtin.view.store.loading", "正在加载仓库内容..." },
                 { "hex.builtin.view.diff.name", "差异" },
+                { "hex.builtin.view.diff.diffing", "差异比较中..." },
+                { "hex.builtin.view.diff.differences", "{} 处差异" },
+                { "hex.builtin.view.diff.previous", "上一处差异" },
+                { "hex.builtin.view.diff.next", "下一处差异" },
+                { "hex.builtin.view.diff.align", "检测插入" },
+                { "hex.builtin.view.diff.differences_only", "仅显示差异" },
+                { "hex.builtin.view.diff.identical", "... {} 个相同字节 ..." },
 
                 //{ "hex.builtin.view.provider_settings.name", "Provider Settings" },
                     //{ "hex.builtin.view.provider_settings.load_popup", "Open Provider" },
@@ -691,6 +719,7 @@ namespace hex::plugin::builtin {
                     //{ "hex.builtin.provider.gdb.server", "Server" },
                     //{ "hex.builtin.provider.gdb.ip", "IP Address" },
                     //{ "hex.builtin.provider.gdb.port", "Port" },
+                    //{ "hex.builtin.provider.gdb.cache_size", "Cache size" },
                 //{ "hex.builtin.provider.disk", "Raw Disk Provider" },
                     //{ "hex.builtin.provider.disk.selected_disk", "Disk" },
                     //{ "hex.builtin.provider.disk.disk_size", "Disk Size" },
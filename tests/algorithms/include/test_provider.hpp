@@ -44,6 +44,12 @@ namespace hex::test {
             std::memcpy(m_data->data() + offset, buffer, size);
         }
 
+        [[nodiscard]] std::optional<std::span<const u8>> getRawSpan(u64 offset, size_t size) const override {
+            if (offset + size > this->m_data->size()) return std::nullopt;
+
+            return std::span(this->m_data->data() + offset, size);
+        }
+
         size_t getActualSize() const override {
             return this->m_data->size();
         }
@@ -0,0 +1,150 @@
+#include <hex/helpers/byte_analysis.hpp>
+#include "test_provider.hpp"
+#include "tests.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+TEST_SEQUENCE("ByteAnalysisStatistics") {
+    hex::ByteHistogram zeros = { 0 };
+    zeros[0x00] = 1000;
+
+    const auto zeroStatistics = hex::ByteStatistics::fromHistogram(zeros);
+    TEST_ASSERT(zeroStatistics.size == 1000);
+    TEST_ASSERT(zeroStatistics.entropy == 0);
+    TEST_ASSERT(zeroStatistics.mean == 0);
+    TEST_ASSERT(zeroStatistics.zeroRatio == 1);
+    TEST_ASSERT(zeroStatistics.chiSquare == 1000.0 * 255);
+
+    hex::ByteHistogram uniform;
+    uniform.fill(4);
+
+    const auto uniformStatistics = hex::ByteStatistics::fromHistogram(uniform);
+    TEST_ASSERT(std::abs(uniformStatistics.entropy - 1) < 1E-9, "entropy was {}", uniformStatistics.entropy);
+    TEST_ASSERT(uniformStatistics.chiSquare == 0);
+    TEST_ASSERT(uniformStatistics.mean == 127.5);
+    TEST_ASSERT(uniformStatistics.printableRatio == 95.0 / 256);
+    TEST_ASSERT(uniformStatistics.highBitRatio == 0.5);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("ByteAnalysisBlocks") {
+    std::mt19937 random(0x1337);
+    std::vector<u8> data(0x80'0123);
+    for (auto &byte : data)
+        byte = (random() % 3) == 0 ? 0x00 : random();
+
+    // Long runs of the same value go through the banked counters
+    std::fill(data.begin() + 0x1000, data.begin() + 0x20'0000, 0xAA);
+
+    hex::test::TestProvider provider(&data);
+
+    const size_t blockSize = 0x1'0001;
+    const auto result = hex::ByteAnalyzer::analyze(&provider, 0, data.size(), blockSize, { }, 4);
+
+    TEST_ASSERT(result->blockHistograms.size() == (data.size() + blockSize - 1) / blockSize);
+
+    hex::ByteHistogram total = { 0 };
+    for (size_t block = 0; block < result->blockHistograms.size(); block++) {
+        hex::ByteHistogram expected = { 0 };
+        for (size_t i = block * blockSize; i < std::min(data.size(), (block + 1) * blockSize); i++)
+            expected[data[i]]++;
+
+        TEST_ASSERT(result->blockHistograms[block] == expected, "in block {}", block);
+        TEST_ASSERT(result->blockStatistics[block].size == std::min(blockSize, data.size() - block * blockSize), "in block {}", block);
+
+        for (u16 value = 0; value < 256; value++)
+            total[value] += expected[value];
+    }
+
+    TEST_ASSERT(result->histogram == total);
+    TEST_ASSERT(result->statistics.size == data.size());
+
+    // Results are reused until the data changes
+    TEST_ASSERT(hex::ByteAnalyzer::analyze(&provider, 0, data.size(), blockSize) == result);
+
+    u8 byte = 0x42;
+    provider.write(0x00, &byte, sizeof(byte));
+    TEST_ASSERT(hex::ByteAnalyzer::getCachedResult(&provider, 0, data.size(), blockSize) == nullptr);
+
+    const auto count = std::count(data.begin(), data.begin() + blockSize, 0x42);
+    TEST_ASSERT(hex::ByteAnalyzer::analyze(&provider, 0, data.size(), blockSize)->blockHistograms[0][0x42] == count);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("ByteAnalysisUpdate") {
+    std::mt19937 random(0x1337);
+    std::vector<u8> data(0x10'0000);
+    for (auto &byte : data)
+        byte = random();
+
+    hex::test::TestProvider provider(&data);
+
+    auto analyzeCopy = [&](const std::vector<u8> &expectedData) {
+        auto copy = expectedData;
+        hex::test::TestProvider copyProvider(&copy);
+
+        return hex::ByteAnalyzer::analyze(&copyProvider, 0, copy.size(), 0x1000);
+    };
+
+    auto matches = [](const auto &left, const auto &right) {
+        return left->histogram == right->histogram && left->blockHistograms == right->blockHistograms;
+    };
+
+    const auto original = hex::ByteAnalyzer::analyze(&provider, 0, data.size(), 0x1000);
+
+    // Patch crossing a block border
+    std::vector<u8> patch(0x20, 0x00);
+    provider.addPatch(0x1FF0, patch.data(), patch.size(), true);
+
+    auto expectedData = data;
+    std::fill(expectedData.begin() + 0x1FF0, expectedData.begin() + 0x2010, 0x00);
+
+    const auto patched = hex::ByteAnalyzer::update(&provider, original);
+    TEST_ASSERT(patched->revision == provider.getRevision());
+    TEST_ASSERT(matches(patched, analyzeCopy(expectedData)));
+    TEST_ASSERT(hex::ByteAnalyzer::update(&provider, patched) == patched);
+
+    // Same place, different contents
+    std::fill(patch.begin(), patch.end(), 0xFF);
+    provider.addPatch(0x1FF0, patch.data(), patch.size(), true);
+    std::fill(expectedData.begin() + 0x1FF0, expectedData.begin() + 0x2010, 0xFF);
+    TEST_ASSERT(matches(hex::ByteAnalyzer::update(&provider, patched), analyzeCopy(expectedData)));
+
+    provider.undo();
+
+    // Undoing the patch has to restore the blocks it was in
+    provider.undo();
+    TEST_ASSERT(matches(hex::ByteAnalyzer::update(&provider, patched), original));
+
+    auto overlay = provider.newOverlay();
+    overlay->setAddress(0x8000);
+    overlay->setData({ 0xAA, 0xBB });
+
+    expectedData = data;
+    expectedData[0x8000] = 0xAA;
+    expectedData[0x8001] = 0xBB;
+    const auto overlaid = hex::ByteAnalyzer::update(&provider, original);
+    TEST_ASSERT(matches(overlaid, analyzeCopy(expectedData)));
+
+    // Writing to an overlay that already exists has to invalidate results as well
+    overlay->setData({ 0xCC, 0xDD });
+    expectedData[0x8000] = 0xCC;
+    expectedData[0x8001] = 0xDD;
+    TEST_ASSERT(hex::ByteAnalyzer::getCachedResult(&provider, 0, data.size(), 0x1000) == nullptr);
+    TEST_ASSERT(matches(hex::ByteAnalyzer::update(&provider, overlaid), analyzeCopy(expectedData)));
+
+    provider.deleteOverlay(overlay);
+
+    // Writing to the data directly doesn't leave a trace to follow, everything is analyzed again
+    u8 byte = 0x42;
+    provider.write(0x5000, &byte, sizeof(byte));
+    expectedData = data;
+    TEST_ASSERT(matches(hex::ByteAnalyzer::update(&provider, original), analyzeCopy(expectedData)));
+
+    TEST_SUCCESS();
+};
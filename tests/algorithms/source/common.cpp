@@ -4,6 +4,8 @@
 
 #include <vector>
 #include <algorithm>
+#include <numeric>
+#include <cstring>
 
 TEST_SEQUENCE("TestSucceeding") {
     TEST_SUCCESS();
@@ -83,3 +85,112 @@ TEST_SEQUENCE("TestProvider_write") {
 
     TEST_SUCCESS();
 };
+
+TEST_SEQUENCE("TestProvider_cache") {
+    std::vector<u8> data(0x3000);
+    std::iota(data.begin(), data.end(), 0x00);
+    hex::test::TestProvider provider(&data);
+    hex::prv::Provider* provider2 = &provider;
+
+    const auto &cache = provider2->getReadCache();
+
+    u8 buff[0x20] = { 0 };
+
+    provider2->read(0x10, buff, 0x10);
+    TEST_ASSERT(cache.getMissCount() == 1);
+    TEST_ASSERT(buff[0] == 0x10);
+
+    provider2->read(0x20, buff, 0x10);
+    TEST_ASSERT(cache.getMissCount() == 1);
+    TEST_ASSERT(cache.getHitCount() == 1);
+
+    // Reads spanning two pages
+    provider2->read(0xFF0, buff, 0x20);
+    TEST_ASSERT(cache.getMissCount() == 2);
+    TEST_ASSERT(buff[0x0F] == 0xFF && buff[0x10] == 0x00);
+
+    // Writes have to invalidate the cached page
+    u8 value = 0xAA;
+    provider2->write(0x30, &value, sizeof(u8));
+    provider2->read(0x30, buff, 1);
+    TEST_ASSERT(buff[0] == 0xAA);
+    TEST_ASSERT(cache.getMissCount() == 3);
+
+    // The last page only gets partially filled
+    provider2->read(0x2FFF, buff, 1);
+    TEST_ASSERT(buff[0] == 0xFF);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("ReadCache_readAhead") {
+    std::vector<u8> data(0x10000);
+    std::iota(data.begin(), data.end(), 0x00);
+
+    std::vector<std::pair<u64, size_t>> requests;
+    auto readFunction = [&](u64 offset, void *buffer, size_t size) {
+        requests.emplace_back(offset, size);
+        std::memcpy(buffer, data.data() + offset, std::min<u64>(size, data.size() - offset));
+    };
+
+    hex::prv::ReadCache cache(0x100, 8);
+    cache.setReadAhead(3);
+
+    u8 buff[0x10] = { 0 };
+
+    // Random access only ever fetches single pages
+    cache.read(0x800, buff, 0x10, readFunction);
+    cache.read(0x200, buff, 0x10, readFunction);
+    TEST_ASSERT(requests.size() == 2);
+    TEST_ASSERT(requests[1].first == 0x200 && requests[1].second == 0x100);
+
+    // The second sequential miss fetches the pages after it as well
+    cache.read(0x300, buff, 0x10, readFunction);
+    TEST_ASSERT(requests.size() == 3);
+    TEST_ASSERT(requests[2].first == 0x300 && requests[2].second == 0x400);
+    TEST_ASSERT(buff[0] == 0x00);
+
+    for (u64 offset = 0x300; offset < 0x700; offset += 0x10)
+        cache.read(offset, buff, 0x10, readFunction);
+    TEST_ASSERT(requests.size() == 3);
+    TEST_ASSERT(buff[0x0F] == 0xFF);
+
+    // Reading on continues the streak
+    cache.read(0x700, buff, 0x10, readFunction);
+    TEST_ASSERT(requests.size() == 4);
+    TEST_ASSERT(requests[3].first == 0x700 && requests[3].second == 0x400);
+    TEST_ASSERT(cache.getMissCount() == 4);
+
+    cache.read(0x900, buff, 0x10, readFunction);
+    TEST_ASSERT(requests.size() == 4);
+    TEST_ASSERT(buff[0] == 0x00 && buff[1] == 0x01);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("TestProvider_chunks") {
+    std::vector<u8> data(0x3000);
+    std::iota(data.begin(), data.end(), 0x00);
+    hex::test::TestProvider provider(&data);
+
+    u8 value = 0xAA;
+    provider.addPatch(0x1800, &value, sizeof(u8));
+
+    std::vector<std::pair<u64, std::span<const u8>>> chunks;
+    provider.readChunks(0x0000, 0x10000, [&](u64 address, std::span<const u8> chunk) {
+        chunks.emplace_back(address, chunk);
+    }, 0x1000);
+
+    TEST_ASSERT(chunks.size() == 3);
+    TEST_ASSERT(chunks[2].first == 0x2000 && chunks[2].second.size() == 0x1000);
+
+    // Unmodified chunks point straight into the data, modified ones get read with the patches applied
+    TEST_ASSERT(chunks[0].second.data() == data.data());
+    TEST_ASSERT(chunks[1].second.data() != data.data() + 0x1000);
+    TEST_ASSERT(chunks[2].second.data() == data.data() + 0x2000);
+
+    TEST_ASSERT(provider.isModified(0x17F0, 0x11));
+    TEST_ASSERT(!provider.isModified(0x17F0, 0x10));
+
+    TEST_SUCCESS();
+};
@@ -4,6 +4,7 @@
 #include "tests.hpp"
 
 #include <random>
+#include <stop_token>
 #include <vector>
 #include <array>
 #include <algorithm>
@@ -400,3 +401,72 @@ TEST_SEQUENCE("sha512") {
 
     TEST_SUCCESS();
 };
+
+TEST_SEQUENCE("HashPipeline") {
+    std::mt19937 random(0x1337);
+    std::vector<u8> data(hex::crypt::HashBlockSize * 3 + 0x123);
+    for (auto &byte : data)
+        byte = random();
+
+    hex::test::TestProvider provider(&data);
+    hex::prv::Provider *providerPtr = &provider;
+
+    // Blocks containing patches get read instead of being handed out directly
+    std::vector<u8> patch(0x100, 0xAA);
+    provider.addPatch(hex::crypt::HashBlockSize - 0x80, patch.data(), patch.size(), true);
+
+    const hex::crypt::CrcParameters c8  = { 0x07, 0x00, 0x00, false, false };
+    const hex::crypt::CrcParameters c16 = { 0x8005, 0x0000, 0x0000, false, false };
+    const hex::crypt::CrcParameters c32 = { 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true, true };
+
+    const std::vector<hex::crypt::HashRequest> requests = {
+        { hex::crypt::HashFunction::CRC8, c8 },
+        { hex::crypt::HashFunction::CRC16, c16 },
+        { hex::crypt::HashFunction::CRC32, c32 },
+        { hex::crypt::HashFunction::MD5 },
+        { hex::crypt::HashFunction::SHA1 },
+        { hex::crypt::HashFunction::SHA224 },
+        { hex::crypt::HashFunction::SHA256 },
+        { hex::crypt::HashFunction::SHA384 },
+        { hex::crypt::HashFunction::SHA512 },
+    };
+
+    const u64 offset = 0x10;
+    const size_t size = data.size() - 0x20;
+
+    u64 lastProgress = 0;
+    const auto digests = hex::crypt::hash(&provider, offset, size, requests, [&](u64 processedSize) { lastProgress = processedSize; });
+    TEST_ASSERT(digests.has_value());
+    TEST_ASSERT(digests->size() == requests.size());
+    TEST_ASSERT(lastProgress == size, "progress: {:#x}", lastProgress);
+
+    auto toVector = [](const auto &digest) { return std::vector<u8>(digest.begin(), digest.end()); };
+    auto crcToVector = [](u64 crc, int bits) {
+        std::vector<u8> result;
+        for (int shift = bits - 8; shift >= 0; shift -= 8)
+            result.push_back(crc >> shift);
+        return result;
+    };
+
+    const std::vector<std::vector<u8>> expected = {
+        crcToVector(hex::crypt::crc8(providerPtr, offset, size, c8.polynomial, c8.init, c8.xorout, c8.reflectIn, c8.reflectOut), 8),
+        crcToVector(hex::crypt::crc16(providerPtr, offset, size, c16.polynomial, c16.init, c16.xorout, c16.reflectIn, c16.reflectOut), 16),
+        crcToVector(hex::crypt::crc32(providerPtr, offset, size, c32.polynomial, c32.init, c32.xorout, c32.reflectIn, c32.reflectOut), 32),
+        toVector(hex::crypt::md5(providerPtr, offset, size)),
+        toVector(hex::crypt::sha1(providerPtr, offset, size)),
+        toVector(hex::crypt::sha224(providerPtr, offset, size)),
+        toVector(hex::crypt::sha256(providerPtr, offset, size)),
+        toVector(hex::crypt::sha384(providerPtr, offset, size)),
+        toVector(hex::crypt::sha512(providerPtr, offset, size)),
+    };
+
+    for (size_t i = 0; i < expected.size(); i++)
+        TEST_ASSERT((*digests)[i] == expected[i], "request {} got: {} expected: {}", i, hex::crypt::encode16((*digests)[i]), hex::crypt::encode16(expected[i]));
+
+    // Stopped calculations don't return a partial result
+    std::stop_source stopSource;
+    stopSource.request_stop();
+    TEST_ASSERT(!hex::crypt::hash(&provider, offset, size, requests, { }, stopSource.get_token()).has_value());
+
+    TEST_SUCCESS();
+};
@@ -0,0 +1,158 @@
+#include <hex/helpers/binary_diff.hpp>
+#include "test_provider.hpp"
+#include "tests.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+    using hex::BinaryDiff;
+
+    // Checks that the edits cover both inputs in order, that equal ranges really are equal and that A turns into B
+    bool isValidEditScript(const std::vector<BinaryDiff::Edit> &edits, const std::vector<u8> &a, const std::vector<u8> &b) {
+        std::vector<u8> result;
+        u64 offsetA = 0, offsetB = 0;
+
+        for (const auto &edit : edits) {
+            if (edit.offsetA != offsetA || edit.offsetB != offsetB)
+                return false;
+
+            switch (edit.type) {
+                case BinaryDiff::EditType::Equal:
+                    if (edit.sizeA != edit.sizeB || !std::equal(a.begin() + edit.offsetA, a.begin() + edit.offsetA + edit.sizeA, b.begin() + edit.offsetB))
+                        return false;
+                    result.insert(result.end(), a.begin() + edit.offsetA, a.begin() + edit.offsetA + edit.sizeA);
+                    break;
+                case BinaryDiff::EditType::Insert:
+                    if (edit.sizeA != 0 || edit.sizeB == 0)
+                        return false;
+                    [[fallthrough]];
+                case BinaryDiff::EditType::Replace:
+                    result.insert(result.end(), b.begin() + edit.offsetB, b.begin() + edit.offsetB + edit.sizeB);
+                    break;
+                case BinaryDiff::EditType::Delete:
+                    if (edit.sizeA == 0 || edit.sizeB != 0)
+                        return false;
+                    break;
+            }
+
+            offsetA += edit.sizeA;
+            offsetB += edit.sizeB;
+        }
+
+        return offsetA == a.size() && offsetB == b.size() && result == b;
+    }
+
+    u64 getChangedSize(const std::vector<BinaryDiff::Edit> &edits) {
+        u64 size = 0;
+        for (const auto &edit : edits) {
+            if (edit.type != BinaryDiff::EditType::Equal)
+                size += std::max(edit.sizeA, edit.sizeB);
+        }
+
+        return size;
+    }
+
+}
+
+TEST_SEQUENCE("BinaryDiffSmall") {
+    const std::vector<u8> a = { 'A', 'B', 'C', 'A', 'B', 'B', 'A' };
+    const std::vector<u8> b = { 'C', 'B', 'A', 'B', 'A', 'C' };
+
+    auto edits = BinaryDiff::diff(a, b);
+    TEST_ASSERT(isValidEditScript(edits, a, b));
+
+    // The shortest edit script of Myers' paper example deletes and inserts five bytes in total
+    u64 changedSize = 0;
+    for (const auto &edit : edits) {
+        if (edit.type != BinaryDiff::EditType::Equal)
+            changedSize += edit.sizeA + edit.sizeB;
+    }
+    TEST_ASSERT(changedSize == 5, "{}", changedSize);
+
+    TEST_ASSERT(BinaryDiff::diff(a, a) == std::vector<BinaryDiff::Edit>({ { BinaryDiff::EditType::Equal, 0, a.size(), 0, a.size() } }));
+    TEST_ASSERT(BinaryDiff::diff({ }, b) == std::vector<BinaryDiff::Edit>({ { BinaryDiff::EditType::Insert, 0, 0, 0, b.size() } }));
+    TEST_ASSERT(BinaryDiff::diff(a, { }) == std::vector<BinaryDiff::Edit>({ { BinaryDiff::EditType::Delete, 0, a.size(), 0, 0 } }));
+    TEST_ASSERT(BinaryDiff::diff(std::span<const u8>(), std::span<const u8>()).empty());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("BinaryDiffAlignment") {
+    std::mt19937 random(0x1337);
+
+    std::vector<u8> a(0x20'0000);
+    for (auto &byte : a)
+        byte = random();
+
+    // Insertions and deletions shift everything after them, only the changed bytes should be reported
+    std::vector<u8> b = a;
+    b.erase(b.begin() + 0x18'0000, b.begin() + 0x18'2000);
+    for (u32 i = 0; i < 0x10; i++)
+        b[0x12'0000 + i * 3] ^= 0xFF;
+    b.insert(b.begin() + 0xC0'000, 0x800, 0xAA);
+    b.insert(b.begin() + 0x1234, { 1, 2, 3, 4, 5 });
+
+    hex::test::TestProvider providerA(&a), providerB(&b);
+
+    auto edits = BinaryDiff::diff(&providerA, &providerB);
+    TEST_ASSERT(edits.has_value());
+    TEST_ASSERT(isValidEditScript(*edits, a, b));
+
+    const auto changedSize = getChangedSize(*edits);
+    TEST_ASSERT(changedSize <= 0x2000 + 0x800 + 0x30 + 5, "{:#x} bytes changed", changedSize);
+
+    // Completely different data is replaced as a whole
+    std::vector<u8> c(a.size());
+    for (auto &byte : c)
+        byte = random();
+
+    edits = BinaryDiff::diff(a, c);
+    TEST_ASSERT(isValidEditScript(*edits, a, c));
+
+    std::stop_source stopSource;
+    stopSource.request_stop();
+    TEST_ASSERT(!BinaryDiff::diff(&providerA, &providerB, { }, stopSource.get_token()).has_value());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("BinaryDiffCompare") {
+    std::mt19937 random(0x1337);
+
+    std::vector<u8> a(BinaryDiff::ReadBlockSize * 3);
+    for (auto &byte : a)
+        byte = random();
+
+    std::vector<u8> b = a;
+    b[5] ^= 0xFF;
+    for (u32 i = 100; i < 104; i++)
+        b[i] ^= 0xFF;
+
+    // Differences in different blocks still get merged into one replacement if they're close enough
+    b[BinaryDiff::ReadBlockSize - 1] ^= 0xFF;
+    b[BinaryDiff::ReadBlockSize + 8] ^= 0xFF;
+    b.resize(b.size() + 0x100, 0x00);
+
+    hex::test::TestProvider providerA(&a), providerB(&b);
+
+    auto edits = BinaryDiff::compare(&providerA, &providerB);
+    TEST_ASSERT(edits.has_value());
+    TEST_ASSERT(isValidEditScript(*edits, a, b));
+
+    std::vector<BinaryDiff::Edit> differences;
+    std::copy_if(edits->begin(), edits->end(), std::back_inserter(differences), [](const auto &edit) { return edit.type != BinaryDiff::EditType::Equal; });
+
+    TEST_ASSERT(differences.size() == 4, "{}", differences.size());
+    TEST_ASSERT(differences[0] == BinaryDiff::Edit({ BinaryDiff::EditType::Replace, 5, 1, 5, 1 }));
+    TEST_ASSERT(differences[1] == BinaryDiff::Edit({ BinaryDiff::EditType::Replace, 100, 4, 100, 4 }));
+    TEST_ASSERT(differences[2] == BinaryDiff::Edit({ BinaryDiff::EditType::Replace, BinaryDiff::ReadBlockSize - 1, 10, BinaryDiff::ReadBlockSize - 1, 10 }));
+    TEST_ASSERT(differences[3] == BinaryDiff::Edit({ BinaryDiff::EditType::Insert, a.size(), 0, a.size(), 0x100 }));
+
+    TEST_ASSERT(BinaryDiff::compare(b, a).back() == BinaryDiff::Edit({ BinaryDiff::EditType::Delete, a.size(), 0x100, a.size(), 0 }));
+    TEST_ASSERT(BinaryDiff::compare(a, a) == std::vector<BinaryDiff::Edit>({ { BinaryDiff::EditType::Equal, 0, a.size(), 0, a.size() } }));
+
+    TEST_SUCCESS();
+};
@@ -0,0 +1,60 @@
+#include <hex/helpers/disassembly_index.hpp>
+#include "test_provider.hpp"
+#include "tests.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+    // Variable length encoding where the low three bits of the first byte hold the instruction size minus one
+    // and zero bytes don't decode at all
+    hex::DisassemblyIndex::DecodeFunction createDecoder() {
+        return [](u64 address, std::span<const u8> code) -> size_t {
+            if (code[0] == 0x00)
+                return 0;
+
+            const size_t size = (code[0] & 0x07) + 1;
+            return size <= code.size() ? size : 0;
+        };
+    }
+
+}
+
+TEST_SEQUENCE("DisassemblyIndex") {
+    std::mt19937 random(0x1337);
+
+    std::vector<u8> code(hex::DisassemblyIndex::ChunkSize * 5 + 0x123);
+    for (auto &byte : code)
+        byte = random() % 0x20;
+
+    // Naive sequential decoding to compare against
+    std::vector<hex::DisassemblyIndex::Instruction> expected;
+    auto decode = createDecoder();
+    for (u64 offset = 0; offset < code.size();) {
+        size_t size = decode(offset, std::span(code).subspan(offset));
+        if (size == 0)
+            size = 1;
+
+        expected.push_back({ offset, size });
+        offset += size;
+    }
+
+    for (u32 threadCount : { 1, 4 }) {
+        hex::test::TestProvider provider(&code);
+
+        auto index = hex::DisassemblyIndex::build(&provider, 0, code.size(), 0x1000, createDecoder, { }, threadCount);
+        TEST_ASSERT(index.size() == expected.size(), "{} instead of {} instructions with {} threads", index.size(), expected.size(), threadCount);
+
+        for (size_t i = 0; i < expected.size(); i++) {
+            const auto instruction = index.getInstruction(i);
+            TEST_ASSERT(instruction.offset == expected[i].offset && instruction.size == expected[i].size, "instruction {} at {:#x} with {} threads", i, instruction.offset, threadCount);
+        }
+
+        TEST_ASSERT(index.getInstruction(index.size()).size == 0);
+    }
+
+    TEST_ASSERT(hex::DisassemblyIndex::build(std::span<const u8>(), 0, createDecoder).empty());
+
+    TEST_SUCCESS();
+};
@@ -0,0 +1,153 @@
+#include <hex/helpers/patches.hpp>
+#include "test_provider.hpp"
+#include "tests.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <numeric>
+
+TEST_SEQUENCE("PatchesMerge") {
+    hex::Patches patches;
+
+    const std::vector<u8> data = { 0x11, 0x22, 0x33, 0x44 };
+
+    patches.add(0x10, data.data(), 2);
+    patches.add(0x20, data.data(), 2);
+    TEST_ASSERT(patches.getExtentCount() == 2);
+    TEST_ASSERT(patches.size() == 4);
+
+    // Adjacent writes get appended to the existing extent
+    patches.add(0x12, data.data() + 2, 2);
+    TEST_ASSERT(patches.getExtentCount() == 2);
+    TEST_ASSERT(patches.size() == 6);
+
+    // Bridging the gap merges everything into a single extent
+    std::vector<u8> bridge(0x0C, 0xAA);
+    patches.add(0x14, bridge.data(), bridge.size());
+    TEST_ASSERT(patches.getExtentCount() == 1);
+    TEST_ASSERT(patches.size() == 0x12);
+
+    // Writes starting before an extent take precedence over the old data
+    patches.add(0x0F, data.data(), 3);
+    TEST_ASSERT(patches.getExtentCount() == 1);
+    TEST_ASSERT(patches.size() == 0x13);
+    TEST_ASSERT(patches.get(0x0F) == 0x11);
+    TEST_ASSERT(patches.get(0x11) == 0x33);
+    TEST_ASSERT(patches.get(0x12) == 0x33);
+    TEST_ASSERT(patches.get(0x21) == 0x22);
+    TEST_ASSERT(!patches.get(0x22).has_value());
+    TEST_ASSERT(!patches.contains(0x0E));
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("PatchesRemove") {
+    hex::Patches patches;
+
+    std::vector<u8> data(0x10);
+    std::iota(data.begin(), data.end(), 0x00);
+    patches.add(0x100, data.data(), data.size());
+
+    patches.remove(0x104, 4);
+    TEST_ASSERT(patches.getExtentCount() == 2);
+    TEST_ASSERT(patches.size() == 0x0C);
+    TEST_ASSERT(patches.contains(0x103));
+    TEST_ASSERT(!patches.contains(0x104));
+    TEST_ASSERT(!patches.contains(0x107));
+    TEST_ASSERT(patches.get(0x108) == 0x08);
+
+    patches.remove(0x100);
+    TEST_ASSERT(patches.size() == 0x0B);
+    TEST_ASSERT(patches.begin()->first == 0x101);
+
+    patches.remove(0x000, 0x1000);
+    TEST_ASSERT(patches.empty());
+    TEST_ASSERT(patches.getExtentCount() == 0);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("PatchesShift") {
+    hex::Patches patches;
+
+    const std::vector<u8> data = { 0x11, 0x22, 0x33, 0x44 };
+    patches.add(0x10, data.data(), data.size());
+    patches.add(0x20, data.data(), data.size());
+
+    patches.shift(0x12, 0x100);
+    TEST_ASSERT(patches.size() == 8);
+    TEST_ASSERT(patches.get(0x11) == 0x22);
+    TEST_ASSERT(!patches.contains(0x12));
+    TEST_ASSERT(patches.get(0x112) == 0x33);
+    TEST_ASSERT(patches.get(0x113) == 0x44);
+    TEST_ASSERT(patches.get(0x120) == 0x11);
+    TEST_ASSERT(!patches.contains(0x20));
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("PatchesApply") {
+    hex::Patches patches;
+    std::vector<u8> patchData(0x20, 0xAA);
+    patches.add(0x10, patchData.data(), patchData.size());
+    patches.add(0x80, 0xBB);
+
+    std::vector<u8> buffer(0x100, 0x00);
+    patches.apply(0x18, buffer.data(), 0x70);
+    TEST_ASSERT(std::count(buffer.begin(), buffer.begin() + 0x18, 0xAA) == 0x18);
+    TEST_ASSERT(buffer[0x18] == 0x00);
+    TEST_ASSERT(buffer[0x80 - 0x18] == 0xBB);
+
+    const auto ips = hex::generateIPSPatch(patches);
+    const auto loaded = hex::loadIPSPatch(ips);
+    TEST_ASSERT(loaded.size() == patches.size());
+    TEST_ASSERT(loaded.getExtentCount() == patches.getExtentCount());
+    TEST_ASSERT(loaded.get(0x80) == 0xBB);
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("PatchesUndoRedo") {
+    std::vector<u8> data(0x100, 0x00);
+    hex::test::TestProvider provider(&data);
+
+    const std::vector<u8> first(0x20, 0xAA);
+    const std::vector<u8> second(0x10, 0xBB);
+
+    provider.addPatch(0x10, first.data(), first.size(), true);
+    provider.addPatch(0x18, second.data(), second.size(), true);
+    TEST_ASSERT(provider.getUndoStepCount() == 2);
+    TEST_ASSERT(provider.getPatches().get(0x18) == 0xBB);
+
+    // Only the written bytes and the overwritten patches are kept around
+    TEST_ASSERT(provider.getUndoHistorySize() == first.size() + second.size() * 2);
+
+    provider.undo();
+    TEST_ASSERT(provider.getPatches().size() == first.size());
+    TEST_ASSERT(provider.getPatches().get(0x18) == 0xAA);
+
+    provider.undo();
+    TEST_ASSERT(provider.getPatches().empty());
+    TEST_ASSERT(!provider.canUndo());
+
+    provider.redo();
+    provider.redo();
+    TEST_ASSERT(!provider.canRedo());
+    TEST_ASSERT(provider.getPatches().get(0x18) == 0xBB);
+    TEST_ASSERT(provider.getPatches().get(0x10) == 0xAA);
+
+    // Edits without an undo point get grouped into a single step
+    provider.undo();
+    provider.addPatch(0x80, second.data(), 1);
+    provider.addPatch(0x90, second.data(), 1);
+    provider.createUndoPoint();
+    TEST_ASSERT(provider.getUndoStepCount() == 2);
+    TEST_ASSERT(!provider.canRedo());
+
+    provider.undo();
+    TEST_ASSERT(!provider.getPatches().contains(0x80));
+    TEST_ASSERT(!provider.getPatches().contains(0x90));
+    TEST_ASSERT(provider.getPatches().get(0x18) == 0xAA);
+
+    TEST_SUCCESS();
+};
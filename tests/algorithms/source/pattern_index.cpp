@@ -0,0 +1,90 @@
+#include <hex/pattern_language/pattern_data.hpp>
+#include <hex/pattern_language/pattern_index.hpp>
+#include "tests.hpp"
+
+#include <vector>
+
+using namespace hex::pl;
+
+TEST_SEQUENCE("PatternIndex") {
+    constexpr u32 StructColorA = 0x10, StructColorB = 0x20, EntryColorA = 0x30, EntryColorB = 0x40, OverlapColor = 0x50, HiddenColor = 0x60;
+
+    // Struct with two members at 0x10
+    auto structPattern = new PatternDataStruct(0x10, 6, nullptr, 0x01);
+    structPattern->setMembers({
+        new PatternDataUnsigned(0x10, sizeof(u16), nullptr, StructColorA),
+        new PatternDataUnsigned(0x12, sizeof(u32), nullptr, StructColorB)
+    });
+
+    // Array of four two byte structs at 0x20 using a template
+    auto entryPattern = new PatternDataStruct(0x20, 2, nullptr, 0x02);
+    entryPattern->setMembers({
+        new PatternDataUnsigned(0x20, sizeof(u8), nullptr, EntryColorA),
+        new PatternDataUnsigned(0x21, sizeof(u8), nullptr, EntryColorB)
+    });
+    auto arrayPattern = new PatternDataStaticArray(0x20, 8, nullptr, 0x03);
+    arrayPattern->setEntries(entryPattern, 4);
+
+    // Overlaps the struct which comes first and therefore wins, only the part behind it is visible
+    auto overlapPattern = new PatternDataUnsigned(0x14, sizeof(u64), nullptr, OverlapColor);
+
+    auto hiddenPattern = new PatternDataUnsigned(0x40, sizeof(u32), nullptr, HiddenColor);
+    hiddenPattern->setHidden(true);
+
+    std::vector<PatternData*> patterns = { structPattern, arrayPattern, overlapPattern, hiddenPattern };
+    ON_SCOPE_EXIT {
+        for (auto pattern : patterns)
+            delete pattern;
+    };
+
+    PatternIndex index(patterns);
+
+    TEST_ASSERT(!index.getColor(0x0F).has_value());
+    TEST_ASSERT(index.getColor(0x10) == StructColorA);
+    TEST_ASSERT(index.getColor(0x11) == StructColorA);
+    TEST_ASSERT(index.getColor(0x12) == StructColorB);
+    TEST_ASSERT(index.getColor(0x15) == StructColorB);
+    TEST_ASSERT(index.getColor(0x16) == OverlapColor);
+    TEST_ASSERT(index.getColor(0x1B) == OverlapColor);
+    TEST_ASSERT(!index.getColor(0x1C).has_value());
+
+    for (u64 address = 0x20; address < 0x28; address++)
+        TEST_ASSERT(index.getColor(address) == (address % 2 == 0 ? EntryColorA : EntryColorB), "at address {:#x}", address);
+    TEST_ASSERT(!index.getColor(0x28).has_value());
+
+    TEST_ASSERT(!index.getColor(0x40).has_value());
+
+    // Lookups going backwards can't be answered from the last segment
+    TEST_ASSERT(index.getColor(0x12) == StructColorB);
+    TEST_ASSERT(index.getColor(0x10) == StructColorA);
+
+    TEST_ASSERT(PatternIndex().empty());
+    TEST_ASSERT(!PatternIndex().getColor(0x00).has_value());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("PatternIndexRegions") {
+    constexpr u32 ColorA = 0x10, ColorB = 0x20, ColorC = 0x30;
+
+    std::vector<std::pair<hex::Region, u32>> regions = {
+        { { 0x20, 0x10 }, ColorB },
+        { { 0x10, 0x08 }, ColorA },
+        { { 0x18, 0x10 }, ColorC },     // Partially covered by the region at 0x20 which comes first
+        { { 0x40, 0x00 }, ColorA }
+    };
+
+    PatternIndex index(regions);
+
+    TEST_ASSERT(!index.getColor(0x0F).has_value());
+    TEST_ASSERT(index.getColor(0x10) == ColorA);
+    TEST_ASSERT(index.getColor(0x17) == ColorA);
+    TEST_ASSERT(index.getColor(0x18) == ColorC);
+    TEST_ASSERT(index.getColor(0x1F) == ColorC);
+    TEST_ASSERT(index.getColor(0x20) == ColorB);
+    TEST_ASSERT(index.getColor(0x2F) == ColorB);
+    TEST_ASSERT(!index.getColor(0x30).has_value());
+    TEST_ASSERT(!index.getColor(0x40).has_value());
+
+    TEST_SUCCESS();
+};
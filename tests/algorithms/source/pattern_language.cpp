@@ -0,0 +1,129 @@
+#include <hex/pattern_language/pattern_language.hpp>
+#include <hex/pattern_language/pattern_data.hpp>
+#include "test_provider.hpp"
+#include "tests.hpp"
+
+#include <vector>
+
+using namespace hex::pl;
+
+TEST_SEQUENCE("IncrementalEvaluation") {
+    std::vector<u8> data(0x100, 0x00);
+    data[0x00] = 2;
+
+    hex::test::TestProvider provider(&data);
+
+    constexpr auto Code = R"(
+        u8 count @ 0x00;
+        u8 values[count] @ 0x10;
+        u32 tail @ 0x40;
+    )";
+
+    PatternLanguage language;
+
+    auto patterns = language.executeString(&provider, Code);
+    TEST_ASSERT(patterns.has_value() && patterns->size() == 3);
+    TEST_ASSERT(patterns->at(1)->getSize() == 2);
+
+    const auto firstResult = *patterns;
+
+    // Nothing read the tail while evaluating, so the old patterns are still correct
+    u8 value = 0xAA;
+    provider.addPatch(0x40, &value, sizeof(value));
+
+    patterns = language.reexecuteString(&provider, Code);
+    TEST_ASSERT(patterns.has_value());
+    TEST_ASSERT(*patterns == firstResult);
+
+    // The array's size depends on the count, only the placements starting at the array are evaluated again
+    value = 4;
+    provider.addPatch(0x00, &value, sizeof(value));
+
+    patterns = language.reexecuteString(&provider, Code);
+    TEST_ASSERT(patterns.has_value() && patterns->size() == 3);
+    TEST_ASSERT(patterns->at(0) == firstResult[0]);
+    TEST_ASSERT(patterns->at(1)->getSize() == 4);
+
+    // Different code can't reuse anything
+    patterns = language.reexecuteString(&provider, "u8 values[count] @ 0x10; u8 count @ 0x00;");
+    TEST_ASSERT(!patterns.has_value());
+
+    patterns = language.reexecuteString(&provider, Code);
+    TEST_ASSERT(patterns.has_value() && patterns->size() == 3);
+    TEST_ASSERT(patterns->at(1)->getSize() == 4);
+
+    for (auto pattern : *patterns)
+        delete pattern;
+
+    // A type declaration doesn't create a checkpoint with patterns, so everything published so far has to be retracted before it's destroyed
+    constexpr auto StructCode = R"(
+        struct Values { u8 count; u8 values[count]; };
+        Values values @ 0x00;
+    )";
+
+    std::vector<PatternData*> published;
+    std::vector<size_t> publishedSizes;
+    bool publishedValid = true;
+    language.setPartialResultCallback([&](const std::vector<PatternData*> &patterns) {
+        // Views keep drawing the published patterns until they get replaced
+        for (auto pattern : published)
+            publishedValid = publishedValid && pattern->getSize() != 0;
+
+        published = patterns;
+        publishedSizes.push_back(patterns.size());
+    });
+
+    patterns = language.executeString(&provider, StructCode);
+    TEST_ASSERT(patterns.has_value() && patterns->size() == 1);
+    TEST_ASSERT(patterns->front()->getSize() == 5);
+
+    published = *patterns;
+    publishedSizes.clear();
+
+    value = 2;
+    provider.addPatch(0x00, &value, sizeof(value));
+
+    patterns = language.reexecuteString(&provider, StructCode);
+    TEST_ASSERT(patterns.has_value() && patterns->size() == 1);
+    TEST_ASSERT(patterns->front()->getSize() == 3);
+    TEST_ASSERT(!publishedSizes.empty() && publishedSizes.front() == 0);
+    TEST_ASSERT(publishedValid);
+
+    language.setPartialResultCallback(nullptr);
+    for (auto pattern : *patterns)
+        delete pattern;
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("EvaluationResultOwnership") {
+    std::vector<u8> data(0x100, 0x00);
+
+    hex::test::TestProvider provider(&data);
+
+    // Global local variables stay with the runtime, the placed patterns belong to the caller and are destroyed before the next run
+    constexpr auto Code = R"(
+        u8 base;
+
+        fn secondOffset() {
+            base = 0x10;
+            return base;
+        };
+
+        u8 first @ 0x00;
+        u32 second @ secondOffset();
+    )";
+
+    PatternLanguage language;
+
+    for (u32 i = 0; i < 2; i++) {
+        auto patterns = language.executeString(&provider, Code);
+        TEST_ASSERT(patterns.has_value() && patterns->size() == 2);
+        TEST_ASSERT(patterns->at(1)->getOffset() == 0x10);
+
+        for (auto pattern : *patterns)
+            delete pattern;
+    }
+
+    TEST_SUCCESS();
+};
@@ -0,0 +1,90 @@
+#include <hex/helpers/search.hpp>
+#include "test_provider.hpp"
+#include "tests.hpp"
+
+#include <vector>
+
+namespace {
+
+    bool findsAll(const hex::SearchPattern &pattern, const std::vector<u8> &data, const std::vector<u64> &expected) {
+        std::vector<u64> results;
+        pattern.search(data, [&](u64 offset) { results.push_back(offset); });
+
+        return results == expected;
+    }
+
+}
+
+TEST_SEQUENCE("SearchHex") {
+    const std::vector<u8> data = { 0x4D, 0x5A, 0x90, 0x00, 0x50, 0x45, 0x4D, 0x5A, 0x4D, 0x5A, 0x00, 0x00, 0x50, 0x45 };
+
+    auto exact = hex::SearchPattern::fromHexString("4D5A");
+    TEST_ASSERT(exact.has_value());
+    const std::vector<u64> exactResults = { 0x00, 0x06, 0x08 };
+    TEST_ASSERT(findsAll(*exact, data, exactResults));
+
+    auto masked = hex::SearchPattern::fromHexString("4D 5A ?? ?? 50 45");
+    TEST_ASSERT(masked.has_value() && masked->size() == 6);
+    const std::vector<u64> maskedResults = { 0x00, 0x08 };
+    TEST_ASSERT(findsAll(*masked, data, maskedResults));
+
+    auto nibble = hex::SearchPattern::fromHexString("5?");
+    const std::vector<u64> nibbleResults = { 0x01, 0x04, 0x07, 0x09, 0x0C };
+    TEST_ASSERT(findsAll(*nibble, data, nibbleResults));
+
+    TEST_ASSERT(!hex::SearchPattern::fromHexString("4D 5X").has_value());
+    TEST_ASSERT(!hex::SearchPattern::fromHexString("").has_value());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("SearchString") {
+    const std::string text("aaaa Hello HELLO h\0e\0l\0l\0o\0", 27);
+    const std::vector<u8> data(text.begin(), text.end());
+
+    // Overlapping matches have to be found too
+    auto overlapping = hex::SearchPattern::fromString("aa");
+    const std::vector<u64> overlappingResults = { 0, 1, 2 };
+    TEST_ASSERT(findsAll(*overlapping, data, overlappingResults));
+
+    auto caseSensitive = hex::SearchPattern::fromString("Hello");
+    const std::vector<u64> caseSensitiveResults = { 5 };
+    TEST_ASSERT(findsAll(*caseSensitive, data, caseSensitiveResults));
+
+    auto caseInsensitive = hex::SearchPattern::fromString("hello", false);
+    const std::vector<u64> caseInsensitiveResults = { 5, 11 };
+    TEST_ASSERT(findsAll(*caseInsensitive, data, caseInsensitiveResults));
+
+    auto utf16 = hex::SearchPattern::fromString("HeLLo", false, hex::SearchPattern::Encoding::UTF16LE);
+    TEST_ASSERT(utf16->size() == 10);
+    const std::vector<u64> utf16Results = { 17 };
+    TEST_ASSERT(findsAll(*utf16, data, utf16Results));
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("SearchProvider") {
+    std::vector<u8> data(hex::SearchPattern::SearchBlockSize + 0x1000, 0x00);
+    hex::test::TestProvider provider(&data);
+
+    // Matches crossing chunk and block borders as well as patched ones
+    const std::vector<u64> addresses = { 0x10, hex::prv::Provider::DefaultChunkSize - 2, hex::SearchPattern::SearchBlockSize - 1 };
+    for (auto address : addresses) {
+        data[address] = 0x12;
+        data[address + 1] = 0x34;
+        data[address + 2] = 0x56;
+    }
+
+    const u8 patch[] = { 0x12, 0x34, 0x56 };
+    provider.addPatch(data.size() - 3, patch, sizeof(patch));
+
+    auto pattern = hex::SearchPattern::fromHexString("123456");
+    std::vector<u64> results;
+    pattern->search(&provider, 0, data.size(), [&](u64 address) { results.push_back(address); });
+
+    TEST_ASSERT(results.size() == 4);
+    TEST_ASSERT(std::equal(addresses.begin(), addresses.end(), results.begin()));
+    TEST_ASSERT(results.back() == data.size() - 3);
+
+    TEST_SUCCESS();
+};
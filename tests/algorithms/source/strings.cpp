@@ -0,0 +1,174 @@
+#include <hex/helpers/encoding_file.hpp>
+#include <hex/helpers/search.hpp>
+#include <hex/helpers/string_extractor.hpp>
+#include <hex/helpers/string_table.hpp>
+#include "test_provider.hpp"
+#include "tests.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <regex>
+#include <vector>
+
+namespace {
+
+    bool extracts(const hex::StringExtractor &extractor, const std::string &data, const std::vector<std::string> &expected) {
+        const auto results = extractor.extract({ reinterpret_cast<const u8*>(data.data()), data.size() });
+        if (results.size() != expected.size())
+            return false;
+
+        for (size_t i = 0; i < results.size(); i++) {
+            if (extractor.decode({ reinterpret_cast<const u8*>(data.data()) + results[i].address, results[i].size }) != expected[i])
+                return false;
+        }
+
+        return true;
+    }
+
+}
+
+TEST_SEQUENCE("StringsEncodings") {
+    using Encoding = hex::StringExtractor::Encoding;
+
+    const std::string ascii("\x01Hello\x00World\x02\x03Hi\x00", 16);
+    const std::vector<std::string> asciiResults = { "Hello", "World" };
+    TEST_ASSERT(extracts(hex::StringExtractor(Encoding::ASCII, 5), ascii, asciiResults));
+
+    const std::string utf8("\xFF" "Gr\xC3\xBC\xC3\x9F" "e\xC0\xAF" "abcd\xE2\x82\xAC", 17);
+    const std::vector<std::string> utf8Results = { "Gr\xC3\xBC\xC3\x9F" "e", "abcd\xE2\x82\xAC" };
+    TEST_ASSERT(extracts(hex::StringExtractor(Encoding::UTF8, 5), utf8, utf8Results));
+
+    // UTF-16 strings can start at odd addresses
+    const std::string utf16le("\x01T\x00" "e\x00s\x00t\x00\x01\x01", 12);
+    const std::vector<std::string> utf16leResults = { "Test" };
+    TEST_ASSERT(extracts(hex::StringExtractor(Encoding::UTF16LE, 4), utf16le, utf16leResults));
+
+    const std::string utf16be("\x00T\x00" "e\x00s\x00t", 8);
+    const std::vector<std::string> utf16beResults = { "Test" };
+    TEST_ASSERT(extracts(hex::StringExtractor(Encoding::UTF16BE, 4), utf16be, utf16beResults));
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("StringsEncodingFile") {
+    const auto path = std::filesystem::temp_directory_path() / "imhex_test_encoding.tbl";
+    {
+        std::ofstream file(path);
+        file << "41=A\n42=B\n4142=AB!\n41=Z\n82A0=\xE3\x81\x82\nnot a mapping\n";
+    }
+
+    using Encoding = std::pair<std::string_view, size_t>;
+
+    hex::EncodingFile encodingFile(hex::EncodingFile::Type::Thingy, path);
+    std::filesystem::remove(path);
+
+    TEST_ASSERT(encodingFile.valid() && encodingFile.getLongestSequence() == 2);
+
+    // The longest sequence wins, the first entry of sequences listed multiple times wins
+    const std::vector<u8> data = { 0x41, 0x42, 0x43, 0x82, 0xA0, 0x41 };
+    TEST_ASSERT(encodingFile.findEncodingFor(data) == Encoding("AB!", 2));
+    TEST_ASSERT(encodingFile.findEncodingFor(std::span(data).subspan(1)) == Encoding("B", 1));
+    TEST_ASSERT(encodingFile.findEncodingFor(std::span(data).subspan(5)) == Encoding("A", 1));
+    TEST_ASSERT(!encodingFile.findEncodingFor(std::span(data).subspan(2)).has_value());
+    TEST_ASSERT(!encodingFile.findEncodingFor(std::span(data).subspan(3, 1)).has_value());
+    TEST_ASSERT(encodingFile.getEncodingFor(std::span(data).subspan(2)) == Encoding(".", 1));
+
+    TEST_ASSERT(encodingFile.decode(data) == "AB!.\xE3\x81\x82" "A", "{}", encodingFile.decode(data));
+
+    TEST_ASSERT(encodingFile.encode("AB!A\xE3\x81\x82") == std::vector<u8>({ 0x41, 0x42, 0x41, 0x82, 0xA0 }));
+    TEST_ASSERT(!encodingFile.encode("AC").has_value());
+
+    auto pattern = hex::SearchPattern::fromString("\xE3\x81\x82" "A", encodingFile);
+    TEST_ASSERT(pattern.has_value() && pattern->size() == 3 && pattern->matches(data.data() + 3));
+
+    TEST_ASSERT(!hex::EncodingFile().findEncodingFor(data).has_value());
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("StringsChunked") {
+    using Encoding = hex::StringExtractor::Encoding;
+
+    std::mt19937 random(0x1337);
+    std::vector<u8> data(hex::StringExtractor::ChunkSize * 3 + 0x123);
+    for (auto &byte : data)
+        byte = (random() % 4) == 0 ? 0x00 : ('A' + random() % 26);
+
+    // Strings spanning an entire chunk and crossing chunk borders at different offsets
+    std::memset(data.data() + hex::StringExtractor::ChunkSize - 0x10, 'X', hex::StringExtractor::ChunkSize + 0x20);
+    const char multiByte[] = "\xE2\x82\xAC\xE2\x82\xAC";
+    std::memcpy(data.data() + hex::StringExtractor::ChunkSize * 3 - 2, multiByte, 6);
+
+    hex::test::TestProvider provider(&data);
+
+    for (auto encoding : { Encoding::ASCII, Encoding::UTF8, Encoding::UTF16LE }) {
+        hex::StringExtractor extractor(encoding, 4);
+
+        const auto expected = extractor.extract(data);
+        const auto results  = extractor.extract(&provider, 0, data.size(), { }, 4);
+
+        TEST_ASSERT(!results.empty());
+        TEST_ASSERT(results.size() == expected.size(), "for encoding {}", u8(encoding));
+        TEST_ASSERT(std::equal(results.begin(), results.end(), expected.begin(), [](const auto &left, const auto &right) {
+            return left.address == right.address && left.size == right.size;
+        }), "for encoding {}", u8(encoding));
+    }
+
+    TEST_SUCCESS();
+};
+
+TEST_SEQUENCE("StringsFilter") {
+    const std::vector<std::pair<std::string, std::string>> literals = {
+        { "abc", "abc" }, { "ab+c", "ab" }, { "xa?bcd", "bcd" }, { "a\\.b[cd]ef", "a.b" },
+        { "(abc)+defg", "defg" }, { "foo|barbaz", "" }, { "ab{2,3}cd", "cd" },
+        { "a\\x41BCD", "BCD" }, { "\\u0041bcd\\dxy", "bcd" }, { "ab\\cJcde", "cde" }, { "(a)\\1bcd", "bcd" }
+    };
+    for (const auto &[regex, literal] : literals)
+        TEST_ASSERT(hex::StringFilter::create(regex, true)->getLiteral() == literal, "for regex {}", regex);
+
+    TEST_ASSERT(!hex::StringFilter::create("a(b", true).has_value());
+
+    std::mt19937 random(0x1337);
+    hex::StringTable table;
+    std::vector<std::string> strings;
+    for (u32 i = 0; i < 100'000; i++) {
+        std::string string;
+        for (u32 j = 0, length = 1 + random() % 32; j < length; j++)
+            string += "abcdefXYZ._ "[random() % 12];
+
+        table.add(string);
+        strings.push_back(string);
+    }
+
+    TEST_ASSERT(table.size() == strings.size());
+    TEST_ASSERT(table.get(1234) == strings[1234]);
+
+    // Results have to match running the filter on every string one by one, without a literal matching across two strings
+    for (const auto &[filter, regex] : { std::pair{ "abc", false }, { "a a", false }, { "ab+c\\.", true }, { "X(Y|Z)+", true }, { "^d.*f$", true }, { "e a", false } }) {
+        const auto compiled = hex::StringFilter::create(filter, regex);
+        const std::regex reference(filter);
+
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < strings.size(); i++) {
+            if (regex ? std::regex_search(strings[i], reference) : strings[i].find(filter) != std::string::npos)
+                expected.push_back(i);
+        }
+
+        TEST_ASSERT(compiled->apply(table) == expected, "for filter {}", filter);
+        TEST_ASSERT(compiled->apply(table, compiled->apply(table)) == expected, "for filter {}", filter);
+    }
+
+    // Typing more characters only has to look at the previous results
+    const auto narrow = hex::StringFilter::create("abcd", false), wide = hex::StringFilter::create("bc", false);
+    TEST_ASSERT(narrow->narrows(*wide));
+    TEST_ASSERT(!wide->narrows(*narrow));
+    TEST_ASSERT(narrow->narrows(hex::StringFilter()));
+    TEST_ASSERT(!hex::StringFilter::create("abcd", true)->narrows(*wide));
+
+    std::stop_source stopSource;
+    stopSource.request_stop();
+    TEST_ASSERT(!wide->apply(table, std::nullopt, stopSource.get_token()).has_value());
+
+    TEST_SUCCESS();
+};
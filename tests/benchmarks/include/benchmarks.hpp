@@ -0,0 +1,87 @@
+#pragma once
+
+#include <hex.hpp>
+#include <utility>
+#include <hex/helpers/utils.hpp>
+#include <hex/helpers/fmt.hpp>
+#include <hex/helpers/logger.hpp>
+
+#include <chrono>
+#include <string>
+#include <map>
+#include <functional>
+
+#define BENCHMARK(...) static auto ANONYMOUS_VARIABLE(BENCHMARK) = ::hex::test::BenchmarkExecutor(__VA_ARGS__) + []() -> void
+
+namespace hex::test {
+
+    class Benchmarks {
+    public:
+        static auto addBenchmark(const std::string &name, const std::function<void()> &func) noexcept {
+            s_benchmarks.insert({ name, func });
+
+            return 0;
+        }
+
+        static auto& get() noexcept {
+            return s_benchmarks;
+        }
+    private:
+        static inline std::map<std::string, std::function<void()>> s_benchmarks;
+    };
+
+    template<class F>
+    class Benchmark {
+    public:
+        Benchmark(const std::string& name, F func) noexcept {
+            Benchmarks::addBenchmark(name, func);
+        }
+
+        Benchmark& operator=(Benchmark &&) = delete;
+    };
+
+    struct BenchmarkExecutor {
+        explicit BenchmarkExecutor(std::string name) noexcept : m_name(std::move(name)) {
+
+        }
+
+        [[nodiscard]]
+        const auto& getName() const noexcept {
+            return this->m_name;
+        }
+
+    private:
+        std::string m_name;
+    };
+
+    template <typename F>
+    Benchmark<F> operator+(BenchmarkExecutor executor, F&& f) noexcept {
+        return Benchmark<F>(executor.getName(), std::forward<F>(f));
+    }
+
+    /*
+     * Runs a function a number of times and logs the average time per run as well as the
+     * throughput in MiB/s if the number of bytes processed per run is known
+     */
+    template<typename F>
+    double measure(const std::string &name, size_t bytesPerRun, u32 runs, F &&function) {
+        using namespace std::chrono;
+
+        function();
+
+        auto start = high_resolution_clock::now();
+        for (u32 i = 0; i < runs; i++)
+            function();
+        auto end = high_resolution_clock::now();
+
+        double seconds = duration_cast<duration<double>>(end - start).count() / runs;
+
+        if (bytesPerRun > 0)
+            hex::log::info("{:<40} {:>12.3f} ms  {:>10.1f} MiB/s", name, seconds * 1000, (bytesPerRun / double(1024 * 1024)) / seconds);
+        else
+            hex::log::info("{:<40} {:>12.3f} ms", name, seconds * 1000);
+
+        return seconds;
+    }
+
+}
@@ -0,0 +1,86 @@
+#include <hex/helpers/byte_analysis.hpp>
+#include "benchmarks.hpp"
+#include "test_provider.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    constexpr static size_t DataSize = 1024 * 1024 * 1024;
+
+    // Block histograms the way the information view used to calculate them
+    float analyzeNaive(hex::prv::Provider &provider, size_t blockSize) {
+        std::array<u64, 256> valueCounts = { 0 };
+        float highestEntropy = 0;
+
+        provider.readChunks(0, provider.getActualSize(), [&](u64, std::span<const u8> data) {
+            std::array<u64, 256> blockValueCounts = { 0 };
+
+            for (u8 byte : data) {
+                blockValueCounts[byte]++;
+                valueCounts[byte]++;
+            }
+
+            float entropy = 0;
+            for (auto count : blockValueCounts) {
+                if (count == 0) continue;
+
+                float probability = static_cast<float>(count) / data.size();
+                entropy += probability * std::log2(probability);
+            }
+
+            highestEntropy = std::max(highestEntropy, -entropy / 8);
+        }, blockSize);
+
+        return highestEntropy;
+    }
+
+}
+
+BENCHMARK("ByteAnalysis") {
+    using namespace hex::test;
+
+    // Compressed data followed by large runs of the same byte, like padding in firmware images
+    std::mt19937_64 random(0x1337);
+    std::vector<u8> data(DataSize);
+    for (size_t i = 0; i < DataSize / 2; i += sizeof(u64)) {
+        const u64 value = random();
+        std::memcpy(data.data() + i, &value, sizeof(value));
+    }
+    std::fill(data.begin() + DataSize / 2, data.end(), 0xFF);
+
+    TestProvider provider(&data);
+    const size_t blockSize = DataSize / 2048;
+
+    float entropy = 0;
+    measure("Naive", DataSize, 1, [&] { entropy = analyzeNaive(provider, blockSize); });
+    measure("Banked, 1 thread", DataSize, 1, [&] {
+        provider.write(0, data.data(), 1); // New revision so the cached result isn't used
+        entropy = hex::ByteAnalyzer::analyze(&provider, 0, DataSize, blockSize, { }, 1)->statistics.entropy;
+    });
+    measure(hex::format("Banked, {} threads", std::thread::hardware_concurrency()), DataSize, 1, [&] {
+        provider.write(0, data.data(), 1);
+        entropy = hex::ByteAnalyzer::analyze(&provider, 0, DataSize, blockSize)->statistics.entropy;
+    });
+    measure("Cached", DataSize, 1, [&] { entropy = hex::ByteAnalyzer::analyze(&provider, 0, DataSize, blockSize)->statistics.entropy; });
+
+    // A single byte edit only has to recalculate one block
+    auto analysis = hex::ByteAnalyzer::analyze(&provider, 0, DataSize, blockSize);
+    measure("Update after edit", DataSize, 10, [&, address = u64(0)]() mutable {
+        const u8 byte = 0x00;
+        provider.addPatch(address, &byte, sizeof(byte), true);
+        address += 0x10'0000 * 123;
+        address %= DataSize;
+
+        analysis = hex::ByteAnalyzer::update(&provider, analysis);
+        entropy = analysis->statistics.entropy;
+    });
+
+    hex::log::info("Entropy {}", entropy);
+};
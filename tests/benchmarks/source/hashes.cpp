@@ -0,0 +1,52 @@
+#include <hex/helpers/crypto.hpp>
+#include "benchmarks.hpp"
+#include "test_provider.hpp"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+    constexpr static size_t DataSize = 256 * 1024 * 1024;
+
+}
+
+BENCHMARK("Hashes") {
+    using namespace hex::test;
+
+    std::mt19937_64 random(0x1337);
+    std::vector<u8> data(DataSize);
+    for (size_t i = 0; i < DataSize; i += sizeof(u64)) {
+        const u64 value = random();
+        std::memcpy(data.data() + i, &value, sizeof(value));
+    }
+
+    TestProvider provider(&data);
+    hex::prv::Provider *providerPtr = &provider;
+
+    const hex::crypt::CrcParameters crc32 = { 0x04C11DB7, 0xFFFFFFFF, 0xFFFFFFFF, true, true };
+
+    // The way the hashes view used to calculate every hash function on its own
+    u64 checksum = 0;
+    measure("Separate passes", DataSize, 1, [&] {
+        checksum += hex::crypt::crc32(providerPtr, 0, DataSize, crc32.polynomial, crc32.init, crc32.xorout, crc32.reflectIn, crc32.reflectOut);
+        checksum += hex::crypt::md5(providerPtr, 0, DataSize)[0];
+        checksum += hex::crypt::sha1(providerPtr, 0, DataSize)[0];
+        checksum += hex::crypt::sha256(providerPtr, 0, DataSize)[0];
+    });
+
+    measure("One pass", DataSize, 1, [&] {
+        const auto digests = hex::crypt::hash(&provider, 0, DataSize, {
+            { hex::crypt::HashFunction::CRC32, crc32 },
+            { hex::crypt::HashFunction::MD5 },
+            { hex::crypt::HashFunction::SHA1 },
+            { hex::crypt::HashFunction::SHA256 },
+        });
+
+        for (const auto &digest : *digests)
+            checksum += digest[0];
+    });
+
+    hex::log::info("Checksum {}", checksum);
+};
@@ -0,0 +1,33 @@
+#include <hex.hpp>
+#include <hex/helpers/utils.hpp>
+#include <hex/helpers/logger.hpp>
+#include "benchmarks.hpp"
+
+#include <cstdlib>
+
+int main(int argc, char **argv) {
+    auto &benchmarks = hex::test::Benchmarks::get();
+
+    // Run all benchmarks if no specific one has been requested
+    if (argc == 1) {
+        for (auto &[name, benchmark] : benchmarks) {
+            hex::log::info("Running benchmark {}", name);
+            benchmark();
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        std::string benchmarkName = argv[i];
+        if (!benchmarks.contains(benchmarkName)) {
+            hex::log::fatal("No benchmark with name {} found!", benchmarkName);
+            return EXIT_FAILURE;
+        }
+
+        hex::log::info("Running benchmark {}", benchmarkName);
+        benchmarks[benchmarkName]();
+    }
+
+    return EXIT_SUCCESS;
+}
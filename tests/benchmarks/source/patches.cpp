@@ -0,0 +1,128 @@
+#include <hex/helpers/patches.hpp>
+#include "benchmarks.hpp"
+#include "test_provider.hpp"
+
+#include <cstring>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+    constexpr static size_t DataSize        = 16 * 1024 * 1024;
+    constexpr static size_t PasteAddress    = 4 * 1024 * 1024;
+    constexpr static size_t PasteSize       = 4 * 1024 * 1024;
+    constexpr static size_t ScatteredCount  = 0x10000;
+
+    // Per-byte patch lookup the way the providers used to overlay std::map<u64, u8> patches
+    void readWithMap(const std::vector<u8> &data, const std::map<u64, u8> &patches, u64 offset, u8 *buffer, size_t size) {
+        std::memcpy(buffer, data.data() + offset, size);
+
+        for (u64 i = 0; i < size; i++) {
+            if (patches.contains(offset + i))
+                buffer[i] = patches.at(offset + i);
+        }
+    }
+
+    void readWithExtents(const std::vector<u8> &data, const hex::Patches &patches, u64 offset, u8 *buffer, size_t size) {
+        std::memcpy(buffer, data.data() + offset, size);
+
+        patches.apply(offset, buffer, size);
+    }
+
+    void runReadBenchmarks(const std::string &name, const std::vector<u8> &data, const std::map<u64, u8> &mapPatches, const hex::Patches &extentPatches) {
+        using namespace hex::test;
+
+        std::vector<u8> buffer(1024 * 1024);
+
+        // Hex editor style reads, one row of 16 bytes at a time
+        measure(name + " rows, map", DataSize, 3, [&] {
+            for (u64 offset = 0; offset < DataSize; offset += 0x10)
+                readWithMap(data, mapPatches, offset, buffer.data(), 0x10);
+        });
+        measure(name + " rows, extents", DataSize, 3, [&] {
+            for (u64 offset = 0; offset < DataSize; offset += 0x10)
+                readWithExtents(data, extentPatches, offset, buffer.data(), 0x10);
+        });
+
+        // Analysis style reads in large blocks
+        measure(name + " blocks, map", DataSize, 3, [&] {
+            for (u64 offset = 0; offset < DataSize; offset += buffer.size())
+                readWithMap(data, mapPatches, offset, buffer.data(), buffer.size());
+        });
+        measure(name + " blocks, extents", DataSize, 3, [&] {
+            for (u64 offset = 0; offset < DataSize; offset += buffer.size())
+                readWithExtents(data, extentPatches, offset, buffer.data(), buffer.size());
+        });
+    }
+
+}
+
+BENCHMARK("PatchesPaste") {
+    using namespace hex::test;
+
+    std::vector<u8> data(DataSize, 0x00);
+    std::vector<u8> paste(PasteSize, 0xAA);
+
+    std::map<u64, u8> mapPatches;
+    hex::Patches extentPatches;
+
+    measure("Insert paste, map", PasteSize, 1, [&] {
+        mapPatches.clear();
+        for (u64 i = 0; i < paste.size(); i++)
+            mapPatches[PasteAddress + i] = paste[i];
+    });
+    measure("Insert paste, extents", PasteSize, 1, [&] {
+        extentPatches.clear();
+        extentPatches.add(PasteAddress, paste.data(), paste.size());
+    });
+
+    runReadBenchmarks("Paste", data, mapPatches, extentPatches);
+};
+
+BENCHMARK("PatchesScattered") {
+    using namespace hex::test;
+
+    std::vector<u8> data(DataSize, 0x00);
+
+    std::mt19937_64 random(0x1337);
+    std::vector<u64> addresses(ScatteredCount);
+    for (auto &address : addresses)
+        address = random() % DataSize;
+
+    std::map<u64, u8> mapPatches;
+    hex::Patches extentPatches;
+
+    measure("Insert scattered bytes, map", 0, 1, [&] {
+        mapPatches.clear();
+        for (auto address : addresses)
+            mapPatches[address] = 0xAA;
+    });
+    measure("Insert scattered bytes, extents", 0, 1, [&] {
+        extentPatches.clear();
+        for (auto address : addresses)
+            extentPatches.add(address, 0xAA);
+    });
+
+    runReadBenchmarks("Scattered", data, mapPatches, extentPatches);
+};
+
+BENCHMARK("PatchesUndoHistory") {
+    using namespace hex::test;
+
+    std::vector<u8> data(DataSize, 0x00);
+    TestProvider provider(&data);
+
+    std::vector<u8> paste(PasteSize, 0xAA);
+    for (u64 address = 0; address < DataSize; address += PasteSize / 2)
+        provider.addPatch(address, paste.data(), std::min<size_t>(paste.size(), DataSize - address), true);
+
+    hex::log::info("{} undo steps for {} of patches take up {}", provider.getUndoStepCount(), hex::toByteString(provider.getPatches().size()), hex::toByteString(provider.getUndoHistorySize()));
+
+    measure("Undo and redo all steps", 0, 3, [&] {
+        while (provider.canUndo())
+            provider.undo();
+        while (provider.canRedo())
+            provider.redo();
+    });
+};
@@ -0,0 +1,428 @@
+#include <hex/pattern_language/pattern_language.hpp>
+#include <hex/pattern_language/pattern_data.hpp>
+#include <hex/pattern_language/pattern_index.hpp>
+#include "benchmarks.hpp"
+#include "test_provider.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+// Counts every heap allocation of the benchmarks executable so the pattern language benchmarks can report them
+static std::atomic<u64> s_allocationCount = 0;
+
+void* operator new(std::size_t size) {
+    s_allocationCount++;
+
+    if (auto memory = std::malloc(size); memory != nullptr)
+        return memory;
+    else
+        throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+namespace {
+
+    constexpr static u32 IterationCount = 100'000;
+
+    // Arithmetic on locals in a tight loop, most of the time goes into looking up variables
+    const std::string LoopSource = hex::format(R"(
+        #pragma loop_limit {1}
+
+        fn sum(u32 count) {{
+            u32 total = 0;
+            u32 a = 1;
+            u32 b = 2;
+            u32 c = 3;
+
+            for (u32 i = 0, i < count, i = i + 1) {{
+                u32 value = i * a + b;
+
+                if (value > c)
+                    total = total + value - c;
+                else
+                    total = total + 1;
+            }}
+
+            return total;
+        }};
+
+        u32 result out;
+
+        fn main() {{
+            result = sum({0});
+        }};
+    )", IterationCount, IterationCount + 1);
+
+    constexpr static u32 EntryCount = 2'000;
+
+    // Many small structs whose layout depends on expressions over their own fields, like the headers of most file formats
+    const std::string EntrySource = hex::format(R"(
+        #pragma pattern_limit {1}
+
+        struct Entry {{
+            u8 type;
+            u8 flags;
+            u16 length;
+
+            if ((type & 0x0F) * 2 + (flags >> 4) > 8 && length % 3 != 1)
+                u8 extra[(length & 0x03) + 1];
+            else
+                padding[(type ^ flags) % 4 + 1];
+
+            u8 checksum [[format("format_checksum")]];
+        }};
+
+        fn format_checksum(u8 value) {{
+            return value == 0x00 ? "None" : "Present";
+        }};
+
+        Entry entries[{0}] @ 0x00;
+    )", EntryCount, EntryCount * 16);
+
+    constexpr static u32 TableSize = 500;
+
+    // Walks a table through member paths, every step of such a path used to clone the whole pattern it passes through
+    const std::string TableSource = hex::format(R"(
+        #pragma pattern_limit {1}
+        #pragma loop_limit {1}
+
+        struct Entry {{
+            u8 size;
+            u8 data[size & 0x07];
+        }};
+
+        struct Table {{
+            u16 count;
+            Entry entries[{0}];
+        }};
+
+        Table table @ 0x00;
+
+        u32 total out;
+
+        fn main() {{
+            for (u32 i = 0, i < {0}, i = i + 1)
+                total = total + (table.entries[i].size & 0x07);
+        }};
+    )", TableSize, TableSize * 16);
+
+    constexpr static u32 RecordCount = 1'000'000;
+
+    // A table of fixed size records, too large to create a pattern for every entry
+    const std::string RecordSource = hex::format(R"(
+        struct Record {{
+            u32 id;
+            u16 flags;
+            u8 type;
+            u8 name[9];
+        }};
+
+        Record records[{0}] @ 0x00;
+    )", RecordCount);
+
+    constexpr static u32 HeaderCount = 5'000;
+
+    // Structs whose layout depends on several of their own members, every member used in a condition gets read from the provider
+    const std::string HeaderSource = hex::format(R"(
+        #pragma pattern_limit {1}
+        #pragma array_limit {0}
+
+        struct Header {{
+            u8 type;
+            u8 flags;
+            u16 length;
+            u32 id;
+            u32 offset;
+
+            if (type > 0x40 && flags != 0x00 && (length & 0x07) != 0 && id != offset)
+                u32 extra;
+
+            if (type + flags < 0x80)
+                u8 tag[(length & 0x03) + 1];
+        }};
+
+        Header headers[{0}] @ 0x00;
+    )", HeaderCount, HeaderCount * 16);
+
+    constexpr static u32 ChunkCount = 1'000;
+    constexpr static u64 ChunkSize = 0x100;
+
+    // A file made of many independent top-level placements whose layout depends on the data, like a structured file being edited live
+    std::string createChunkSource() {
+        std::string source = R"(
+            #pragma pattern_limit 0x100000
+
+            struct Chunk {
+                u32 type;
+                u16 length;
+                u8 data[length & 0xFF];
+            };
+        )";
+
+        for (u32 i = 0; i < ChunkCount; i++)
+            source += hex::format("Chunk chunk{} @ {:#x};\n", i, i * ChunkSize);
+
+        return source;
+    }
+
+}
+
+BENCHMARK("PatternLanguageLoops") {
+    using namespace hex::test;
+
+    std::vector<u8> data(0x100, 0x00);
+    TestProvider provider(&data);
+
+    hex::pl::PatternLanguage language;
+
+    bool succeeded = true;
+    for (bool useBytecode : { false, true }) {
+        language.setBytecodeEnabled(useBytecode);
+
+        measure(hex::format("{} loop iterations, {}", IterationCount, useBytecode ? "bytecode" : "tree walker"), 0, 5, [&] {
+            auto patterns = language.executeString(&provider, LoopSource);
+            succeeded = succeeded && patterns.has_value();
+
+            if (patterns.has_value()) {
+                for (auto &pattern : *patterns)
+                    delete pattern;
+            }
+        });
+    }
+
+    if (succeeded)
+        hex::log::info("Result {}", hex::pl::Token::literalToUnsigned(language.getOutVariables()["result"]));
+    else
+        hex::log::error("Evaluation failed");
+};
+
+BENCHMARK("PatternLanguageExpressions") {
+    using namespace hex::test;
+
+    std::mt19937 random(0x1337);
+    std::vector<u8> data(EntryCount * 16);
+    for (auto &byte : data)
+        byte = random();
+
+    TestProvider provider(&data);
+
+    hex::pl::PatternLanguage language;
+
+    for (bool useBytecode : { false, true }) {
+        language.setBytecodeEnabled(useBytecode);
+
+        measure(useBytecode ? "Bytecode" : "Tree walker", 0, 5, [&] {
+            auto patterns = language.executeString(&provider, EntrySource);
+
+            if (patterns.has_value()) {
+                for (auto &pattern : *patterns)
+                    delete pattern;
+            } else {
+                hex::log::error("Evaluation failed");
+            }
+        });
+    }
+};
+
+BENCHMARK("PatternLanguageMemberAccess") {
+    using namespace hex::test;
+
+    std::mt19937 random(0x1337);
+    std::vector<u8> data(TableSize * 16);
+    for (auto &byte : data)
+        byte = random();
+
+    TestProvider provider(&data);
+
+    hex::pl::PatternLanguage language;
+
+    u64 allocationCount = 0;
+    measure(hex::format("{} entries", TableSize), 0, 5, [&] {
+        const u64 startCount = s_allocationCount;
+
+        auto patterns = language.executeString(&provider, TableSource);
+
+        if (patterns.has_value()) {
+            for (auto &pattern : *patterns)
+                delete pattern;
+        } else {
+            hex::log::error("Evaluation failed");
+        }
+
+        allocationCount = s_allocationCount - startCount;
+    });
+
+    hex::log::info("Result {}, {} allocations per run", hex::pl::Token::literalToUnsigned(language.getOutVariables()["total"]), allocationCount);
+};
+
+BENCHMARK("PatternLanguageRecordTable") {
+    using namespace hex::test;
+
+    std::vector<u8> data(RecordCount * 16, 0x00);
+    TestProvider provider(&data);
+
+    hex::pl::PatternLanguage language;
+
+    u64 allocationCount = 0;
+    measure(hex::format("{} records", RecordCount), 0, 5, [&] {
+        const u64 startCount = s_allocationCount;
+
+        auto patterns = language.executeString(&provider, RecordSource);
+
+        if (patterns.has_value()) {
+            for (auto &pattern : *patterns)
+                delete pattern;
+        } else {
+            hex::log::error("Evaluation failed");
+        }
+
+        allocationCount = s_allocationCount - startCount;
+    });
+
+    hex::log::info("{} allocations per run", allocationCount);
+};
+
+BENCHMARK("PatternHighlighting") {
+    using namespace hex::test;
+
+    constexpr static u32 PatternCount = 10'000;
+    constexpr static u64 VisibleBytes = 0x1000;
+
+    std::vector<hex::pl::PatternData*> patterns;
+    for (u32 i = 0; i < PatternCount; i++)
+        patterns.push_back(new hex::pl::PatternDataUnsigned(i * sizeof(u32), sizeof(u32), nullptr, i));
+    ON_SCOPE_EXIT {
+        for (auto pattern : patterns)
+            delete pattern;
+    };
+
+    // One screen of bytes at the end of the patterns, where the linear search has to skip all others
+    constexpr static u64 StartAddress = (PatternCount * sizeof(u32)) - VisibleBytes;
+
+    u64 checksum = 0;
+    measure(hex::format("Linear search, {} patterns", PatternCount), 0, 5, [&] {
+        for (u64 address = StartAddress; address < StartAddress + VisibleBytes; address++) {
+            for (auto pattern : patterns) {
+                if (auto child = pattern->getPattern(address); child != nullptr) {
+                    checksum += child->getColor();
+                    break;
+                }
+            }
+        }
+    });
+
+    hex::pl::PatternIndex index;
+    measure("Building the index", 0, 5, [&] {
+        index = hex::pl::PatternIndex(patterns);
+    });
+
+    measure(hex::format("Index, {} patterns", PatternCount), 0, 5, [&] {
+        for (u64 address = StartAddress; address < StartAddress + VisibleBytes; address++)
+            checksum += index.getColor(address).value_or(0);
+    });
+
+    hex::log::info("Checksum {}", checksum);
+};
+
+BENCHMARK("PatternLanguageStructReads") {
+    using namespace hex::test;
+
+    std::mt19937 random(0x1337);
+    std::vector<u8> data(HeaderCount * 32);
+    for (auto &byte : data)
+        byte = random();
+
+    TestProvider provider(&data);
+
+    // An edited file, every read has to apply these on top of the data
+    for (u64 address = 0; address < data.size(); address += 0x80) {
+        u8 value = random();
+        provider.addPatch(address, &value, sizeof(value));
+    }
+
+    hex::pl::PatternLanguage language;
+
+    u64 patternCount = 0;
+    measure(hex::format("{} structs", HeaderCount), 0, 5, [&] {
+        auto patterns = language.executeString(&provider, HeaderSource);
+
+        if (patterns.has_value()) {
+            patternCount = language.getCreatedPatternCount();
+
+            for (auto &pattern : *patterns)
+                delete pattern;
+        } else {
+            hex::log::error("Evaluation failed");
+        }
+    });
+
+    hex::log::info("{} patterns", patternCount);
+};
+
+BENCHMARK("PatternLanguageIncremental") {
+    using namespace hex::test;
+
+    std::vector<u8> data(ChunkCount * ChunkSize, 0x10);
+    TestProvider provider(&data);
+
+    const auto source = createChunkSource();
+
+    hex::pl::PatternLanguage language;
+    std::vector<hex::pl::PatternData*> patterns;
+    ON_SCOPE_EXIT {
+        for (auto &pattern : patterns)
+            delete pattern;
+    };
+
+    auto replacePatterns = [&](std::optional<std::vector<hex::pl::PatternData*>> &&result) {
+        if (!result.has_value())
+            hex::log::error("Evaluation failed");
+
+        patterns = std::move(result.value_or(std::vector<hex::pl::PatternData*>{ }));
+    };
+
+    measure(hex::format("Full evaluation, {} chunks", ChunkCount), 0, 5, [&] {
+        hex::pl::PatternLanguage freshLanguage;
+        auto result = freshLanguage.executeString(&provider, source);
+
+        if (result.has_value()) {
+            for (auto &pattern : *result)
+                delete pattern;
+        }
+    });
+
+    measure("Full evaluation, cached AST", 0, 5, [&] {
+        for (auto &pattern : patterns)
+            delete pattern;
+
+        replacePatterns(language.executeString(&provider, source));
+    });
+
+    // Every run changes the length of the last chunk, only its placement has to be evaluated again
+    u8 length = 0;
+    measure("Edit read by the last chunk", 0, 5, [&] {
+        length++;
+        provider.addPatch((ChunkCount - 1) * ChunkSize + sizeof(u32), &length, sizeof(length));
+
+        replacePatterns(language.reexecuteString(&provider, source));
+    });
+
+    measure("Edit inside of chunk data", 0, 5, [&] {
+        length++;
+        provider.addPatch(ChunkSize / 2, &length, sizeof(length));
+
+        replacePatterns(language.reexecuteString(&provider, source));
+    });
+
+    hex::log::info("{} patterns", patterns.size());
+};
@@ -0,0 +1,83 @@
+#include <hex/providers/provider.hpp>
+#include "benchmarks.hpp"
+#include "test_provider.hpp"
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+    constexpr static size_t DataSize = 1024 * 1024 * 1024;
+
+    // Byte histogram the way the information view walks over the data
+    struct ByteCounter {
+        std::array<u64, 256> counts = { 0 };
+
+        void operator()(const u8 *data, size_t size) {
+            for (size_t i = 0; i < size; i++)
+                counts[data[i]]++;
+        }
+    };
+
+    // Cheap word-wise checksum which makes the cost of copying the data visible
+    struct Checksum {
+        u64 value = 0;
+
+        void operator()(const u8 *data, size_t size) {
+            for (size_t i = 0; i + sizeof(u64) <= size; i += sizeof(u64)) {
+                u64 word;
+                std::memcpy(&word, data + i, sizeof(u64));
+                value ^= word;
+            }
+        }
+    };
+
+    template<size_t BufferSize, typename F>
+    void processWithBuffer(hex::prv::Provider &provider, F &function) {
+        std::array<u8, BufferSize> buffer = { 0 };
+
+        for (u64 offset = 0; offset < provider.getActualSize(); offset += buffer.size()) {
+            const auto readSize = std::min<u64>(buffer.size(), provider.getActualSize() - offset);
+            provider.read(offset, buffer.data(), readSize);
+            function(buffer.data(), readSize);
+        }
+    }
+
+    template<typename F>
+    void processWithChunks(hex::prv::Provider &provider, F &function) {
+        provider.readChunks(0, provider.getActualSize(), [&](u64, std::span<const u8> chunk) {
+            function(chunk.data(), chunk.size());
+        });
+    }
+
+    template<typename F>
+    void runChunkBenchmarks(const std::string &name, hex::prv::Provider &provider) {
+        using namespace hex::test;
+
+        F function;
+
+        measure(name + ", 512 byte reads", DataSize, 1, [&] { processWithBuffer<512>(provider, function); });
+        measure(name + ", 1 KiB reads", DataSize, 1, [&] { processWithBuffer<1024>(provider, function); });
+        measure(name + ", chunks", DataSize, 1, [&] { processWithChunks(provider, function); });
+    }
+
+}
+
+BENCHMARK("ProviderChunks") {
+    std::vector<u8> data(DataSize);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = i * 0x9E3779B1 >> 24;
+
+    hex::test::TestProvider provider(&data);
+
+    runChunkBenchmarks<ByteCounter>("Histogram", provider);
+    runChunkBenchmarks<Checksum>("Checksum", provider);
+
+    // One patch per MiB forces every chunk to be copied with the patches applied
+    u8 value = 0xAA;
+    for (u64 address = 0; address < DataSize; address += 1024 * 1024)
+        provider.addPatch(address, &value, sizeof(u8));
+
+    runChunkBenchmarks<Checksum>("Checksum, patched", provider);
+};
@@ -0,0 +1,76 @@
+#include <hex/helpers/search.hpp>
+#include "benchmarks.hpp"
+#include "test_provider.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+    constexpr static size_t DataSize    = 1024 * 1024 * 1024;
+    constexpr static size_t MatchCount  = 0x1000;
+
+    // Matcher the hex editor's find popup used to use, reading the data in 1 KiB blocks
+    std::vector<u64> searchNaive(hex::prv::Provider &provider, const std::vector<u8> &sequence) {
+        std::vector<u64> results;
+        u32 foundCharacters = 0;
+
+        std::vector<u8> buffer(1024, 0x00);
+        size_t dataSize = provider.getActualSize();
+        for (u64 offset = 0; offset < dataSize; offset += buffer.size()) {
+            size_t usedBufferSize = std::min(u64(buffer.size()), dataSize - offset);
+            provider.read(offset, buffer.data(), usedBufferSize);
+
+            for (u64 i = 0; i < usedBufferSize; i++) {
+                if (buffer[i] == sequence[foundCharacters])
+                    foundCharacters++;
+                else
+                    foundCharacters = 0;
+
+                if (foundCharacters == sequence.size()) {
+                    results.push_back(offset + i - foundCharacters + 1);
+                    foundCharacters = 0;
+                }
+            }
+        }
+
+        return results;
+    }
+
+    std::vector<u64> searchPattern(hex::prv::Provider &provider, const hex::SearchPattern &pattern) {
+        std::vector<u64> results;
+        pattern.search(&provider, 0, provider.getActualSize(), [&](u64 address) { results.push_back(address); });
+
+        return results;
+    }
+
+}
+
+BENCHMARK("Search") {
+    using namespace hex::test;
+
+    std::mt19937_64 random(0x1337);
+    std::vector<u8> data(DataSize);
+    for (auto &byte : data)
+        byte = random() % 0x60;
+
+    const std::string string = "kernel32.dll";
+    const std::vector<u8> bytes = { 0x4D, 0x5A, 0x90, 0x00 };
+    for (u32 i = 0; i < MatchCount; i++) {
+        const u64 address = random() % (DataSize - 0x100);
+        std::copy(bytes.begin(), bytes.end(), data.begin() + address);
+        std::copy(string.begin(), string.end(), data.begin() + address + 0x80);
+    }
+
+    TestProvider provider(&data);
+    size_t matches = 0;
+
+    measure("Hex, naive", DataSize, 1, [&] { matches = searchNaive(provider, bytes).size(); });
+    measure("Hex, pattern", DataSize, 1, [&] { matches = searchPattern(provider, *hex::SearchPattern::fromHexString("4D 5A 90 00")).size(); });
+    measure("Masked hex, pattern", DataSize, 1, [&] { matches = searchPattern(provider, *hex::SearchPattern::fromHexString("4D 5A ?? 00")).size(); });
+    measure("String, naive", DataSize, 1, [&] { matches = searchNaive(provider, std::vector<u8>(string.begin(), string.end())).size(); });
+    measure("String, pattern", DataSize, 1, [&] { matches = searchPattern(provider, *hex::SearchPattern::fromString(string)).size(); });
+    measure("String ignoring case, pattern", DataSize, 1, [&] { matches = searchPattern(provider, *hex::SearchPattern::fromString(string, false)).size(); });
+
+    hex::log::info("{} matches", matches);
+};
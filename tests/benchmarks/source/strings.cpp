@@ -0,0 +1,109 @@
+#include <hex/helpers/string_extractor.hpp>
+#include <hex/helpers/string_table.hpp>
+#include "benchmarks.hpp"
+#include "test_provider.hpp"
+
+#include <cstring>
+#include <random>
+#include <regex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    constexpr static size_t DataSize = 1024 * 1024 * 1024;
+
+    // String search the strings view used to do, reading the data in 1 KiB blocks
+    size_t extractNaive(hex::prv::Provider &provider, u32 minimumLength) {
+        size_t count = 0;
+
+        std::vector<u8> buffer(1024, 0x00);
+        u32 foundCharacters = 0;
+
+        for (u64 offset = 0; offset < provider.getActualSize(); offset += buffer.size()) {
+            size_t readSize = std::min(u64(buffer.size()), provider.getActualSize() - offset);
+            provider.read(offset, buffer.data(), readSize);
+
+            for (u32 i = 0; i < readSize; i++) {
+                if (buffer[i] >= ' ' && buffer[i] <= '~' && offset < provider.getActualSize() - 1)
+                    foundCharacters++;
+                else {
+                    if (foundCharacters >= minimumLength)
+                        count++;
+
+                    foundCharacters = 0;
+                }
+            }
+        }
+
+        return count;
+    }
+
+}
+
+BENCHMARK("Strings") {
+    using namespace hex::test;
+    using Encoding = hex::StringExtractor::Encoding;
+
+    // Firmware-like data, mostly binary with some text sprinkled in
+    std::mt19937_64 random(0x1337);
+    std::vector<u8> data(DataSize);
+    for (u64 offset = 0; offset < data.size(); offset += sizeof(u64)) {
+        u64 value = random();
+        if ((value & 0x0F) == 0)
+            value = 0x6F6C6C6548202020;
+
+        std::memcpy(data.data() + offset, &value, sizeof(u64));
+    }
+
+    TestProvider provider(&data);
+    size_t count = 0;
+
+    measure("ASCII, naive", DataSize, 1, [&] { count = extractNaive(provider, 5); });
+    measure("ASCII, 1 thread", DataSize, 1, [&] { count = hex::StringExtractor(Encoding::ASCII, 5).extract(&provider, 0, DataSize, { }, 1).size(); });
+    measure(hex::format("ASCII, {} threads", std::thread::hardware_concurrency()), DataSize, 1, [&] { count = hex::StringExtractor(Encoding::ASCII, 5).extract(&provider, 0, DataSize).size(); });
+    measure("UTF-8", DataSize, 1, [&] { count = hex::StringExtractor(Encoding::UTF8, 5).extract(&provider, 0, DataSize).size(); });
+    measure("UTF-16LE", DataSize, 1, [&] { count = hex::StringExtractor(Encoding::UTF16LE, 5).extract(&provider, 0, DataSize).size(); });
+
+    hex::log::info("{} strings", count);
+};
+
+BENCHMARK("StringsFilter") {
+    using namespace hex::test;
+
+    constexpr static size_t StringCount = 500'000;
+
+    std::mt19937_64 random(0x1337);
+    hex::StringTable table;
+    std::vector<std::string> strings;
+    size_t totalSize = 0;
+    for (size_t i = 0; i < StringCount; i++) {
+        std::string string;
+        for (u32 j = 0, length = 5 + random() % 40; j < length; j++)
+            string += char(' ' + random() % 95);
+
+        totalSize += string.size();
+        table.add(string);
+        strings.push_back(std::move(string));
+    }
+
+    size_t count = 0;
+
+    // What the strings view used to do on every keystroke, minus reading the strings from the provider
+    measure("Literal, naive", totalSize, 5, [&] {
+        count = 0;
+        for (const auto &string : strings)
+            count += string.find("abc") != std::string::npos;
+    });
+    measure("Literal, table", totalSize, 5, [&] { count = hex::StringFilter::create("abc", false)->apply(table)->size(); });
+
+    measure("Regex, naive", totalSize, 1, [&] {
+        const std::regex regex("ab+c[0-9]");
+        count = 0;
+        for (const auto &string : strings)
+            count += std::regex_search(string, regex);
+    });
+    measure("Regex, table", totalSize, 5, [&] { count = hex::StringFilter::create("ab+c[0-9]", true)->apply(table)->size(); });
+
+    hex::log::info("{} matches", count);
+};
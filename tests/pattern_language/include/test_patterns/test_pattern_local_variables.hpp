@@ -0,0 +1,77 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+namespace hex::test {
+
+    class TestPatternLocalVariables : public TestPattern {
+    public:
+        TestPatternLocalVariables() : TestPattern("LocalVariables")  {
+
+        }
+        ~TestPatternLocalVariables() override = default;
+
+        [[nodiscard]]
+        std::string getSourceCode() const override {
+            return R"(
+                u32 callCount;
+
+                fn resetCallCount() {
+                    callCount = 0;
+                };
+
+                fn add(u32 a, u32 b) {
+                    return a + b;
+                };
+
+                fn fibonacci(u32 n) {
+                    if (n < 2)
+                        return n;
+
+                    return fibonacci(n - 1) + fibonacci(n - 2);
+                };
+
+                fn scopes(u32 x) {
+                    u32 result = x;
+
+                    if (x > 5) {
+                        u32 inner = 10;
+                        result = result + inner;
+                    } else {
+                        u32 other = 20;
+                        result = result + other;
+                    }
+
+                    // Takes the place the variables of the branches had
+                    u32 after = 1;
+                    result = result + after;
+
+                    for (u32 i = 0, i < 3, i = i + 1) {
+                        u32 square = i * i;
+                        result = result + square;
+                    }
+
+                    u32 j = 0;
+                    while (j < 2) {
+                        j = j + 1;
+                        continue;
+                        u32 skipped = 0;
+                    }
+
+                    callCount = callCount + 1;
+
+                    return add(result, j);
+                };
+
+                resetCallCount();
+
+                std::assert(scopes(6) == 24, "local variable in true branch invalid");
+                std::assert(scopes(1) == 29, "local variable in false branch invalid");
+                std::assert(callCount == 2, "global variable modified in function invalid");
+                std::assert(fibonacci(10) == 55, "local variables in recursive function invalid");
+            )";
+        }
+
+    };
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+namespace hex::test {
+
+    class TestPatternStructArrays : public TestPattern {
+    public:
+        TestPatternStructArrays() : TestPattern("StructArrays")  {
+            // Fixed layout structs only get one template for the whole array
+            auto entries = create<PatternDataStaticArray>("Entry", "entries", 0x00, sizeof(u8[3]) * 4, nullptr);
+            {
+                auto entry = create<PatternDataStruct>("Entry", "", 0x00, sizeof(u8[3]), nullptr);
+                auto type = create<PatternDataUnsigned>("u8", "type", 0x00, sizeof(u8), nullptr);
+                auto value = create<PatternDataUnsigned>("u16", "value", 0x01, sizeof(u16), nullptr);
+                entry->setMembers({ type, value });
+
+                entries->setEntries(entry, 4);
+            }
+
+            auto thirdValue = create<PatternDataUnsigned>("u16", "thirdValue", 0x0A, sizeof(u16), nullptr);
+
+            addPattern(entries);
+            addPattern(thirdValue);
+        }
+        ~TestPatternStructArrays() override = default;
+
+        [[nodiscard]]
+        std::string getSourceCode() const override {
+            return R"(
+                struct Entry {
+                    u8 type;
+                    u16 value;
+                };
+
+                Entry entries[4] @ 0x00;
+                u16 thirdValue @ 0x0A;
+
+                std::assert(entries[3].value == thirdValue, "wrong entry read from struct array");
+            )";
+        }
+
+    };
+
+}
@@ -28,7 +28,7 @@ void addFunctions() {
     });
 }
 
-int test(int argc, char **argv) {
+int test(int argc, char **argv, bool useBytecode) {
     auto &testPatterns = TestPattern::getTests();
 
     // Check if a test to run has been provided
@@ -55,6 +55,7 @@ int test(int argc, char **argv) {
     }
 
     hex::pl::PatternLanguage language;
+    language.setBytecodeEnabled(useBytecode);
     addFunctions();
 
     // Check if compilation succeeded
@@ -103,8 +104,9 @@ int test(int argc, char **argv) {
 int main(int argc, char **argv) {
     int result = EXIT_SUCCESS;
 
+    // Alternate between the bytecode and the tree walker, both have to produce the same patterns
     for (u32 i = 0; i < 16; i++) {
-        result = test(argc, argv);
+        result = test(argc, argv, i % 2 == 0);
         if (result != EXIT_SUCCESS)
             break;
     }